@@ -0,0 +1,106 @@
+"""Turn frames printed by the firmware (built with -DDISPLAY_DUMP_FRAME=1)
+into images, and optionally compare them against a golden image.
+
+    pio device monitor | tee render.log
+    python frame_dump.py render.log                 # frame_0.png, frame_1.png, ...
+    python frame_dump.py render.log --compare golden.png
+
+Without PIL installed the frames are written as binary PPM instead.
+"""
+import argparse
+import re
+import sys
+
+# Panel colour order of the 4bpp nibbles (matches PANEL_PALETTE in generate_icons.py)
+PALETTE = [(0, 0, 0), (255, 255, 255), (0, 255, 0), (0, 0, 255),
+           (255, 0, 0), (255, 255, 0), (255, 128, 0)]
+UNKNOWN = (255, 0, 255)
+
+TIMING = re.compile(r"(Full-frame render|Paged render|Display list recorded|Text layout).*")
+
+
+def read_frames(lines):
+    """Yield (width, height, rgb rows) for each FRAME_BEGIN..FRAME_END block."""
+    frame = None
+    for line in lines:
+        line = line.strip()
+        if line.startswith("FRAME_BEGIN"):
+            _, w, h, _top = line.split()
+            frame = (int(w), int(h), [])
+        elif line == "FRAME_END" and frame:
+            yield frame
+            frame = None
+        elif frame is not None:
+            frame[2].append([PALETTE[int(c, 16)] if int(c, 16) < len(PALETTE) else UNKNOWN
+                             for c in line])
+        else:
+            match = TIMING.search(line)
+            if match:
+                print(match.group(0))
+
+
+def save(path, w, h, rows):
+    try:
+        from PIL import Image
+    except ImportError:
+        path = path.rsplit(".", 1)[0] + ".ppm"
+        with open(path, "wb") as f:
+            f.write(b"P6 %d %d 255\n" % (w, h))
+            for row in rows:
+                f.write(bytes(v for px in row for v in px))
+        return path
+    img = Image.new("RGB", (w, h))
+    img.putdata([px for row in rows for px in row])
+    img.save(path)
+    return path
+
+
+def load_golden(path):
+    """(width, height, pixel lookup) for a PPM written by save(), or any image PIL reads."""
+    if path.endswith(".ppm"):
+        with open(path, "rb") as f:
+            magic, w, h, _depth = f.readline().split()
+            data = f.read()
+        w, h = int(w), int(h)
+        return w, h, lambda x, y: tuple(data[(y * w + x) * 3:(y * w + x) * 3 + 3])
+    from PIL import Image
+    golden = Image.open(path).convert("RGB")
+    ref = golden.load()
+    return golden.size[0], golden.size[1], lambda x, y: ref[x, y]
+
+
+def compare(w, h, rows, golden_path):
+    """Number of pixels that differ from the golden image."""
+    gw, gh, ref = load_golden(golden_path)
+    if (gw, gh) != (w, h):
+        print(f"Size mismatch: frame {w}x{h}, golden {gw}x{gh}")
+        return w * h
+    return sum(1 for y, row in enumerate(rows) for x, px in enumerate(row) if ref(x, y) != px)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", nargs="?", help="serial log (default: stdin)")
+    parser.add_argument("--prefix", default="frame", help="output file prefix")
+    parser.add_argument("--compare", metavar="GOLDEN", help="golden image to diff against")
+    args = parser.parse_args()
+
+    source = open(args.log, errors="replace") if args.log else sys.stdin
+    failed = False
+    count = 0
+    for w, h, rows in read_frames(source):
+        path = save(f"{args.prefix}_{count}.png", w, h, rows)
+        print(f"Frame {count}: {w}x{h} -> {path}")
+        if args.compare:
+            diff = compare(w, h, rows, args.compare)
+            print(f"  {diff} pixels differ from {args.compare}")
+            failed |= diff > 0
+        count += 1
+    if count == 0:
+        print("No frames found (build with -DDISPLAY_DUMP_FRAME=1 and full-frame mode)")
+        return 1
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
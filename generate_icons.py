@@ -5,6 +5,8 @@ import math
 # Configuration
 ICON_SIZE = (96, 96)
 OUTPUT_DIR = "data"
+IDS_HEADER = "lib/WeatherIcons/WeatherIconIds.h"
+CONDITION_LIST = "include/weather_icons_list.txt"
 
 # Colors (6-Color Palette)
 WHITE = (255, 255, 255)
@@ -174,6 +176,142 @@ icons = {
     "windy": gen_wind
 }
 
+# Drawing shape behind each generator, which the firmware's vector icons
+# switch on (WeatherIconShape)
+shapes = {
+    gen_clear: "CLEAR",
+    gen_partly_cloudy: "PARTLY_CLOUDY",
+    gen_cloudy: "CLOUDY",
+    gen_rain: "RAIN",
+    gen_snow: "SNOW",
+    gen_storm: "STORM",
+    gen_fog: "FOG",
+    gen_wind: "WIND",
+}
+
+def vector_shape(name):
+    # Name rules the firmware used before icon IDs, for names without a generator
+    if name in ("clear_day", "sunny", "clear_night"):
+        return "CLEAR"
+    if "partly" in name:
+        return "PARTLY_CLOUDY"
+    if name in ("cloudy", "mostly_cloudy"):
+        return "CLOUDY"
+    if "rain" in name or "showers" in name:
+        return "RAIN"
+    if "snow" in name or "flurries" in name:
+        return "SNOW"
+    if "thunder" in name or "storm" in name:
+        return "STORM"
+    if name in ("fog", "mist", "haze"):
+        return "FOG"
+    if "wind" in name:
+        return "WIND"
+    return "CLEAR"
+
+def icon_shapes():
+    # Icon base names from the generator, then the condition types
+    # (lower-cased) from the list file, in first-seen order
+    names = {name: shapes[func] for name, func in icons.items()}
+    with open(CONDITION_LIST) as f:
+        for line in f:
+            name = line.strip().lower()
+            if name and name not in names:
+                names[name] = vector_shape(name)
+    return names
+
+def fnv1a(name):
+    h = 2166136261
+    for c in name.lower().encode():
+        h = ((h ^ c) * 16777619) & 0xFFFFFFFF
+    return h
+
+# --- Icon IDs ---
+
+def write_icon_ids():
+    names = icon_shapes()
+    hashes = [fnv1a(name) for name in names]
+    assert len(set(hashes)) == len(hashes), "FNV-1a collision between icon names"
+
+    # Smallest table where every name lands in its own slot
+    size = len(names)
+    while len({h % size for h in hashes}) != len(hashes):
+        size += 1
+    slots = [(0, "ICON_UNKNOWN")] * size
+    for name, h in zip(names, hashes):
+        slots[h % size] = (h, f"ICON_{name.upper()}")
+
+    shape_names = list(dict.fromkeys(shapes.values()))
+    with open(IDS_HEADER, "w") as f:
+        f.write(f"// Generated by generate_icons.py from {CONDITION_LIST} and the icon names\n")
+        f.write("// in generate_icons.py - do not edit.\n")
+        f.write("#ifndef WEATHER_ICON_IDS_H\n#define WEATHER_ICON_IDS_H\n\n")
+        f.write("#include <Arduino.h>\n\n")
+        f.write("enum WeatherIconShape : uint8_t {\n")
+        for shape in shape_names:
+            f.write(f"    ICON_SHAPE_{shape},\n")
+        f.write("    ICON_SHAPE_COUNT\n};\n\n")
+        f.write("enum WeatherIconId : uint8_t {\n    ICON_UNKNOWN = 0,\n")
+        for name in names:
+            f.write(f"    ICON_{name.upper()},\n")
+        f.write("    ICON_COUNT\n};\n\n")
+        f.write("static constexpr const char* weatherIconNames[ICON_COUNT] = {\n    \"unknown\",\n")
+        for name in names:
+            f.write(f"    \"{name}\",\n")
+        f.write("};\n\n")
+        f.write("""// Name of an icon ID, "unknown" for anything outside the table
+constexpr const char* weatherIconName(WeatherIconId id) {
+    return id < ICON_COUNT ? weatherIconNames[id] : weatherIconNames[ICON_UNKNOWN];
+}
+
+""")
+        f.write("static constexpr WeatherIconShape weatherIconShapes[ICON_COUNT] = {\n    ICON_SHAPE_CLEAR,\n")
+        for shape in names.values():
+            f.write(f"    ICON_SHAPE_{shape},\n")
+        f.write("};\n\n")
+        f.write("// Perfect hash of the lower-case names: FNV-1a % WEATHER_ICON_HASH_SIZE\n")
+        f.write(f"#define WEATHER_ICON_HASH_SIZE {size}\n\n")
+        f.write("struct WeatherIconSlot {\n    uint32_t hash;\n    WeatherIconId id;\n};\n\n")
+        f.write("static constexpr WeatherIconSlot weatherIconSlots[WEATHER_ICON_HASH_SIZE] = {\n")
+        for h, ident in slots:
+            f.write(f"    {{0x{h:08X}u, {ident}}},\n")
+        f.write("};\n\n")
+        f.write("""// Lookups are constexpr (C++11 single-return form) so literal names resolve
+// at compile time; at run time they walk the name once and never allocate.
+constexpr char weatherIconLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? char(c + ('a' - 'A')) : c;
+}
+
+constexpr uint32_t weatherIconHash(const char* s, size_t len, uint32_t h = 2166136261u) {
+    return len == 0 ? h : weatherIconHash(s + 1, len - 1, uint32_t((h ^ uint8_t(weatherIconLower(*s))) * 16777619u));
+}
+
+constexpr bool weatherIconNameMatches(const char* name, const char* s, size_t len) {
+    return len == 0 ? *name == '\\0' : (*name == weatherIconLower(*s) && weatherIconNameMatches(name + 1, s + 1, len - 1));
+}
+
+constexpr WeatherIconId weatherIconFromSlot(const WeatherIconSlot& slot, uint32_t hash, const char* s, size_t len) {
+    return (slot.id != ICON_UNKNOWN && slot.hash == hash && weatherIconNameMatches(weatherIconNames[slot.id], s, len)) ? slot.id : ICON_UNKNOWN;
+}
+
+constexpr WeatherIconId weatherIconId(const char* s, size_t len) {
+    return weatherIconFromSlot(weatherIconSlots[weatherIconHash(s, len) % WEATHER_ICON_HASH_SIZE], weatherIconHash(s, len), s, len);
+}
+
+constexpr size_t weatherIconNameLength(const char* s) {
+    return *s ? 1 + weatherIconNameLength(s + 1) : 0;
+}
+
+constexpr WeatherIconId weatherIconId(const char* s) {
+    return weatherIconId(s, weatherIconNameLength(s));
+}
+
+""")
+        first = next(iter(names))
+        f.write(f"static_assert(weatherIconId(\"{first}\") == ICON_{first.upper()}, \"icon hash table out of date\");\n\n")
+        f.write("#endif\n")
+    print(f"Wrote {IDS_HEADER}: {len(names)} icon names, {size} hash slots")
+
 # Generate
 if __name__ == "__main__":
     print(f"Generating icons in '{OUTPUT_DIR}'...")
@@ -181,4 +319,5 @@ if __name__ == "__main__":
         img = func()
         img.save(f"{OUTPUT_DIR}/{name}.png")
         print(f"  - {name}.png")
+    write_icon_ids()
     print("Done.")
@@ -0,0 +1,159 @@
+import sys
+
+# Generates src/WeatherJsonSchema.h: the Google Weather API response shapes
+# as node tables for the streaming parser in src/JsonSax.cpp. Only the paths
+# listed here are reported; everything else in a response is skipped.
+
+SCHEMA_HEADER = "src/WeatherJsonSchema.h"
+
+# Paths use "." between keys and "[]" after an array whose elements are
+# records (the handler gets begin/end calls around each). An empty path is
+# the root object as a single record. Each path maps to the field ID the
+# handler sees.
+SCHEMAS = {
+    "daily": [
+        ("forecastDays[]", "DAY"),
+        ("forecastDays[].displayDate.year", "DAY_YEAR"),
+        ("forecastDays[].displayDate.month", "DAY_MONTH"),
+        ("forecastDays[].displayDate.day", "DAY_DAY"),
+        ("forecastDays[].maxTemperature.degrees", "DAY_MAX_TEMP"),
+        ("forecastDays[].minTemperature.degrees", "DAY_MIN_TEMP"),
+        ("forecastDays[].daytimeForecast.weatherCondition.description.text", "DAY_CONDITION_TEXT"),
+        ("forecastDays[].daytimeForecast.weatherCondition.iconBaseUri", "DAY_ICON_URI"),
+        ("forecastDays[].daytimeForecast.weatherCondition.type", "DAY_CONDITION_TYPE"),
+        ("forecastDays[].sunEvents.sunriseTime", "DAY_SUNRISE"),
+        ("forecastDays[].sunEvents.sunsetTime", "DAY_SUNSET"),
+    ],
+    "hourly": [
+        ("forecastHours[]", "HOUR"),
+        ("forecastHours[].interval.startTime", "HOUR_START"),
+        ("forecastHours[].temperature.degrees", "HOUR_TEMP"),
+        ("forecastHours[].precipitation.probability.percent", "HOUR_RAIN_PROB"),
+        ("forecastHours[].pressure.meanSeaLevelMillibars", "HOUR_PRESSURE"),
+        ("forecastHours[].airPressure.meanSeaLevelMillibars", "HOUR_AIR_PRESSURE"),
+    ],
+    "history": [
+        ("historyHours[]", "HISTORY"),
+        ("historyHours[].interval.startTime", "HISTORY_START"),
+        ("historyHours[].temperature.degrees", "HISTORY_TEMP"),
+        ("historyHours[].precipitation.rainfallMM", "HISTORY_RAIN"),
+        ("historyHours[].pressure.meanSeaLevelMillibars", "HISTORY_PRESSURE"),
+        ("historyHours[].airPressure.meanSeaLevelMillibars", "HISTORY_AIR_PRESSURE"),
+    ],
+    "current": [
+        ("", "CURRENT"),
+        ("weatherCondition.description.text", "CURRENT_CONDITION_TEXT"),
+        ("weatherCondition.iconBaseUri", "CURRENT_ICON_URI"),
+        ("weatherCondition.type", "CURRENT_CONDITION_TYPE"),
+        ("temperature.degrees", "CURRENT_TEMP"),
+        ("feelsLikeTemperature.degrees", "CURRENT_FEELS_LIKE"),
+        ("wind.speed.value", "CURRENT_WIND_SPEED"),
+        ("wind.gust.value", "CURRENT_WIND_GUST"),
+        ("wind.direction.degrees", "CURRENT_WIND_DIRECTION"),
+        ("relativeHumidity", "CURRENT_HUMIDITY"),
+        ("precipitation.probability.percent", "CURRENT_RAIN_PROB"),
+        ("uvIndex", "CURRENT_UV_INDEX"),
+        ("airPressure.meanSeaLevelMillibars", "CURRENT_PRESSURE"),
+    ],
+}
+
+def fnv1a(name):
+    h = 2166136261
+    for c in name.encode():
+        h = ((h ^ c) * 16777619) & 0xFFFFFFFF
+    return h
+
+def key_ident(key):
+    out = ""
+    for c in key:
+        out += ("_" + c) if c.isupper() else c.upper()
+    return "JSON_KEY_" + out
+
+def build_nodes(paths):
+    # Node 0 is the root object; children follow in first-seen order
+    nodes = [{"parent": 0xFF, "key": None, "field": None, "records": False}]
+    index = {(): 0}
+    for path, field in paths:
+        if path == "":
+            nodes[0]["field"] = field
+            nodes[0]["records"] = True
+            continue
+        prefix = ()
+        for segment in path.split("."):
+            records = segment.endswith("[]")
+            key = segment[:-2] if records else segment
+            child = prefix + (key,)
+            if child not in index:
+                index[child] = len(nodes)
+                nodes.append({"parent": index[prefix], "key": key, "field": None, "records": False})
+            node = nodes[index[child]]
+            if records:
+                node["records"] = True
+            prefix = child
+        assert nodes[index[prefix]]["field"] is None, f"duplicate path {path}"
+        nodes[index[prefix]]["field"] = field
+    assert len(nodes) < 0xFF
+    return nodes
+
+def write_schema():
+    keys = []
+    fields = []
+    tables = {}
+    for name, paths in SCHEMAS.items():
+        nodes = build_nodes(paths)
+        tables[name] = nodes
+        for node in nodes:
+            if node["key"] is not None and node["key"] not in keys:
+                keys.append(node["key"])
+        fields += [field for _, field in paths]
+    assert len(set(fields)) == len(fields), "duplicate field name"
+
+    hashes = [fnv1a(key) for key in keys]
+    assert len(set(hashes)) == len(hashes), "FNV-1a collision between keys"
+    # Smallest table where every key lands in its own slot
+    size = len(keys)
+    while len({h % size for h in hashes}) != len(hashes):
+        size += 1
+    slots = [(0, "JSON_KEY_UNKNOWN")] * size
+    for key, h in zip(keys, hashes):
+        slots[h % size] = (h, key_ident(key))
+
+    with open(SCHEMA_HEADER, "w") as f:
+        f.write("// Generated by generate_json_schema.py - do not edit.\n")
+        f.write("#ifndef WEATHER_JSON_SCHEMA_H\n#define WEATHER_JSON_SCHEMA_H\n\n")
+        f.write("#include \"JsonSax.h\"\n\n")
+        f.write("enum WeatherJsonKey : uint8_t {\n    JSON_KEY_UNKNOWN = 0,\n")
+        for key in keys:
+            f.write(f"    {key_ident(key)},\n")
+        f.write("    JSON_KEY_COUNT\n};\n\n")
+        f.write("static constexpr const char* weatherJsonKeyNames[JSON_KEY_COUNT] = {\n    \"\",\n")
+        for key in keys:
+            f.write(f"    \"{key}\",\n")
+        f.write("};\n\n")
+        f.write("// Perfect hash of the keys: FNV-1a % WEATHER_JSON_KEY_HASH_SIZE\n")
+        f.write(f"#define WEATHER_JSON_KEY_HASH_SIZE {size}\n\n")
+        f.write("static constexpr JsonKeySlot weatherJsonKeySlots[WEATHER_JSON_KEY_HASH_SIZE] = {\n")
+        for h, ident in slots:
+            f.write(f"    {{0x{h:08X}u, {ident}}},\n")
+        f.write("};\n\n")
+        f.write("// Reported to JsonSaxHandler; 0 is never reported\n")
+        f.write("enum WeatherJsonField : uint8_t {\n    FIELD_NONE = 0,\n")
+        for field in fields:
+            f.write(f"    FIELD_{field},\n")
+        f.write("    FIELD_COUNT\n};\n\n")
+        for name, nodes in tables.items():
+            f.write(f"static constexpr JsonSchemaNode {name}JsonNodes[] = {{\n")
+            for i, node in enumerate(nodes):
+                parent = "JSON_NODE_NONE" if node["parent"] == 0xFF else str(node["parent"])
+                key = key_ident(node["key"]) if node["key"] else "JSON_KEY_UNKNOWN"
+                field = f"FIELD_{node['field']}" if node["field"] else "FIELD_NONE"
+                flags = "JSON_NODE_RECORDS" if node["records"] else "0"
+                f.write(f"    {{{parent}, {key}, {field}, {flags}}}, // {i}\n")
+            f.write("};\n\n")
+            f.write(f"static constexpr JsonSchema {name}JsonSchema = {{\n")
+            f.write(f"    {name}JsonNodes, {len(nodes)}, weatherJsonKeySlots, WEATHER_JSON_KEY_HASH_SIZE, weatherJsonKeyNames}};\n\n")
+        f.write("#endif\n")
+    print(f"Wrote {SCHEMA_HEADER}: {len(keys)} keys, {size} hash slots, {len(fields)} fields")
+
+if __name__ == "__main__":
+    write_schema()
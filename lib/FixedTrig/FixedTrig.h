@@ -0,0 +1,35 @@
+#ifndef FIXED_TRIG_H
+#define FIXED_TRIG_H
+
+#include <Arduino.h>
+
+// Table driven sine / cosine for the drawing code. Angles are 16-bit binary
+// angles (65536 per turn, wrapping naturally) and results are Q15 with
+// FIXED_TRIG_ONE representing 1.0, so r * fixedSin(a) >> 15 is the integer
+// part of r * sin(a) without touching floating point.
+#define FIXED_TRIG_ONE 32768L
+#define FIXED_ANGLE_TURN 65536L
+
+// Binary angle for degrees / radians (evaluated once per shape, not per pixel)
+inline uint16_t fixedAngleDegrees(float degrees) {
+    return (uint16_t)(int32_t)lroundf(degrees * (FIXED_ANGLE_TURN / 360.0f));
+}
+inline uint16_t fixedAngleRadians(float radians) {
+    return (uint16_t)(int32_t)lroundf(radians * (FIXED_ANGLE_TURN / (2 * PI)));
+}
+
+int32_t fixedSin(uint16_t angle);
+inline int32_t fixedCos(uint16_t angle) { return fixedSin(angle + FIXED_ANGLE_TURN / 4); }
+
+// Multiply by a Q15 value, rounding towards negative infinity like the
+// int conversion of a positive screen coordinate
+inline int16_t fixedMul(int32_t v, int32_t q15) {
+    return (int16_t)((v * q15) >> 15);
+}
+
+// Rotate (x, y) about the origin by angle (clockwise on screen, y down)
+void fixedRotate(int16_t x, int16_t y, uint16_t angle, int16_t& rx, int16_t& ry);
+// Point at distance r from (cx, cy) in direction angle (0 = +x)
+void fixedPolar(int16_t cx, int16_t cy, int16_t r, uint16_t angle, int16_t& x, int16_t& y);
+
+#endif
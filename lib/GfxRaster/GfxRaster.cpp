@@ -0,0 +1,225 @@
+#include "GfxRaster.h"
+#include <math.h>
+
+// Geometry is kept in 1/16 px fixed point; integer pixel coordinates refer to
+// the pixel centre, so a point (x, y) sits at ((x + 0.5) * 16, (y + 0.5) * 16)
+#define RASTER_SUB 16
+#define RASTER_HALF 8
+
+// Joins sharper than this (mitre length / half width) are bevelled, as in SVG
+#define RASTER_MITRE_LIMIT 4.0f
+
+// First pixel (row or column) whose centre is at or after fixed point v, so
+// the pixels covered by [a, b) are [firstCentre(a), firstCentre(b))
+static inline int16_t firstCentre(int32_t v) {
+    return -((RASTER_HALF - v) >> 4);
+}
+
+static inline int16_t toFixed(float v) {
+    return (int16_t)lroundf(v * RASTER_SUB);
+}
+
+// X where the edge crosses row centre yc, or false if it does not. Edges are
+// half-open in y so shared vertices and horizontal edges count once.
+static inline bool crossing(int16_t xa, int16_t ya, int16_t xb, int16_t yb, int32_t yc, int32_t& x) {
+    if (ya == yb) return false;
+    if (ya > yb) {
+        int16_t t = xa; xa = xb; xb = t;
+        t = ya; ya = yb; yb = t;
+    }
+    if (yc < ya || yc >= yb) return false;
+    x = xa + (int32_t)(yc - ya) * (xb - xa) / (yb - ya);
+    return true;
+}
+
+static void sortSpans(int16_t* spans, uint8_t count) {
+    for (uint8_t i = 1; i < count; i++) {
+        int16_t a = spans[i * 2], b = spans[i * 2 + 1];
+        int j = i - 1;
+        while (j >= 0 && spans[j * 2] > a) {
+            spans[(j + 1) * 2] = spans[j * 2];
+            spans[(j + 1) * 2 + 1] = spans[j * 2 + 1];
+            j--;
+        }
+        spans[(j + 1) * 2] = a;
+        spans[(j + 1) * 2 + 1] = b;
+    }
+}
+
+GfxRaster::GfxRaster(Adafruit_GFX& gfx) : _gfx(gfx) {}
+
+void GfxRaster::emitRow(int16_t y, int16_t* spans, uint8_t spanCount, uint16_t color) {
+    // Spans are [start, end) pixel ranges; merge overlapping and touching ones
+    sortSpans(spans, spanCount);
+    int16_t w = _gfx.width();
+    uint8_t i = 0;
+    while (i < spanCount) {
+        int16_t start = spans[i * 2];
+        int16_t end = spans[i * 2 + 1];
+        for (i++; i < spanCount && spans[i * 2] <= end; i++) {
+            end = max(end, spans[i * 2 + 1]);
+        }
+        if (start < 0) start = 0;
+        if (end > w) end = w;
+        if (end > start) _gfx.drawFastHLine(start, y, end - start, color);
+    }
+}
+
+void GfxRaster::fillPolygon(const RasterPoint* points, uint8_t count, uint16_t color) {
+    if (count < 3) return;
+    if (count > MAX_POINTS) count = MAX_POINTS;
+
+    int16_t x[MAX_POINTS], y[MAX_POINTS];
+    int32_t top = INT32_MAX, bottom = INT32_MIN;
+    for (uint8_t i = 0; i < count; i++) {
+        x[i] = points[i].x * RASTER_SUB + RASTER_HALF;
+        y[i] = points[i].y * RASTER_SUB + RASTER_HALF;
+        top = min<int32_t>(top, y[i]);
+        bottom = max<int32_t>(bottom, y[i]);
+    }
+
+    int16_t rowStart = max<int16_t>(firstCentre(top), 0);
+    int16_t rowEnd = min<int16_t>(firstCentre(bottom), _gfx.height());
+
+    int16_t spans[MAX_POINTS];
+    for (int16_t row = rowStart; row < rowEnd; row++) {
+        int32_t yc = (int32_t)row * RASTER_SUB + RASTER_HALF;
+        int16_t xs[MAX_POINTS];
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            uint8_t j = (i + 1 == count) ? 0 : i + 1;
+            int32_t cx;
+            if (crossing(x[i], y[i], x[j], y[j], yc, cx)) {
+                // Insertion sort as we go; polygons here are small
+                int k = n++;
+                while (k > 0 && xs[k - 1] > cx) {
+                    xs[k] = xs[k - 1];
+                    k--;
+                }
+                xs[k] = cx;
+            }
+        }
+        // Even-odd: crossings pair up into inside spans
+        uint8_t spanCount = 0;
+        for (uint8_t i = 0; i + 1 < n; i += 2) {
+            spans[spanCount * 2] = firstCentre(xs[i]);
+            spans[spanCount * 2 + 1] = firstCentre(xs[i + 1]);
+            spanCount++;
+        }
+        emitRow(row, spans, spanCount, color);
+    }
+}
+
+void GfxRaster::addPiece(Piece* pieces, uint8_t& count, const float* x, const float* y, uint8_t n) {
+    Piece& p = pieces[count++];
+    int16_t top = INT16_MAX, bottom = INT16_MIN;
+    for (uint8_t i = 0; i < n; i++) {
+        p.x[i] = toFixed(x[i]);
+        p.y[i] = toFixed(y[i]);
+        top = min(top, p.y[i]);
+        bottom = max(bottom, p.y[i]);
+    }
+    p.count = n;
+    p.top = firstCentre(top);
+    p.bottom = firstCentre(bottom);
+}
+
+void GfxRaster::drawPolyline(const RasterPoint* points, uint8_t count, uint8_t width, uint16_t color) {
+    if (count == 0 || width == 0) return;
+    if (count > MAX_POINTS) count = MAX_POINTS;
+
+    // Static so the outline does not sit on the loop task's stack; the
+    // rasteriser is only used from the drawing thread
+    static Piece pieces[MAX_POINTS * 2];
+    uint8_t pieceCount = 0;
+
+    // Pixel centres with repeated points dropped
+    float px[MAX_POINTS], py[MAX_POINTS];
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if (n > 0 && points[i].x == points[i - 1].x && points[i].y == points[i - 1].y) continue;
+        px[n] = points[i].x + 0.5f;
+        py[n] = points[i].y + 0.5f;
+        n++;
+    }
+
+    float h = width / 2.0f;
+    if (n == 1) {
+        float x[4] = {px[0] - h, px[0] + h, px[0] + h, px[0] - h};
+        float y[4] = {py[0] - h, py[0] - h, py[0] + h, py[0] + h};
+        addPiece(pieces, pieceCount, x, y, 4);
+    }
+
+    // One quad per segment, then a wedge on the outside of each join
+    float nx[MAX_POINTS], ny[MAX_POINTS];
+    for (uint8_t i = 0; i + 1 < n; i++) {
+        float dx = px[i + 1] - px[i];
+        float dy = py[i + 1] - py[i];
+        float len = sqrtf(dx * dx + dy * dy);
+        nx[i] = -dy / len;
+        ny[i] = dx / len;
+        float ox = nx[i] * h, oy = ny[i] * h;
+        float x[4] = {px[i] + ox, px[i + 1] + ox, px[i + 1] - ox, px[i] - ox};
+        float y[4] = {py[i] + oy, py[i + 1] + oy, py[i + 1] - oy, py[i] - oy};
+        addPiece(pieces, pieceCount, x, y, 4);
+    }
+    for (uint8_t i = 1; i + 1 < n; i++) {
+        float cross = nx[i - 1] * ny[i] - ny[i - 1] * nx[i];
+        if (fabsf(cross) < 0.001f) continue; // Straight on (or reversing)
+
+        // The outer side is opposite the direction of the turn
+        float s = cross > 0 ? -h : h;
+        float dot = nx[i - 1] * nx[i] + ny[i - 1] * ny[i];
+        float ax = px[i] + s * nx[i - 1], ay = py[i] + s * ny[i - 1];
+        float bx = px[i] + s * nx[i], by = py[i] + s * ny[i];
+        if (2.0f / (1.0f + dot) > RASTER_MITRE_LIMIT * RASTER_MITRE_LIMIT) {
+            float x[3] = {px[i], ax, bx};
+            float y[3] = {py[i], ay, by};
+            addPiece(pieces, pieceCount, x, y, 3);
+        } else {
+            float mx = px[i] + s * (nx[i - 1] + nx[i]) / (1.0f + dot);
+            float my = py[i] + s * (ny[i - 1] + ny[i]) / (1.0f + dot);
+            float x[4] = {px[i], ax, mx, bx};
+            float y[4] = {py[i], ay, my, by};
+            addPiece(pieces, pieceCount, x, y, 4);
+        }
+    }
+
+    int16_t rowStart = INT16_MAX, rowEnd = INT16_MIN;
+    for (uint8_t i = 0; i < pieceCount; i++) {
+        rowStart = min(rowStart, pieces[i].top);
+        rowEnd = max(rowEnd, pieces[i].bottom);
+    }
+    rowStart = max<int16_t>(rowStart, 0);
+    rowEnd = min<int16_t>(rowEnd, _gfx.height());
+
+    int16_t spans[MAX_POINTS * 4];
+    for (int16_t row = rowStart; row < rowEnd; row++) {
+        int32_t yc = (int32_t)row * RASTER_SUB + RASTER_HALF;
+        uint8_t spanCount = 0;
+        for (uint8_t i = 0; i < pieceCount; i++) {
+            const Piece& p = pieces[i];
+            if (row < p.top || row >= p.bottom) continue;
+            // Convex, so the row crosses it in at most one span
+            int32_t left = INT32_MAX, right = INT32_MIN;
+            for (uint8_t e = 0; e < p.count; e++) {
+                uint8_t f = (e + 1 == p.count) ? 0 : e + 1;
+                int32_t cx;
+                if (crossing(p.x[e], p.y[e], p.x[f], p.y[f], yc, cx)) {
+                    left = min(left, cx);
+                    right = max(right, cx);
+                }
+            }
+            if (left >= right) continue;
+            spans[spanCount * 2] = firstCentre(left);
+            spans[spanCount * 2 + 1] = firstCentre(right);
+            spanCount++;
+        }
+        emitRow(row, spans, spanCount, color);
+    }
+}
+
+void GfxRaster::drawThickLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t width, uint16_t color) {
+    RasterPoint points[2] = {{x0, y0}, {x1, y1}};
+    drawPolyline(points, 2, width, color);
+}
@@ -0,0 +1,45 @@
+#ifndef GFX_RASTER_H
+#define GFX_RASTER_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+struct RasterPoint {
+    int16_t x;
+    int16_t y;
+};
+
+// Scanline rasteriser for wide strokes and filled polygons. Shapes are
+// sampled at pixel centres one row at a time and the covered spans are
+// merged before being drawn, so each pixel is written once per call and the
+// target only sees drawFastHLine calls (one display list command per span).
+// Rows are clipped to the target; banding is left to the display list replay.
+class GfxRaster {
+public:
+    // Longest polyline / polygon accepted; extra points are ignored
+    static const uint8_t MAX_POINTS = 32;
+
+    GfxRaster(Adafruit_GFX& gfx);
+
+    // Filled polygon (even-odd rule), vertices in pixel coordinates
+    void fillPolygon(const RasterPoint* points, uint8_t count, uint16_t color);
+    // Stroke through the points with butt ends and mitred joins
+    void drawPolyline(const RasterPoint* points, uint8_t count, uint8_t width, uint16_t color);
+    void drawThickLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t width, uint16_t color);
+
+private:
+    // Convex outline in 1/16 px units; a polyline is the union of these
+    struct Piece {
+        int16_t x[4];
+        int16_t y[4];
+        uint8_t count;
+        int16_t top, bottom;
+    };
+
+    Adafruit_GFX& _gfx;
+
+    void addPiece(Piece* pieces, uint8_t& count, const float* x, const float* y, uint8_t n);
+    void emitRow(int16_t y, int16_t* spans, uint8_t spanCount, uint16_t color);
+};
+
+#endif
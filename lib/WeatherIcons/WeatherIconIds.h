@@ -0,0 +1,680 @@
+// Generated by generate_icons.py from include/weather_icons_list.txt and the icon names
+// in generate_icons.py - do not edit.
+#ifndef WEATHER_ICON_IDS_H
+#define WEATHER_ICON_IDS_H
+
+#include <Arduino.h>
+
+enum WeatherIconShape : uint8_t {
+    ICON_SHAPE_CLEAR,
+    ICON_SHAPE_PARTLY_CLOUDY,
+    ICON_SHAPE_CLOUDY,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_SNOW,
+    ICON_SHAPE_STORM,
+    ICON_SHAPE_FOG,
+    ICON_SHAPE_WIND,
+    ICON_SHAPE_COUNT
+};
+
+enum WeatherIconId : uint8_t {
+    ICON_UNKNOWN = 0,
+    ICON_CLEAR_DAY,
+    ICON_CLEAR_NIGHT,
+    ICON_SUNNY,
+    ICON_PARTLY_CLOUDY,
+    ICON_PARTLY_CLOUDY_DAY,
+    ICON_PARTLY_CLOUDY_NIGHT,
+    ICON_PARTLY_CLEAR,
+    ICON_MOSTLY_CLEAR,
+    ICON_CLOUDY,
+    ICON_MOSTLY_CLOUDY,
+    ICON_RAIN,
+    ICON_SHOWERS,
+    ICON_HEAVY_RAIN,
+    ICON_LIGHT_RAIN,
+    ICON_SCATTERED_SHOWERS,
+    ICON_SNOW,
+    ICON_SNOW_SHOWERS,
+    ICON_FLURRIES,
+    ICON_THUNDERSTORM,
+    ICON_FOG,
+    ICON_MIST,
+    ICON_HAZE,
+    ICON_WIND,
+    ICON_WINDY,
+    ICON_CLEAR,
+    ICON_WIND_AND_RAIN,
+    ICON_LIGHT_RAIN_SHOWERS,
+    ICON_CHANCE_OF_SHOWERS,
+    ICON_RAIN_SHOWERS,
+    ICON_HEAVY_RAIN_SHOWERS,
+    ICON_LIGHT_TO_MODERATE_RAIN,
+    ICON_MODERATE_TO_HEAVY_RAIN,
+    ICON_RAIN_PERIODICALLY_HEAVY,
+    ICON_LIGHT_SNOW_SHOWERS,
+    ICON_CHANCE_OF_SNOW_SHOWERS,
+    ICON_SCATTERED_SNOW_SHOWERS,
+    ICON_HEAVY_SNOW_SHOWERS,
+    ICON_LIGHT_TO_MODERATE_SNOW,
+    ICON_MODERATE_TO_HEAVY_SNOW,
+    ICON_LIGHT_SNOW,
+    ICON_HEAVY_SNOW,
+    ICON_SNOWSTORM,
+    ICON_SNOW_PERIODICALLY_HEAVY,
+    ICON_HEAVY_SNOW_STORM,
+    ICON_BLOWING_SNOW,
+    ICON_RAIN_AND_SNOW,
+    ICON_HAIL,
+    ICON_HAIL_SHOWERS,
+    ICON_THUNDERSHOWER,
+    ICON_LIGHT_THUNDERSTORM_RAIN,
+    ICON_SCATTERED_THUNDERSTORMS,
+    ICON_HEAVY_THUNDERSTORM,
+    ICON_SMOKE,
+    ICON_DUST,
+    ICON_COUNT
+};
+
+static constexpr const char* weatherIconNames[ICON_COUNT] = {
+    "unknown",
+    "clear_day",
+    "clear_night",
+    "sunny",
+    "partly_cloudy",
+    "partly_cloudy_day",
+    "partly_cloudy_night",
+    "partly_clear",
+    "mostly_clear",
+    "cloudy",
+    "mostly_cloudy",
+    "rain",
+    "showers",
+    "heavy_rain",
+    "light_rain",
+    "scattered_showers",
+    "snow",
+    "snow_showers",
+    "flurries",
+    "thunderstorm",
+    "fog",
+    "mist",
+    "haze",
+    "wind",
+    "windy",
+    "clear",
+    "wind_and_rain",
+    "light_rain_showers",
+    "chance_of_showers",
+    "rain_showers",
+    "heavy_rain_showers",
+    "light_to_moderate_rain",
+    "moderate_to_heavy_rain",
+    "rain_periodically_heavy",
+    "light_snow_showers",
+    "chance_of_snow_showers",
+    "scattered_snow_showers",
+    "heavy_snow_showers",
+    "light_to_moderate_snow",
+    "moderate_to_heavy_snow",
+    "light_snow",
+    "heavy_snow",
+    "snowstorm",
+    "snow_periodically_heavy",
+    "heavy_snow_storm",
+    "blowing_snow",
+    "rain_and_snow",
+    "hail",
+    "hail_showers",
+    "thundershower",
+    "light_thunderstorm_rain",
+    "scattered_thunderstorms",
+    "heavy_thunderstorm",
+    "smoke",
+    "dust",
+};
+
+// Name of an icon ID, "unknown" for anything outside the table
+constexpr const char* weatherIconName(WeatherIconId id) {
+    return id < ICON_COUNT ? weatherIconNames[id] : weatherIconNames[ICON_UNKNOWN];
+}
+
+static constexpr WeatherIconShape weatherIconShapes[ICON_COUNT] = {
+    ICON_SHAPE_CLEAR,
+    ICON_SHAPE_CLEAR,
+    ICON_SHAPE_CLEAR,
+    ICON_SHAPE_CLEAR,
+    ICON_SHAPE_PARTLY_CLOUDY,
+    ICON_SHAPE_PARTLY_CLOUDY,
+    ICON_SHAPE_PARTLY_CLOUDY,
+    ICON_SHAPE_PARTLY_CLOUDY,
+    ICON_SHAPE_PARTLY_CLOUDY,
+    ICON_SHAPE_CLOUDY,
+    ICON_SHAPE_CLOUDY,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_SNOW,
+    ICON_SHAPE_SNOW,
+    ICON_SHAPE_SNOW,
+    ICON_SHAPE_STORM,
+    ICON_SHAPE_FOG,
+    ICON_SHAPE_FOG,
+    ICON_SHAPE_FOG,
+    ICON_SHAPE_WIND,
+    ICON_SHAPE_WIND,
+    ICON_SHAPE_CLEAR,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_SNOW,
+    ICON_SHAPE_SNOW,
+    ICON_SHAPE_SNOW,
+    ICON_SHAPE_SNOW,
+    ICON_SHAPE_SNOW,
+    ICON_SHAPE_SNOW,
+    ICON_SHAPE_SNOW,
+    ICON_SHAPE_SNOW,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_CLEAR,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_STORM,
+    ICON_SHAPE_RAIN,
+    ICON_SHAPE_STORM,
+    ICON_SHAPE_STORM,
+    ICON_SHAPE_CLEAR,
+    ICON_SHAPE_CLEAR,
+};
+
+// Perfect hash of the lower-case names: FNV-1a % WEATHER_ICON_HASH_SIZE
+#define WEATHER_ICON_HASH_SIZE 437
+
+struct WeatherIconSlot {
+    uint32_t hash;
+    WeatherIconId id;
+};
+
+static constexpr WeatherIconSlot weatherIconSlots[WEATHER_ICON_HASH_SIZE] = {
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x90FE0DE8u, ICON_SCATTERED_SHOWERS},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x1AF8295Au, ICON_WINDY},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x347E59CAu, ICON_SNOW_SHOWERS},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x74BCEFDAu, ICON_HEAVY_SNOW},
+    {0x9DF789AFu, ICON_RAIN_PERIODICALLY_HEAVY},
+    {0x69CB141Bu, ICON_MOSTLY_CLEAR},
+    {0x00000000u, ICON_UNKNOWN},
+    {0xA4F7038Au, ICON_SCATTERED_SNOW_SHOWERS},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x991C2A6Fu, ICON_CHANCE_OF_SHOWERS},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x60063106u, ICON_SMOKE},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0xD51BF92Bu, ICON_HAIL_SHOWERS},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x1EAB7555u, ICON_PARTLY_CLOUDY_NIGHT},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x8DA5552Fu, ICON_CLEAR_NIGHT},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x69921B6Cu, ICON_MIST},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x848317F2u, ICON_SNOW},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0xEBD67D7Fu, ICON_LIGHT_SNOW_SHOWERS},
+    {0xE2B5F6ECu, ICON_PARTLY_CLOUDY},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0xDE02C9A1u, ICON_PARTLY_CLOUDY_DAY},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x946BA84Fu, ICON_MODERATE_TO_HEAVY_RAIN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x2B3F81D2u, ICON_THUNDERSTORM},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x95DAF4BBu, ICON_LIGHT_SNOW},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0xD5D71F06u, ICON_LIGHT_RAIN_SHOWERS},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0xCF5FB010u, ICON_SNOW_PERIODICALLY_HEAVY},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x77853CE0u, ICON_HEAVY_SNOW_STORM},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x278BD189u, ICON_PARTLY_CLEAR},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x2D8BC7ADu, ICON_FLURRIES},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x494372ECu, ICON_SUNNY},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x044837ABu, ICON_SNOWSTORM},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0xBA17A361u, ICON_RAIN_AND_SNOW},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x1414F107u, ICON_WIND},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x1C19FAE8u, ICON_WIND_AND_RAIN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x5C6E1222u, ICON_CLEAR},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x1587EF3Au, ICON_MOSTLY_CLOUDY},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0xF83E07BAu, ICON_HEAVY_THUNDERSTORM},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x62D1AAC3u, ICON_CLEAR_DAY},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x80026E0Bu, ICON_BLOWING_SNOW},
+    {0xA03ECADAu, ICON_LIGHT_THUNDERSTORM_RAIN},
+    {0x0A06BB7Eu, ICON_LIGHT_RAIN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x9D2FD18Eu, ICON_MODERATE_TO_HEAVY_SNOW},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x148892F3u, ICON_CHANCE_OF_SNOW_SHOWERS},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x89A3B5D3u, ICON_RAIN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0xA1F3723Fu, ICON_FOG},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x0A4A981Fu, ICON_HEAVY_RAIN_SHOWERS},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0xD5D6CBF7u, ICON_HAZE},
+    {0xB07A0DCFu, ICON_THUNDERSHOWER},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0xEEB69FA7u, ICON_HAIL},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0xD9AD0A47u, ICON_RAIN_SHOWERS},
+    {0x0724A2C2u, ICON_HEAVY_SNOW_SHOWERS},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x2DBC1605u, ICON_CLOUDY},
+    {0x9248CF72u, ICON_LIGHT_TO_MODERATE_RAIN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x470AB928u, ICON_SHOWERS},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0xCA0B3BA5u, ICON_DUST},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x91677833u, ICON_SCATTERED_THUNDERSTORMS},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x1E4B5B1Bu, ICON_HEAVY_RAIN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0xA6D4B01Fu, ICON_LIGHT_TO_MODERATE_SNOW},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+    {0x00000000u, ICON_UNKNOWN},
+};
+
+// Lookups are constexpr (C++11 single-return form) so literal names resolve
+// at compile time; at run time they walk the name once and never allocate.
+constexpr char weatherIconLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? char(c + ('a' - 'A')) : c;
+}
+
+constexpr uint32_t weatherIconHash(const char* s, size_t len, uint32_t h = 2166136261u) {
+    return len == 0 ? h : weatherIconHash(s + 1, len - 1, uint32_t((h ^ uint8_t(weatherIconLower(*s))) * 16777619u));
+}
+
+constexpr bool weatherIconNameMatches(const char* name, const char* s, size_t len) {
+    return len == 0 ? *name == '\0' : (*name == weatherIconLower(*s) && weatherIconNameMatches(name + 1, s + 1, len - 1));
+}
+
+constexpr WeatherIconId weatherIconFromSlot(const WeatherIconSlot& slot, uint32_t hash, const char* s, size_t len) {
+    return (slot.id != ICON_UNKNOWN && slot.hash == hash && weatherIconNameMatches(weatherIconNames[slot.id], s, len)) ? slot.id : ICON_UNKNOWN;
+}
+
+constexpr WeatherIconId weatherIconId(const char* s, size_t len) {
+    return weatherIconFromSlot(weatherIconSlots[weatherIconHash(s, len) % WEATHER_ICON_HASH_SIZE], weatherIconHash(s, len), s, len);
+}
+
+constexpr size_t weatherIconNameLength(const char* s) {
+    return *s ? 1 + weatherIconNameLength(s + 1) : 0;
+}
+
+constexpr WeatherIconId weatherIconId(const char* s) {
+    return weatherIconId(s, weatherIconNameLength(s));
+}
+
+static_assert(weatherIconId("clear_day") == ICON_CLEAR_DAY, "icon hash table out of date");
+
+#endif
@@ -3,6 +3,8 @@
 
 #include <Adafruit_GFX.h>
 #include <Arduino.h>
+#include "WeatherIconIds.h"
+#include "GfxRaster.h"
 
 // Colors matching GxEPD2_7C
 #define WI_BLACK 0x0000
@@ -16,10 +18,14 @@
 class WeatherIcons {
 public:
     WeatherIcons(Adafruit_GFX& display);
-    void drawWeatherIcon(String iconName, int x, int y, int iconSize = 94);
+    void drawWeatherIcon(WeatherIconId iconId, int x, int y, int iconSize = 94);
 
 private:
     Adafruit_GFX& _display;
+    GfxRaster _raster;
+
+    // Segments in the half circle at the end of each wind line
+    static const int WIND_HOOK_STEPS = 6;
     
     void drawSun(int x, int y, int radius, float scale);
     void drawCloud(int x, int y, float scale);
@@ -30,7 +36,7 @@ private:
     void drawWind(int x, int y, float scale);
     
     // Helpers
-    void drawThickLine(int x1, int y1, int x2, int y2, int width, uint16_t color);
+    void drawWindLine(int x1, int y, int x2, float hookRadius);
 };
 
 #endif
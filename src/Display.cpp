@@ -1,5 +1,10 @@
 #include "Display.h"
 #include <time.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include "FixedTrig.h"
 
 #include <Fonts/FreeMonoBold9pt7b.h>
 #include <Fonts/FreeMonoBold12pt7b.h>
@@ -21,96 +26,82 @@
 #include <Fonts/FreeSansBold18pt7b.h>
 #include <Fonts/FreeSansBold24pt7b.h>
 
+// Digest of the last frame sent to the panel. Kept in RTC memory so a wake
+// that would draw the same frame can skip the multi-second refresh.
+// The header clock is left out of the digest (only its date is compared), so
+// a skipped refresh leaves the time of the last real refresh on screen.
+RTC_DATA_ATTR static bool lastFrameValid = false;
+RTC_DATA_ATTR static uint32_t lastFrameDigest = 0;
+RTC_DATA_ATTR static int32_t lastFrameDay = -1;
+RTC_DATA_ATTR static uint32_t refreshesAvoided = 0;
+
 Display::Display() 
     : display(GxEPD2_730c_GDEP073E01(EPD_CS, EPD_DC, EPD_RST, EPD_BUSY)),
-      weatherIcons(display) 
+      displayList(GxEPD2_730c_GDEP073E01::WIDTH, GxEPD2_730c_GDEP073E01::HEIGHT),
+      frameBuffer(GxEPD2_730c_GDEP073E01::WIDTH, GxEPD2_730c_GDEP073E01::HEIGHT),
+      spareBuffer(GxEPD2_730c_GDEP073E01::WIDTH, GxEPD2_730c_GDEP073E01::HEIGHT),
+      weatherIcons(displayList),
+      raster(displayList),
+      fullFrame(DISPLAY_FULL_FRAME),
+      frameDay(-1)
 {
 }
 
 void Display::init() {
     Serial.println("Initializing display...");
-    // Increase reset duration to 10ms to ensure display wakes up properly
-    display.init(115200, true, 10, false);
+    // Increase reset duration to 10ms to ensure display wakes up properly.
+    // No diagnostic bitrate: this runs beside the loop task, and GxEPD2 would
+    // call Serial.begin() again underneath its output.
+    display.init(0, true, 10, false);
     delay(100); // Give it a moment to settle
     display.setRotation(0);
     display.setFullWindow();
 }
 
-void Display::RenderText(int16_t x, int16_t y, const GFXfont *font, uint16_t color, String text, int maxCharsPerLine) {
-  display.setFont(font);
-  display.setTextColor(color);
-  display.setCursor(x, y);
-
-  int currentLineLen = 0;
-  int start = 0;
-  int end = text.indexOf(' ');
-
-  while (end != -1) {
-    String word = text.substring(start, end);
-    
-    // Check if adding this word exceeds the line limit
-    // We only wrap if it's not the first word on the line
-    if (currentLineLen + word.length() > maxCharsPerLine && currentLineLen > 0) {
-      display.println();
-      currentLineLen = 0;
-    }
-    
-    // Add space before word if it's not the start of a line
-    if (currentLineLen > 0) {
-      display.print(" ");
-      currentLineLen++;
-    }
-    
-    display.print(word);
-    currentLineLen += word.length();
-    
-    start = end + 1;
-    end = text.indexOf(' ', start);
-  }
-  
-  // Process the remaining part of the string (last word)
-  String lastWord = text.substring(start);
-  if (lastWord.length() > 0) {
-    if (currentLineLen + lastWord.length() > maxCharsPerLine && currentLineLen > 0) {
-      display.println();
-    } else if (currentLineLen > 0) {
-      display.print(" ");
-    }
-    display.print(lastWord);
+void Display::RenderText(int16_t x, int16_t y, const GFXfont *font, uint16_t color, const char* text, int maxCharsPerLine) {
+  // Wrapped and measured once per frame; later pages reuse the layout
+  int8_t block = textLayout.layout(x, y, font, color, text, maxCharsPerLine);
+  if (block < 0) {
+    // Arena full: still draw the text, just without wrapping
+    displayList.setFont(font);
+    displayList.setTextColor(color);
+    displayList.setCursor(x, y);
+    displayList.print(text);
+    return;
   }
+  textLayout.draw(block, displayList);
 }
 
-void Display::RenderTitleText(int16_t x, int16_t y, String text, int16_t maxCharsPerLine) {
+void Display::RenderTitleText(int16_t x, int16_t y, const char* text, int16_t maxCharsPerLine) {
   RenderText(x, y, &FreeMono9pt7b, GxEPD_BLACK, text, maxCharsPerLine); // Assume title max 20 chars per line
 }
 
-void Display::RenderPrimaryValue(int16_t x, int16_t y, String text, int16_t maxCharsPerLine) {
+void Display::RenderPrimaryValue(int16_t x, int16_t y, const char* text, int16_t maxCharsPerLine) {
   RenderText(x, y, &FreeSansBold18pt7b, GxEPD_BLUE, text, maxCharsPerLine); // Assume subtitle max 30 chars per line
 }
 
-void Display::RenderSecondaryValue(int16_t x, int16_t y, String text, int16_t maxCharsPerLine) {
+void Display::RenderSecondaryValue(int16_t x, int16_t y, const char* text, int16_t maxCharsPerLine) {
   RenderText(x, y, &FreeSansBold12pt7b, GxEPD_BLACK, text, maxCharsPerLine); // Assume subtitle max 30 chars per line
 }
 
 void Display::drawWindDirection(int cx, int cy, int r, float WindDirection)
 {
-  display.drawCircle(cx, cy, r, GxEPD_BLACK);
-  float angle = (WindDirection - 90) * PI / 180.0;
+  displayList.drawCircle(cx, cy, r, GxEPD_BLACK);
+  uint16_t angle = fixedAngleDegrees(WindDirection - 90);
+  uint16_t spread = fixedAngleRadians(2.6);
+  int16_t x1, y1, x2, y2, x3, y3;
 
   // Calculate triangle vertices
   // Tip
-  int x1 = cx + (r - 6) * cos(angle);
-  int y1 = cy + (r - 6) * sin(angle);
+  fixedPolar(cx, cy, r - 6, angle, x1, y1);
 
   // Back Left (offset by ~150 degrees)
-  int x2 = cx + (r - 6) * cos(angle + 2.6);
-  int y2 = cy + (r - 6) * sin(angle + 2.6);
+  fixedPolar(cx, cy, r - 6, angle + spread, x2, y2);
 
   // Back Right (offset by ~-150 degrees)
-  int x3 = cx + (r - 6) * cos(angle - 2.6);
-  int y3 = cy + (r - 6) * sin(angle - 2.6);
+  fixedPolar(cx, cy, r - 6, angle - spread, x3, y3);
 
-  display.fillTriangle(x1, y1, x2, y2, x3, y3, GxEPD_RED);
+  displayList.fillTriangle(x1, y1, x2, y2, x3, y3, GxEPD_RED);
 }
 
 void Display::drawDailyForecast(int x, int y, int w, int h, const DailyForecast daily[]) {
@@ -119,16 +110,17 @@ void Display::drawDailyForecast(int x, int y, int w, int h, const DailyForecast
         int colX = x + i * colW;
         
         // Separator line
-        if (i > 0) display.drawLine(colX, y, colX, y + h, GxEPD_BLACK);
+        if (i > 0) displayList.drawLine(colX, y, colX, y + h, GxEPD_BLACK);
         
         // Day Name
-        RenderSecondaryValue(colX + 10, y + 25, daily[i].dayName, 12);
+        RenderSecondaryValue(colX + 10, y + 25, weekdayName(daily[i].weekday), 12);
         
         // Icon
-        weatherIcons.drawWeatherIcon(daily[i].iconName, colX + (colW-60)/2, y + 35, 60);
+        weatherIcons.drawWeatherIcon(daily[i].iconId, colX + (colW-60)/2, y + 35, 60);
         
         // High / Low
-        String tempStr = String(daily[i].tempHigh, 0) + " / " + String(daily[i].tempLow, 0);
+        char high[12], low[12], tempStr[32];
+        snprintf(tempStr, sizeof(tempStr), "%s / %s", dtostrf(daily[i].tempHigh, 2, 0, high), dtostrf(daily[i].tempLow, 2, 0, low));
         RenderSecondaryValue(colX + (colW/2) - 30, y + 110, tempStr, 15);
     }
 }
@@ -142,7 +134,7 @@ void Display::drawDottedLine(int x0, int y0, int x1, int y1, uint16_t color) {
 
   for (;;) {
     if (count % 4 < 2) { // 2 pixels on, 2 pixels off
-        display.drawPixel(x0, y0, color);
+        displayList.drawPixel(x0, y0, color);
     }
     if (x0 == x1 && y0 == y1) break;
     e2 = 2 * err;
@@ -152,440 +144,472 @@ void Display::drawDottedLine(int x0, int y0, int x1, int y1, uint16_t color) {
   }
 }
 
-void Display::drawGraphs(int x, int y, int w, int h, const HourlyData hourly[], const DailyForecast& today) {
-    // Margins
-    int marginLeft = 40;
-    int marginBottom = 30;
-    int marginRight = 45; 
-    int graphW = w - marginLeft - marginRight;
-    int graphH = h - marginBottom - 10;
-    int originX = x + marginLeft;
-    int originY = y + graphH; // Bottom of graph area
-    
-    // 1. Determine Min/Max Temp
-    float minVal = 100.0;
-    float maxVal = -100.0;
-    bool foundData = false;
-    
-    for (int i = 0; i < 24; i++) {
-        if (hourly[i].temp > -99.0) {
-            if (hourly[i].temp < minVal) minVal = hourly[i].temp;
-            if (hourly[i].temp > maxVal) maxVal = hourly[i].temp;
-            foundData = true;
-        }
-        if (hourly[i].actualTemp > -99.0) {
-            if (hourly[i].actualTemp < minVal) minVal = hourly[i].actualTemp;
-            if (hourly[i].actualTemp > maxVal) maxVal = hourly[i].actualTemp;
-            foundData = true;
-        }
-        if (hourly[i].indoorTemp > -99.0) {
-            if (hourly[i].indoorTemp < minVal) minVal = hourly[i].indoorTemp;
-            if (hourly[i].indoorTemp > maxVal) maxVal = hourly[i].indoorTemp;
-            foundData = true;
-        }
+void Display::drawSeries(const int16_t ys[], uint8_t width, uint16_t color) {
+  // Runs of valid hours: width 0 is dotted, 1 a plain line, wider a stroke
+  const GraphModel& g = graphModel;
+  RasterPoint run[GraphModel::HOURS];
+  int runLen = 0;
+  for (int i = 0; i <= GraphModel::HOURS; i++) {
+    if (i < GraphModel::HOURS && ys[i] != GRAPH_NO_VALUE) {
+      run[runLen++] = {g.columnX[i], ys[i]};
+      continue;
     }
-    
-    if (!foundData) {
-        minVal = 0;
-        maxVal = 30;
+    if (width > 1 && runLen > 1) {
+      raster.drawPolyline(run, runLen, width, color);
+    } else {
+      for (int j = 1; j < runLen; j++) {
+        if (width == 0) drawDottedLine(run[j-1].x, run[j-1].y, run[j].x, run[j].y, color);
+        else displayList.drawLine(run[j-1].x, run[j-1].y, run[j].x, run[j].y, color);
+      }
     }
+    runLen = 0;
+  }
+}
 
-    // 2. Auto-range with padding (+- 5)
-    float targetMin = minVal - 5.0;
-    float targetMax = maxVal + 5.0;
-    float range = targetMax - targetMin;
-    
-    // 3. Calculate Tick Step (aim for 7-10 ticks)
-    float rawStep = range / 8.0;
-    int step = 1;
-    if (rawStep > 5) step = 10;
-    else if (rawStep > 2) step = 5;
-    else if (rawStep > 1) step = 2;
-    else step = 1;
-    
-    // 4. Use exact range (+-5) for axis bounds, don't snap to tick steps
-    float minAxis = targetMin;
-    float maxAxis = targetMax;
+void Display::drawMarker(const GraphModel::Marker& marker, int labelOffset, uint16_t color) {
+  if (!marker.valid) return;
+  char label[12];
+  displayList.fillCircle(marker.x, marker.y, 3, color);
+  displayList.setCursor(marker.x - 10, marker.y + labelOffset);
+  displayList.print(dtostrf(marker.value, 3, 1, label));
+}
+
+void Display::drawGraphs(int x, int y, int w, int h, const HourlyData hourly[], const DailyForecast& today) {
+    // Axis ranges and pixel positions are worked out once per frame
+    if (!graphModel.built()) {
+        graphModel.build(x, y, w, h, hourly, today);
+    }
+    const GraphModel& g = graphModel;
+    int originX = g.originX;
+    int originY = g.originY;
+    int graphW = g.graphW;
     
     // Draw Axes
-    display.drawLine(originX, y, originX, originY, GxEPD_BLACK); // Left Y axis (Temp)
-    display.drawLine(originX + graphW, y, originX + graphW, originY, GxEPD_BLACK); // Right Y axis (Rain)
-    display.drawLine(originX, originY, originX + graphW, originY, GxEPD_BLACK); // X axis
+    displayList.drawLine(originX, y, originX, originY, GxEPD_BLACK); // Left Y axis (Temp)
+    displayList.drawLine(originX + graphW, y, originX + graphW, originY, GxEPD_BLACK); // Right Y axis (Rain)
+    displayList.drawLine(originX, originY, originX + graphW, originY, GxEPD_BLACK); // X axis
     
     // X Axis Labels (Hours)
-    display.setFont(&FreeMono9pt7b);
-    display.setTextColor(GxEPD_BLACK);
+    displayList.setFont(&FreeMono9pt7b);
+    displayList.setTextColor(GxEPD_BLACK);
     for (int i = 0; i < 24; i += 3) {
-        int px = originX + (i * graphW / 24) + (graphW / 48);
-        display.drawLine(px, originY, px, originY + 5, GxEPD_BLACK);
-        display.setCursor(px - 10, originY + 20);
-        display.print(String(i));
+        int px = g.columnX[i];
+        displayList.drawLine(px, originY, px, originY + 5, GxEPD_BLACK);
+        displayList.setCursor(px - 10, originY + 20);
+        displayList.print(i);
     }
     
     // Y Axis Labels (Temp) - Left side
-    // Start from the first multiple of 'step' that is >= minAxis
-    int startTick = ceil(minAxis / step) * step;
-    for (int t = startTick; t <= maxAxis; t += step) {
-        int py = originY - ((t - minAxis) * graphH / (maxAxis - minAxis));
-        if (py >= y && py <= originY) {
-            display.drawLine(originX - 5, py, originX, py, GxEPD_BLACK);
-            // Grid line
-            display.drawLine(originX, py, originX + graphW, py, GxEPD_YELLOW);
-            display.setCursor(originX - 35, py + 5);
-            display.print(String(t));
-        }
+    for (int i = 0; i < g.tempTickCount; i++) {
+        int py = g.tempTicks[i].y;
+        displayList.drawLine(originX - 5, py, originX, py, GxEPD_BLACK);
+        // Grid line
+        displayList.drawLine(originX, py, originX + graphW, py, GxEPD_YELLOW);
+        displayList.setCursor(originX - 35, py + 5);
+        displayList.print(g.tempTicks[i].value);
     }
 
     // Y Axis Labels (Rain Prob) - Right side
-    int maxRain = 100;
-    for (int r = 0; r <= maxRain; r += 10) {
-        int py = originY - (r * graphH / maxRain);
-        display.drawLine(originX + graphW, py, originX + graphW + 5, py, GxEPD_BLACK);
-        if (r % 20 == 0) {
-            display.setCursor(originX + graphW + 8, py + 5);
-            display.print(String(r));
+    for (int i = 0; i < GraphModel::RAIN_TICKS; i++) {
+        int py = g.rainTicks[i].y;
+        displayList.drawLine(originX + graphW, py, originX + graphW + 5, py, GxEPD_BLACK);
+        if (g.rainTicks[i].value % 20 == 0) {
+            displayList.setCursor(originX + graphW + 8, py + 5);
+            displayList.print(g.rainTicks[i].value);
         }
     }
     
     // Plot Rain Probability (Bars) - Blue
     for (int i = 0; i < 24; i++) {
-        if (hourly[i].rainProb >= 0) {
-            int barH = (hourly[i].rainProb * graphH) / 100;
-            int barW = (graphW / 24) - 2;
-            int px = originX + (i * graphW / 24) + 1;
-            int py = originY - barH;
-            display.fillRect(px, py, barW, barH, GxEPD_BLUE);
+        const GraphModel::Bar& bar = g.rainBars[i];
+        if (bar.h >= 0) {
+            displayList.fillRect(bar.x, bar.y, bar.w, bar.h, GxEPD_BLUE);
         }
     }
 
     // Plot Actual Rain (Bars)
     for (int i = 0; i < 24; i++) {
-        if (hourly[i].actualRain >= 0) {
-            // Scale: 1mm = 10% of graph height? Or 1mm = 1 unit on 0-100 scale?
-            // Let's use 1mm = 1 unit on 0-100 scale for now.
-            int barH = (hourly[i].actualRain * graphH) / 100;
-            if (barH > graphH) barH = graphH; // Clamp
-            
-            int barW = (graphW / 24) - 2;
-            int px = originX + (i * graphW / 24) + 1;
-            int py = originY - barH;
-            display.fillRect(px, py, barW, barH, GxEPD_RED);
-            display.fillRect(px-1, py-1, barW-2, barH-2, GxEPD_RED);
+        const GraphModel::Bar& bar = g.actualRainBars[i];
+        if (bar.h >= 0) {
+            displayList.fillRect(bar.x, bar.y, bar.w, bar.h, GxEPD_RED);
+            displayList.fillRect(bar.x-1, bar.y-1, bar.w-2, bar.h-2, GxEPD_RED);
         }
     }
     
-    // Plot Temperature (Line) - Red
-    int prevX = -1, prevY = -1;
-    for (int i = 0; i < 24; i++) {
-        if (hourly[i].temp > -99.0) {
-            int px = originX + (i * graphW / 24) + (graphW / 48);
-            int py = originY - ((hourly[i].temp - minAxis) * graphH / (maxAxis - minAxis));
-            
-            if (prevX != -1) {
-                display.drawLine(prevX, prevY, px, py, GxEPD_RED);
-                display.drawLine(prevX, prevY-1, px, py-1, GxEPD_RED);
-                display.drawLine(prevX, prevY+1, px, py+1, GxEPD_RED);
-            }
-            prevX = px;
-            prevY = py;
-        } else {
-            prevX = -1;
-        }
-    }
-    
-    // Plot Actual Temperature (Line) - Green
-    prevX = -1; prevY = -1;
-    for (int i = 0; i < 24; i++) {
-        if (hourly[i].actualTemp > -99.0) {
-            int px = originX + (i * graphW / 24) + (graphW / 48);
-            int py = originY - ((hourly[i].actualTemp - minAxis) * graphH / (maxAxis - minAxis));
-            
-            if (prevX != -1) {
-                display.drawLine(prevX, prevY, px, py, GxEPD_GREEN);
-                display.drawLine(prevX, prevY-1, px, py-1, GxEPD_GREEN);
-                display.drawLine(prevX, prevY+1, px, py+1, GxEPD_GREEN);
-            }
-            prevX = px;
-            prevY = py;
-        } else {
-            prevX = -1;
-        }
-    }
+    // Plot Temperature (Line) - Red, Actual Temperature (Line) - Green
+    drawSeries(g.tempY, 3, GxEPD_RED);
+    drawSeries(g.actualTempY, 3, GxEPD_GREEN);
 
     // Plot Indoor Temperature (Line) - Black
-    prevX = -1; prevY = -1;
-    for (int i = 0; i < 24; i++) {
-        if (hourly[i].indoorTemp > -99.0) {
-            int px = originX + (i * graphW / 24) + (graphW / 48);
-            int py = originY - ((hourly[i].indoorTemp - minAxis) * graphH / (maxAxis - minAxis));
-            
-            if (prevX != -1) {
-                display.drawLine(prevX, prevY, px, py, GxEPD_BLACK);
-            }
-            prevX = px;
-            prevY = py;
-        } else {
-            prevX = -1;
-        }
-    }
+    drawSeries(g.indoorTempY, 1, GxEPD_BLACK);
     
     // --- Pressure Graph (Dotted Lines) ---
-    // Calculate separate min/max for pressure
-    float minP = 2000.0, maxP = 0.0;
-    bool foundP = false;
-    for (int i = 0; i < 24; i++) {
-        if (hourly[i].pressure > 0) {
-            if (hourly[i].pressure < minP) minP = hourly[i].pressure;
-            if (hourly[i].pressure > maxP) maxP = hourly[i].pressure;
-            foundP = true;
-        }
-        if (hourly[i].actualPressure > 0) {
-            if (hourly[i].actualPressure < minP) minP = hourly[i].actualPressure;
-            if (hourly[i].actualPressure > maxP) maxP = hourly[i].actualPressure;
-            foundP = true;
-        }
-        if (hourly[i].indoorPressure > 0) {
-            if (hourly[i].indoorPressure < minP) minP = hourly[i].indoorPressure;
-            if (hourly[i].indoorPressure > maxP) maxP = hourly[i].indoorPressure;
-            foundP = true;
-        }
-    }
-    
-    if (foundP) {
-       // Add padding
-       float pRange = maxP - minP;
-       if (pRange < 1.0) pRange = 1.0; 
-       float minAxisP = minP - pRange * 0.1;
-       float maxAxisP = maxP + pRange * 0.1;
-
+    if (g.hasPressure) {
        // Pressure Axis Ticks (Green, Inside Left)
-       int pStep = 1;
-       if (pRange > 20.0) pStep = 10;
-       else if (pRange > 10.0) pStep = 5;
-       else if (pRange > 5.0) pStep = 2;
-       
-       display.setFont(&FreeMonoBold9pt7b);
-       display.setTextColor(GxEPD_GREEN);
-       
-       int startP = (int)ceil(minAxisP / pStep) * pStep;
-       for (int p = startP; p <= (int)maxAxisP; p += pStep) {
-           int py = originY - ((p - minAxisP) * graphH / (maxAxisP - minAxisP));
-           // Ensure we don't draw outside graph vertical bounds
-           if (py >= (originY - graphH) && py <= originY) {
-               display.drawLine(originX, py, originX + 5, py, GxEPD_GREEN);
-               display.setCursor(originX + 8, py + 4);
-               display.print(String(p));
-           }
+       displayList.setFont(&FreeMonoBold9pt7b);
+       displayList.setTextColor(GxEPD_GREEN);
+       for (int i = 0; i < g.pressureTickCount; i++) {
+           int py = g.pressureTicks[i].y;
+           displayList.drawLine(originX, py, originX + 5, py, GxEPD_GREEN);
+           displayList.setCursor(originX + 8, py + 4);
+           displayList.print(g.pressureTicks[i].value);
        }
 
-       // Forecast Pressure (Red Dotted)
-       prevX = -1; prevY = -1;
-       for (int i = 0; i < 24; i++) {
-           if (hourly[i].pressure > 0) {
-               int px = originX + (i * graphW / 24) + (graphW / 48);
-               int py = originY - ((hourly[i].pressure - minAxisP) * graphH / (maxAxisP - minAxisP));
-               if (prevX != -1) {
-                   drawDottedLine(prevX, prevY, px, py, GxEPD_RED);
-               }
-               prevX = px; prevY = py;
-           } else { prevX = -1; }
-       }
-       
-       // Actual Pressure (Green Dotted)
-       prevX = -1; prevY = -1;
-       for (int i = 0; i < 24; i++) {
-           if (hourly[i].actualPressure > 0) {
-               int px = originX + (i * graphW / 24) + (graphW / 48);
-               int py = originY - ((hourly[i].actualPressure - minAxisP) * graphH / (maxAxisP - minAxisP));
-               if (prevX != -1) {
-                   drawDottedLine(prevX, prevY, px, py, GxEPD_GREEN);
-               }
-               prevX = px; prevY = py;
-           } else { prevX = -1; }
-       }
-       
-       // Indoor Pressure (Black Dotted)
-       prevX = -1; prevY = -1;
-       for (int i = 0; i < 24; i++) {
-           if (hourly[i].indoorPressure > 0) {
-               int px = originX + (i * graphW / 24) + (graphW / 48);
-               int py = originY - ((hourly[i].indoorPressure - minAxisP) * graphH / (maxAxisP - minAxisP));
-               if (prevX != -1) {
-                   drawDottedLine(prevX, prevY, px, py, GxEPD_BLACK);
-               }
-               prevX = px; prevY = py;
-           } else { prevX = -1; }
-       }
-    }
-
-    // Find Min/Max for Forecast (Red)
-    float minF = 100.0, maxF = -100.0;
-    int minF_idx = -1, maxF_idx = -1;
-    
-    for(int i=0; i<24; i++) {
-        if(hourly[i].temp > -99.0) {
-            if(hourly[i].temp < minF) { minF = hourly[i].temp; minF_idx = i; }
-            if(hourly[i].temp > maxF) { maxF = hourly[i].temp; maxF_idx = i; }
-        }
+       // Forecast (Red), Actual (Green) and Indoor (Black) Pressure
+       drawSeries(g.pressureY, 0, GxEPD_RED);
+       drawSeries(g.actualPressureY, 0, GxEPD_GREEN);
+       drawSeries(g.indoorPressureY, 0, GxEPD_BLACK);
     }
     
-    // Find Min/Max for History (Green)
-    float minH = 100.0, maxH = -100.0;
-    int minH_idx = -1, maxH_idx = -1;
-    
-    for(int i=0; i<24; i++) {
-        if(hourly[i].actualTemp > -99.0) {
-            if(hourly[i].actualTemp < minH) { minH = hourly[i].actualTemp; minH_idx = i; }
-            if(hourly[i].actualTemp > maxH) { maxH = hourly[i].actualTemp; maxH_idx = i; }
-        }
-    }
-    
-    display.setFont(&FreeSansBold9pt7b);
-    display.setTextColor(GxEPD_BLACK);
-
-    // Draw Forecast Min/Max
-    if (minF_idx != -1) {
-        int px = originX + (minF_idx * graphW / 24) + (graphW / 48);
-        int py = originY - ((minF - minAxis) * graphH / (maxAxis - minAxis));
-        display.fillCircle(px, py, 3, GxEPD_RED);
-        display.setCursor(px - 10, py + 15);
-        display.print(String(minF, 1));
-    }
-    if (maxF_idx != -1 && maxF_idx != minF_idx) {
-        int px = originX + (maxF_idx * graphW / 24) + (graphW / 48);
-        int py = originY - ((maxF - minAxis) * graphH / (maxAxis - minAxis));
-        display.fillCircle(px, py, 3, GxEPD_RED);
-        display.setCursor(px - 10, py - 8);
-        display.print(String(maxF, 1));
-    }
+    displayList.setFont(&FreeSansBold9pt7b);
+    displayList.setTextColor(GxEPD_BLACK);
 
-    // Draw History Min/Max
-    if (minH_idx != -1) {
-        int px = originX + (minH_idx * graphW / 24) + (graphW / 48);
-        int py = originY - ((minH - minAxis) * graphH / (maxAxis - minAxis));
-        display.fillCircle(px, py, 3, GxEPD_GREEN);
-        display.setCursor(px - 10, py + 15);
-        display.print(String(minH, 1));
-    }
-    if (maxH_idx != -1 && maxH_idx != minH_idx) {
-        int px = originX + (maxH_idx * graphW / 24) + (graphW / 48);
-        int py = originY - ((maxH - minAxis) * graphH / (maxAxis - minAxis));
-        display.fillCircle(px, py, 3, GxEPD_GREEN);
-        display.setCursor(px - 10, py - 8);
-        display.print(String(maxH, 1));
-    }
+    // Forecast (Red) and History (Green) Min/Max
+    drawMarker(g.forecastMin, 15, GxEPD_RED);
+    drawMarker(g.forecastMax, -8, GxEPD_RED);
+    drawMarker(g.historyMin, 15, GxEPD_GREEN);
+    drawMarker(g.historyMax, -8, GxEPD_GREEN);
 
     // Sunrise/Sunset Lines
-    if (today.sunriseHour > 0) {
-        int sunX = originX + (int)(today.sunriseHour * graphW / 24.0);
+    if (g.sunriseX >= 0) {
+        int sunX = g.sunriseX;
         for (int ly = y; ly < originY; ly += 6) {
-            display.drawLine(sunX, ly, sunX, ly + 2, GxEPD_BLACK);
+            displayList.drawLine(sunX, ly, sunX, ly + 2, GxEPD_BLACK);
         }
-        display.setFont(&FreeMonoBold9pt7b);
-        display.setTextColor(GxEPD_BLACK);
-        display.setCursor(sunX + 3, y + 15);
-        display.print(today.sunrise);
+        displayList.setFont(&FreeMonoBold9pt7b);
+        displayList.setTextColor(GxEPD_BLACK);
+        displayList.setCursor(sunX + 3, y + 15);
+        char sunriseText[6];
+        formatTimeOfDay(today.sunrise, sunriseText);
+        displayList.print(sunriseText);
     }
-    if (today.sunsetHour > 0) {
-        int sunX = originX + (int)(today.sunsetHour * graphW / 24.0);
+    if (g.sunsetX >= 0) {
+        int sunX = g.sunsetX;
         for (int ly = y; ly < originY; ly += 6) {
-            display.drawLine(sunX, ly, sunX, ly + 2, GxEPD_BLACK);
+            displayList.drawLine(sunX, ly, sunX, ly + 2, GxEPD_BLACK);
         }
-        display.setFont(&FreeMonoBold9pt7b);
-        display.setTextColor(GxEPD_BLACK);
-        display.setCursor(sunX - 55, y + 15);
-        display.print(today.sunset);
+        displayList.setFont(&FreeMonoBold9pt7b);
+        displayList.setTextColor(GxEPD_BLACK);
+        displayList.setCursor(sunX - 55, y + 15);
+        char sunsetText[6];
+        formatTimeOfDay(today.sunset, sunsetText);
+        displayList.print(sunsetText);
     }
 }
 
 void Display::drawWeather(const WeatherData& current, const DailyForecast daily[], const HourlyData hourly[]) {
+  // Record the scene once; each page then replays only the commands in its band
+  unsigned long recordStart = millis();
+  textLayout.clear();
+  graphModel.invalidate();
+  displayList.beginRecording();
+  drawScene(current, daily, hourly);
+  bool replay = !displayList.overflowed();
+  if (replay) {
+    Serial.printf("Display list recorded: %u commands in %lu ms\n", displayList.size(), millis() - recordStart);
+    Serial.printf("Text layout: %u runs, %u of %u arena bytes%s\n", textLayout.runCount(), textLayout.bytesUsed(),
+                  TextLayout::ARENA_BYTES, textLayout.overflowed() ? " (full)" : "");
+  } else {
+    Serial.println("Display list overflowed, drawing each page directly");
+  }
+
+  // Skip the refresh entirely when the panel already shows this frame
+  uint32_t digest = replay ? displayList.digest() : 0;
+  const char* reason = nullptr;
+  if (!replay) reason = "display list overflowed, no digest";
+  else if (!lastFrameValid) reason = "no previous frame";
+  else if (digest != lastFrameDigest) reason = "scene changed";
+  else if (frameDay != lastFrameDay) reason = "date changed";
+  if (!reason) {
+    refreshesAvoided++;
+    Serial.printf("Frame unchanged (digest %08lx), skipping refresh. Refreshes avoided: %lu\n",
+                  (unsigned long)digest, (unsigned long)refreshesAvoided);
+    display.hibernate();
+    return;
+  }
+  Serial.printf("Refreshing panel: %s (digest %08lx, previous %08lx)\n",
+                reason, (unsigned long)digest, (unsigned long)lastFrameDigest);
+  // Only a recorded frame has a digest to compare against next time
+  lastFrameValid = replay;
+  lastFrameDigest = digest;
+  lastFrameDay = frameDay;
+
+  if (fullFrame && replay && drawFullFrame()) {
+    return;
+  }
+
+#if DISPLAY_DUMP_FRAME
+  Serial.println("Frame dump skipped: only full-frame renders keep the whole frame");
+#endif
+
+#if DISPLAY_BAND_PIPELINE
+  if (replay && drawBandPipeline()) {
+    return;
+  }
+#endif
+
   // Use paged drawing mode (like your weather display)
   Serial.println("Starting paged rendering...");
+  unsigned long pagedStart = millis();
   display.firstPage();
   int page = 0;
   do
   {
-    Serial.print("Rendering Page: "); Serial.println(page++);
-    
-    // Fill with white
-    display.fillScreen(GxEPD_WHITE);
-    
-    if (current.valid) {
-      int headerH = 30;
-      int bottomH = 130;
-      int mainH = 480 - headerH - bottomH; // 320
-      int mainY = headerH;
-      int bottomY = 480 - bottomH;
-      int w = 800;
-
-      // Draw Header (Date/Time)
-      struct tm timeinfo;
-      if(getLocalTime(&timeinfo)){
-        char timeStr[64];
-        strftime(timeStr, sizeof(timeStr), "%A %d %B %H:%M", &timeinfo);
-        
-        display.setFont(&FreeSansBold12pt7b);
-        display.setTextColor(GxEPD_BLACK);
-        int16_t tbx, tby; uint16_t tbw, tbh;
-        display.getTextBounds(timeStr, 0, 0, &tbx, &tby, &tbw, &tbh);
-        display.setCursor((w - tbw) / 2, headerH - 6);
-        display.print(timeStr);
-      }
-      
-      // Header separator
-      display.drawLine(0, headerH, w, headerH, GxEPD_BLACK);
+    Serial.print("Rendering Page: "); Serial.println(page);
+    if (replay) {
+      int16_t bandTop = page * display.pageHeight();
+      displayList.replay(display, bandTop, bandTop + display.pageHeight() - 1);
+    } else {
+      int16_t bandTop = page * display.pageHeight();
+      textLayout.rewind();
+      textLayout.setBand(bandTop, bandTop + display.pageHeight() - 1);
+      displayList.beginDirect(display);
+      drawScene(current, daily, hourly);
+    }
+    page++;
+  }
+  while (display.nextPage());
+  
+  Serial.printf("Paged render: %lu ms including refresh\n", millis() - pagedStart);
+  Serial.println("Paged rendering complete - display should show content");
+}
 
-      // --- Left Column: Current Weather (1/3 width = ~266px) ---
-      int leftW = 266;
-      int centerX = leftW / 2;
-      
-      // Icon
-      weatherIcons.drawWeatherIcon(current.iconName, leftW - 100, mainY + 10, 94);
-      
-      // Condition Text
-      int textY = mainY + 90;
-      RenderSecondaryValue(10, textY, current.conditionText, 20);
-      
-      // Temp
-      RenderPrimaryValue(10, textY + 40, String(current.temp, 1) + " C");
-      RenderSecondaryValue(10, textY + 70, "Feels: " + String(current.feelsLike, 1), 20);
-      
-      // Wind
-      RenderSecondaryValue(10, textY + 100, "Wind: " + String(current.windSpeed, 1) + " km/h", 20);
-      drawWindDirection(220, textY + 100, 30, current.windDirection);
-      
-      // Humidity / Rain (Condensed)
-      RenderSecondaryValue(10, textY + 130, "H:" + String(current.humidity) + "% R:" + String(current.precipitationProbability) + "%", 20);
-      
-      // UV / Pressure (Condensed)
-      RenderSecondaryValue(10, textY + 160, "UV:" + String(current.uvIndex) + " P:" + String(current.pressure), 20);
+bool Display::drawFullFrame() {
+  const int16_t w = display.width();
+  const int16_t h = display.height();
+  const int16_t chunkRows = display.pageHeight();
+  size_t frameBytes = (size_t)(w / 2) * h;
 
-      // Indoor
-      if (current.indoorTemp > -99.0) {
-          RenderSecondaryValue(10, textY + 190, "In: " + String(current.indoorTemp, 1) + " C", 20);
-          RenderSecondaryValue(10, textY + 220, "In Hum: " + String(current.indoorHumidity, 0) + " %", 20);
-      }
+  if (ESP.getFreeHeap() < frameBytes + FULL_FRAME_HEAP_RESERVE) {
+    Serial.printf("Full-frame mode skipped, only %u bytes free. Using paged mode.\n", ESP.getFreeHeap());
+    return false;
+  }
+  if (!frameBuffer.allocate(h, chunkRows)) {
+    Serial.println("Full-frame buffer allocation failed. Using paged mode.");
+    return false;
+  }
+
+  Serial.println("Starting full-frame rendering...");
+  unsigned long start = millis();
+  frameBuffer.setTop(0);
+  displayList.replay(frameBuffer, 0, h - 1);
+  unsigned long rasterised = millis();
+
+  // Chunks go out back to back as one paged write, followed by a single refresh
+  if (frameBuffer.chunkCount() > 1) display.epd2.setPaged();
+  for (uint8_t i = 0; i < frameBuffer.chunkCount(); i++) {
+    int16_t y = i * chunkRows;
+    int16_t rows = min<int16_t>(chunkRows, h - y);
+    display.epd2.writeNative(frameBuffer.chunk(i), nullptr, 0, y, w, rows, false, false, false);
+  }
+  unsigned long transferred = millis();
+  display.epd2.refresh(false);
+  display.epd2.powerOff();
+  unsigned long refreshed = millis();
+
+  Serial.printf("Full-frame render: rasterise %lu ms, transfer %lu ms, refresh %lu ms\n",
+                rasterised - start, transferred - rasterised, refreshed - transferred);
+#if DISPLAY_DUMP_FRAME
+  frameBuffer.dump(Serial);
+#endif
+  frameBuffer.release();
+  return true;
+}
 
-      // Vertical Separator
-      display.drawLine(leftW, mainY, leftW, bottomY, GxEPD_BLACK);
+// Shared by drawBandPipeline (sending, on the loop task) and rasterBandsTask.
+// Band buffers circulate between the two queues by slot index; with a single
+// producer and consumer the bands come out in order.
+struct BandPipeline {
+  const DisplayList* list;
+  FrameBuffer* buffers[2];
+  QueueHandle_t freeSlots;  // Buffers the rasteriser may fill
+  QueueHandle_t readySlots; // Buffers holding a finished band
+  SemaphoreHandle_t done;
+  int16_t bandRows;
+  uint8_t bands;
+  unsigned long rasterUs;
+};
+
+static void rasterBandsTask(void* arg) {
+  BandPipeline* p = static_cast<BandPipeline*>(arg);
+  for (uint8_t band = 0; band < p->bands; band++) {
+    uint8_t slot;
+    xQueueReceive(p->freeSlots, &slot, portMAX_DELAY);
+    unsigned long start = micros();
+    int16_t top = band * p->bandRows;
+    p->buffers[slot]->setTop(top);
+    p->list->replay(*p->buffers[slot], top, top + p->bandRows - 1);
+    p->rasterUs += micros() - start;
+    xQueueSend(p->readySlots, &slot, portMAX_DELAY);
+  }
+  xSemaphoreGive(p->done);
+  vTaskDelete(NULL);
+}
 
-      // --- Right Column: Graph (2/3 width = ~534px) ---
-      drawGraphs(leftW, mainY, w - leftW, mainH, hourly, daily[0]);
-      
-      // Horizontal Separator
-      display.drawLine(0, bottomY, w, bottomY, GxEPD_BLACK);
-      
-      // --- Bottom Row: Daily Forecast ---
-      drawDailyForecast(0, bottomY, w, bottomH, daily);
+bool Display::drawBandPipeline() {
+  const int16_t w = display.width();
+  const int16_t h = display.height();
+  const int16_t bandRows = display.pageHeight();
+  size_t bandBytes = (size_t)(w / 2) * bandRows;
 
-    } else {
-      display.setFont(&FreeMonoBold24pt7b);
-      display.setTextColor(GxEPD_BLACK);
-      display.setCursor(50, 100);
-      display.println("No Weather Data");
+  if (ESP.getFreeHeap() < 2 * bandBytes + FULL_FRAME_HEAP_RESERVE) {
+    Serial.printf("Band pipeline skipped, only %u bytes free. Using paged mode.\n", ESP.getFreeHeap());
+    return false;
+  }
+
+  BandPipeline p;
+  p.list = &displayList;
+  p.buffers[0] = &frameBuffer;
+  p.buffers[1] = &spareBuffer;
+  p.bandRows = bandRows;
+  p.bands = (h + bandRows - 1) / bandRows;
+  p.rasterUs = 0;
+  p.freeSlots = xQueueCreate(2, sizeof(uint8_t));
+  p.readySlots = xQueueCreate(2, sizeof(uint8_t));
+  p.done = xSemaphoreCreateBinary();
+
+  bool ready = p.freeSlots && p.readySlots && p.done &&
+               frameBuffer.allocate(bandRows, bandRows) && spareBuffer.allocate(bandRows, bandRows);
+  if (ready) {
+    for (uint8_t slot = 0; slot < 2; slot++) xQueueSend(p.freeSlots, &slot, 0);
+    Serial.println("Starting pipelined band rendering...");
+  }
+  unsigned long start = micros();
+  if (ready && xTaskCreatePinnedToCore(rasterBandsTask, "rasterBands", 4096, &p, 1, NULL, BAND_PIPELINE_CORE) != pdPASS) {
+    ready = false;
+  }
+  if (!ready) {
+    Serial.println("Band pipeline setup failed. Using paged mode.");
+  } else {
+    // Each band goes out while the rasteriser fills the other buffer. The
+    // GxEPD2 driver writes through blocking SPI transfers, so the overlap
+    // comes from the second core rather than from DMA.
+    unsigned long waitUs = 0, sendUs = 0;
+    display.epd2.setPaged();
+    for (uint8_t band = 0; band < p.bands; band++) {
+      uint8_t slot;
+      unsigned long waitStart = micros();
+      xQueueReceive(p.readySlots, &slot, portMAX_DELAY);
+      unsigned long sendStart = micros();
+      int16_t y = band * bandRows;
+      display.epd2.writeNative(p.buffers[slot]->chunk(0), nullptr, 0, y, w, min<int16_t>(bandRows, h - y), false, false, false);
+      xQueueSend(p.freeSlots, &slot, portMAX_DELAY);
+      waitUs += sendStart - waitStart;
+      sendUs += micros() - sendStart;
     }
+    // The task has finished with the buffers once it signals done
+    xSemaphoreTake(p.done, portMAX_DELAY);
+    unsigned long transferred = micros();
+    display.epd2.refresh(false);
+    display.epd2.powerOff();
+    unsigned long refreshed = micros();
+
+    unsigned long wallUs = transferred - start;
+    unsigned long busyUs = p.rasterUs + sendUs;
+    Serial.printf("Band pipeline: rasterise %lu ms, transfer %lu ms, wall %lu ms, overlap %lu ms (waited %lu ms for bands), refresh %lu ms\n",
+                  p.rasterUs / 1000, sendUs / 1000, wallUs / 1000, busyUs > wallUs ? (busyUs - wallUs) / 1000 : 0,
+                  waitUs / 1000, (refreshed - transferred) / 1000);
   }
-  while (display.nextPage());
+
+  frameBuffer.release();
+  spareBuffer.release();
+  if (p.freeSlots) vQueueDelete(p.freeSlots);
+  if (p.readySlots) vQueueDelete(p.readySlots);
+  if (p.done) vSemaphoreDelete(p.done);
+  return ready;
+}
+
+void Display::drawScene(const WeatherData& current, const DailyForecast daily[], const HourlyData hourly[]) {
+  frameDay = -1;
+  // Fill with white
+  displayList.fillScreen(GxEPD_WHITE);
   
-  Serial.println("Paged rendering complete - display should show content");
+  if (current.valid) {
+    int headerH = 30;
+    int bottomH = 130;
+    int mainH = 480 - headerH - bottomH; // 320
+    int mainY = headerH;
+    int bottomY = 480 - bottomH;
+    int w = 800;
+
+    // Header separator
+    displayList.drawLine(0, headerH, w, headerH, GxEPD_BLACK);
+
+    // --- Left Column: Current Weather (1/3 width = ~266px) ---
+    int leftW = 266;
+    int centerX = leftW / 2;
+    
+    // Icon
+    weatherIcons.drawWeatherIcon(current.iconId, leftW - 100, mainY + 10, 94);
+    
+    // Condition Text
+    int textY = mainY + 90;
+    RenderSecondaryValue(10, textY, current.conditionText, 20);
+
+    // Labels are formatted into stack buffers; dtostrf(v, n + 2, n) is what
+    // String(float, n) uses, so the text is unchanged
+    char label[32], num[12];
+    
+    // Temp
+    snprintf(label, sizeof(label), "%s C", dtostrf(current.temp, 3, 1, num));
+    RenderPrimaryValue(10, textY + 40, label);
+    snprintf(label, sizeof(label), "Feels: %s", dtostrf(current.feelsLike, 3, 1, num));
+    RenderSecondaryValue(10, textY + 70, label, 20);
+    
+    // Wind
+    snprintf(label, sizeof(label), "Wind: %s km/h", dtostrf(current.windSpeed, 3, 1, num));
+    RenderSecondaryValue(10, textY + 100, label, 20);
+    drawWindDirection(220, textY + 100, 30, current.windDirection);
+    
+    // Humidity / Rain (Condensed)
+    snprintf(label, sizeof(label), "H:%d%% R:%d%%", current.humidity, current.precipitationProbability);
+    RenderSecondaryValue(10, textY + 130, label, 20);
+    
+    // UV / Pressure (Condensed)
+    snprintf(label, sizeof(label), "UV:%d P:%d", current.uvIndex, current.pressure);
+    RenderSecondaryValue(10, textY + 160, label, 20);
+
+    // Indoor
+    if (current.indoorTemp > -99.0) {
+        snprintf(label, sizeof(label), "In: %s C", dtostrf(current.indoorTemp, 3, 1, num));
+        RenderSecondaryValue(10, textY + 190, label, 20);
+        snprintf(label, sizeof(label), "In Hum: %s %%", dtostrf(current.indoorHumidity, 2, 0, num));
+        RenderSecondaryValue(10, textY + 220, label, 20);
+    }
+
+    // Vertical Separator
+    displayList.drawLine(leftW, mainY, leftW, bottomY, GxEPD_BLACK);
+
+    // --- Right Column: Graph (2/3 width = ~534px) ---
+    drawGraphs(leftW, mainY, w - leftW, mainH, hourly, daily[0]);
+    
+    // Horizontal Separator
+    displayList.drawLine(0, bottomY, w, bottomY, GxEPD_BLACK);
+    
+    // --- Bottom Row: Daily Forecast ---
+    drawDailyForecast(0, bottomY, w, bottomH, daily);
+
+    // Draw Header (Date/Time) last: the clock changes every wake, so it is
+    // recorded after the digest ends and only the date is compared
+    displayList.endDigest();
+    struct tm timeinfo;
+    if(getLocalTime(&timeinfo)){
+      frameDay = (timeinfo.tm_year + 1900) * 1000 + timeinfo.tm_yday;
+      char timeStr[64];
+      strftime(timeStr, sizeof(timeStr), "%A %d %B %H:%M", &timeinfo);
+      
+      displayList.setFont(&FreeSansBold12pt7b);
+      displayList.setTextColor(GxEPD_BLACK);
+      int16_t tbx, tby; uint16_t tbw, tbh;
+      displayList.getTextBounds(timeStr, 0, 0, &tbx, &tby, &tbw, &tbh);
+      displayList.setCursor((w - tbw) / 2, headerH - 6);
+      displayList.print(timeStr);
+    }
+
+  } else {
+    displayList.setFont(&FreeMonoBold24pt7b);
+    displayList.setTextColor(GxEPD_BLACK);
+    displayList.setCursor(50, 100);
+    displayList.println("No Weather Data");
+  }
 }
@@ -6,6 +6,12 @@
 #include <epd7c/GxEPD2_730c_GDEP073E01.h>
 #include <Adafruit_GFX.h>
 #include "WeatherIcons.h"
+#include "DisplayList.h"
+#include "FrameBuffer.h"
+#include "GfxRaster.h"
+#include "TextLayout.h"
+#include "WeatherData.h"
+#include "GraphModel.h"
 
 // Pin definitions
 #define EPD_BUSY 25
@@ -15,70 +21,59 @@
 #define EPD_SCK  18
 #define EPD_MOSI 23
 
-struct WeatherData {
-  String conditionText;
-  String iconName;
-  float temp;
-  float feelsLike;
-  float windSpeed;
-  float windGust;
-  int windDirection;
-  int humidity;
-  int precipitationProbability;
-  int uvIndex;
-  int pressure;
-  bool valid = false;
-  float indoorTemp = -100.0;
-  float indoorHumidity = -1.0;
-  float indoorPressure = -1.0;
-};
-
-struct DailyForecast {
-  String dayName;
-  String iconName;
-  String conditionText;
-  float tempHigh;
-  float tempLow;
-  String sunrise;
-  String sunset;
-  float sunriseHour = -1.0;
-  float sunsetHour = -1.0;
-
-  DailyForecast() {}
-  DailyForecast(String dn, String iname, String ct, float th, float tl, String sr, String ss, float srh, float ssh) 
-    : dayName(dn), iconName(iname), conditionText(ct), tempHigh(th), tempLow(tl), sunrise(sr), sunset(ss), sunriseHour(srh), sunsetHour(ssh) {}
-};
-
-struct HourlyData {
-  int hour; // 0-23
-  float temp;
-  int rainProb;
-  float actualTemp = -100.0; // -100 indicates no data
-  float actualRain = -1.0;   // -1 indicates no data
-  float indoorTemp = -100.0; // -100 indicates no data
-  float pressure = -1.0;
-  float actualPressure = -1.0;
-  float indoorPressure = -1.0;
-};
+// Render the whole frame in one pass into a 4bpp buffer instead of page by
+// page. Only for boards with PSRAM: the 192 KB frame does not fit beside the
+// WiFi stack in the FireBeetle's internal heap (enable with -DDISPLAY_FULL_FRAME=1)
+#ifndef DISPLAY_FULL_FRAME
+#define DISPLAY_FULL_FRAME 0
+#endif
+// Print each full-frame render to Serial for frame_dump.py (slow: ~400 KB of hex)
+#ifndef DISPLAY_DUMP_FRAME
+#define DISPLAY_DUMP_FRAME 0
+#endif
+// Heap left free after allocating the full-frame buffer
+#define FULL_FRAME_HEAP_RESERVE 32768
+// When the full frame does not fit, rasterise the next band on the other
+// core while the previous one is sent to the panel (two page-sized buffers)
+#ifndef DISPLAY_BAND_PIPELINE
+#define DISPLAY_BAND_PIPELINE 1
+#endif
+// Core the band rasteriser runs on; the Arduino loop task owns core 1
+#define BAND_PIPELINE_CORE 0
 
 class Display {
 public:
     Display();
     void init();
     void drawWeather(const WeatherData& current, const DailyForecast daily[], const HourlyData hourly[]);
+    void setFullFrame(bool enabled) { fullFrame = enabled; }
 
 private:
     GxEPD2_7C<GxEPD2_730c_GDEP073E01, GxEPD2_730c_GDEP073E01::HEIGHT / 8> display;
+    DisplayList displayList; // Scene is recorded once, then replayed per page
+    FrameBuffer frameBuffer;
+    FrameBuffer spareBuffer; // Second band buffer for the pipelined render
     WeatherIcons weatherIcons;
+    GfxRaster raster; // Wide strokes, drawn into displayList
+    TextLayout textLayout;
+    GraphModel graphModel;
+    bool fullFrame;
+    int32_t frameDay; // Year * 1000 + day of year in the header, or -1
+
+    void drawScene(const WeatherData& current, const DailyForecast daily[], const HourlyData hourly[]);
+    bool drawFullFrame();
+    bool drawBandPipeline();
 
-    void RenderText(int16_t x, int16_t y, const GFXfont *font, uint16_t color, String text, int maxCharsPerLine = 12);
-    void RenderTitleText(int16_t x, int16_t y, String text, int16_t maxCharsPerLine = 15);
-    void RenderPrimaryValue(int16_t x, int16_t y, String text, int16_t maxCharsPerLine = 15);
-    void RenderSecondaryValue(int16_t x, int16_t y, String text, int16_t maxCharsPerLine = 20);
+    void RenderText(int16_t x, int16_t y, const GFXfont *font, uint16_t color, const char* text, int maxCharsPerLine = 12);
+    void RenderTitleText(int16_t x, int16_t y, const char* text, int16_t maxCharsPerLine = 15);
+    void RenderPrimaryValue(int16_t x, int16_t y, const char* text, int16_t maxCharsPerLine = 15);
+    void RenderSecondaryValue(int16_t x, int16_t y, const char* text, int16_t maxCharsPerLine = 20);
     void drawWindDirection(int cx, int cy, int r, float WindDirection);
     void drawDailyForecast(int x, int y, int w, int h, const DailyForecast daily[]);
     void drawGraphs(int x, int y, int w, int h, const HourlyData hourly[], const DailyForecast& today);
     void drawDottedLine(int x0, int y0, int x1, int y1, uint16_t color);
+    void drawSeries(const int16_t ys[], uint8_t width, uint16_t color);
+    void drawMarker(const GraphModel::Marker& marker, int labelOffset, uint16_t color);
 };
 
 #endif
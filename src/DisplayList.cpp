@@ -0,0 +1,184 @@
+#include "DisplayList.h"
+
+DisplayList::DisplayList(int16_t w, int16_t h, uint16_t capacity)
+    : Adafruit_GFX(w, h),
+      _commands(nullptr),
+      _capacity(capacity),
+      _count(0),
+      _digestCount(0),
+      _digestFonts(0),
+      _digestEnded(false),
+      _overflow(false),
+      _direct(nullptr),
+      _fontCount(0)
+{
+}
+
+DisplayList::~DisplayList() {
+    free(_commands);
+}
+
+void DisplayList::beginRecording() {
+    // Allocated on first use so the buffer only exists once rendering starts
+    if (!_commands) {
+        _commands = (Command*)malloc(sizeof(Command) * _capacity);
+    }
+    _count = 0;
+    _digestEnded = false;
+    _overflow = (_commands == nullptr);
+    _direct = nullptr;
+    _fontCount = 0;
+}
+
+void DisplayList::beginDirect(Adafruit_GFX& target) {
+    _count = 0;
+    _direct = &target;
+    _fontCount = 0;
+}
+
+void DisplayList::add(uint8_t op, uint16_t color, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t top, int16_t bottom, uint8_t font) {
+    Command cmd = {op, font, color, x0, y0, x1, y1, top, bottom};
+    if (_direct) {
+        execute(*_direct, cmd);
+        return;
+    }
+    if (_count >= _capacity) {
+        _overflow = true;
+        return;
+    }
+    _commands[_count++] = cmd;
+}
+
+uint8_t DisplayList::fontIndex(const GFXfont* font) {
+    for (uint8_t i = 0; i < _fontCount; i++) {
+        if (_fonts[i] == font) return i;
+    }
+    if (_fontCount >= MAX_FONTS) return MAX_FONTS;
+    _fonts[_fontCount] = font;
+    return _fontCount++;
+}
+
+void DisplayList::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    add(OP_PIXEL, color, x, y, 0, 0, y, y);
+}
+
+void DisplayList::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    add(OP_LINE, color, x0, y0, x1, y1, min(y0, y1), max(y0, y1));
+}
+
+void DisplayList::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    int16_t y1 = y + h - 1;
+    add(OP_VLINE, color, x, y, 0, h, min(y, y1), max(y, y1));
+}
+
+void DisplayList::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    add(OP_HLINE, color, x, y, w, 0, y, y);
+}
+
+void DisplayList::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (w <= 0) return;
+    int16_t y1 = y + h - 1;
+    add(OP_RECT, color, x, y, w, h, min(y, y1), max(y, y1));
+}
+
+void DisplayList::fillScreen(uint16_t color) {
+    // Kept as its own op so paged targets can use their fast buffer fill
+    add(OP_SCREEN, color, 0, 0, 0, 0, 0, height() - 1);
+}
+
+size_t DisplayList::write(uint8_t c) {
+    // Only custom fonts at size 1 are recorded as glyphs; anything else is
+    // decomposed into pixels and rects by the base implementation.
+    if (!gfxFont || textsize_x != 1 || textsize_y != 1) {
+        return Adafruit_GFX::write(c);
+    }
+
+    // Cursor handling mirrors Adafruit_GFX::write so wrapping is unchanged
+    uint8_t yAdvance = pgm_read_byte(&gfxFont->yAdvance);
+    if (c == '\n') {
+        cursor_x = 0;
+        cursor_y += yAdvance;
+    } else if (c != '\r') {
+        uint8_t first = pgm_read_byte(&gfxFont->first);
+        if ((c >= first) && (c <= (uint8_t)pgm_read_byte(&gfxFont->last))) {
+            const GFXglyph* glyph = gfxFont->glyph + (c - first);
+            uint8_t w = pgm_read_byte(&glyph->width);
+            uint8_t h = pgm_read_byte(&glyph->height);
+            if ((w > 0) && (h > 0)) {
+                int16_t xo = (int8_t)pgm_read_byte(&glyph->xOffset);
+                int16_t yo = (int8_t)pgm_read_byte(&glyph->yOffset);
+                if (wrap && ((cursor_x + xo + w) > _width)) {
+                    cursor_x = 0;
+                    cursor_y += yAdvance;
+                }
+                uint8_t font = fontIndex(gfxFont);
+                if (font >= MAX_FONTS) {
+                    _overflow = true;
+                } else {
+                    add(OP_GLYPH, textcolor, cursor_x, cursor_y, c, 0, cursor_y + yo, cursor_y + yo + h - 1, font);
+                }
+            }
+            cursor_x += (uint8_t)pgm_read_byte(&glyph->xAdvance);
+        }
+    }
+    return 1;
+}
+
+void DisplayList::execute(Adafruit_GFX& target, const Command& cmd) const {
+    switch (cmd.op) {
+        case OP_PIXEL:
+            target.drawPixel(cmd.x0, cmd.y0, cmd.color);
+            break;
+        case OP_LINE:
+            target.startWrite();
+            target.writeLine(cmd.x0, cmd.y0, cmd.x1, cmd.y1, cmd.color);
+            target.endWrite();
+            break;
+        case OP_VLINE:
+            target.drawFastVLine(cmd.x0, cmd.y0, cmd.y1, cmd.color);
+            break;
+        case OP_HLINE:
+            target.drawFastHLine(cmd.x0, cmd.y0, cmd.x1, cmd.color);
+            break;
+        case OP_RECT:
+            target.fillRect(cmd.x0, cmd.y0, cmd.x1, cmd.y1, cmd.color);
+            break;
+        case OP_SCREEN:
+            target.fillScreen(cmd.color);
+            break;
+        case OP_GLYPH:
+            target.setFont(_fonts[cmd.font]);
+            target.drawChar(cmd.x0, cmd.y0, (unsigned char)cmd.x1, cmd.color, cmd.color, 1);
+            break;
+    }
+}
+
+void DisplayList::endDigest() {
+    _digestCount = _count;
+    _digestFonts = _fontCount;
+    _digestEnded = true;
+}
+
+uint32_t DisplayList::digest() const {
+    uint16_t count = _digestEnded ? _digestCount : _count;
+    uint8_t fontCount = _digestEnded ? _digestFonts : _fontCount;
+    uint32_t hash = 2166136261u;
+    const uint8_t* bytes = (const uint8_t*)_commands;
+    for (size_t i = 0; i < sizeof(Command) * count; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    // Glyph commands refer to fonts by index, so the fonts are part of the frame
+    bytes = (const uint8_t*)_fonts;
+    for (size_t i = 0; i < sizeof(_fonts[0]) * fontCount; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+void DisplayList::replay(Adafruit_GFX& target, int16_t bandTop, int16_t bandBottom) const {
+    for (uint16_t i = 0; i < _count; i++) {
+        const Command& cmd = _commands[i];
+        if (cmd.bottom < bandTop || cmd.top > bandBottom) continue;
+        execute(target, cmd);
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef DISPLAY_LIST_H
+#define DISPLAY_LIST_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+// Records Adafruit_GFX draw calls into a compact command buffer so a paged
+// display can build the scene once and replay only the commands that touch
+// each page band. Higher level primitives (circles, triangles, text) reach
+// the buffer through the Adafruit_GFX hooks as spans, lines and glyphs.
+class DisplayList : public Adafruit_GFX {
+public:
+    DisplayList(int16_t w, int16_t h, uint16_t capacity = 4096);
+    ~DisplayList();
+
+    // Clear the buffer and record subsequent draw calls
+    void beginRecording();
+    // Forward subsequent draw calls straight to target (no recording)
+    void beginDirect(Adafruit_GFX& target);
+
+    // Draw every recorded command whose bounds intersect rows [bandTop, bandBottom]
+    void replay(Adafruit_GFX& target, int16_t bandTop, int16_t bandBottom) const;
+
+    uint16_t size() const { return _count; }
+    bool overflowed() const { return _overflow; }
+    // FNV-1a hash of the recorded commands; equal digests draw equal frames
+    uint32_t digest() const;
+    // End the digest at the commands recorded so far, so later ones (the
+    // header clock) can change without changing digest()
+    void endDigest();
+
+    // Adafruit_GFX hooks
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) override;
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void fillScreen(uint16_t color) override;
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+private:
+    enum Op : uint8_t { OP_PIXEL, OP_LINE, OP_VLINE, OP_HLINE, OP_RECT, OP_SCREEN, OP_GLYPH };
+
+    struct Command {
+        uint8_t op;
+        uint8_t font;      // Index into _fonts (OP_GLYPH only)
+        uint16_t color;
+        int16_t x0, y0, x1, y1; // Op specific: endpoints, origin + size, or cursor + char
+        int16_t top, bottom;    // Rows touched by the command
+    };
+
+    static const uint8_t MAX_FONTS = 16;
+
+    Command* _commands;
+    uint16_t _capacity;
+    uint16_t _count;
+    uint16_t _digestCount; // Commands covered by digest()
+    uint8_t _digestFonts;
+    bool _digestEnded;
+    bool _overflow;
+    Adafruit_GFX* _direct;
+    const GFXfont* _fonts[MAX_FONTS];
+    uint8_t _fontCount;
+
+    void add(uint8_t op, uint16_t color, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t top, int16_t bottom, uint8_t font = 0);
+    uint8_t fontIndex(const GFXfont* font);
+    void execute(Adafruit_GFX& target, const Command& cmd) const;
+};
+
+#endif
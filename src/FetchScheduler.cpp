@@ -0,0 +1,107 @@
+#include "FetchScheduler.h"
+#include <freertos/task.h>
+
+FetchScheduler::FetchScheduler(uint8_t maxConnections)
+    : _jobCount(0),
+      _nextJob(0),
+      _maxConnections(constrain(maxConnections, 1, MAX_CONNECTIONS)),
+      _runStart(0) {
+    _lock = xSemaphoreCreateMutex();
+    _finished = xSemaphoreCreateCounting(MAX_CONNECTIONS, 0);
+}
+
+FetchScheduler::~FetchScheduler() {
+    vSemaphoreDelete(_lock);
+    vSemaphoreDelete(_finished);
+}
+
+bool FetchScheduler::add(const char* name, FetchFn fetch, int arg, DoneFn done, int tag) {
+    if (_jobCount >= MAX_JOBS) {
+        Serial.printf("Fetch queue full, dropping %s\n", name);
+        return false;
+    }
+    Job& job = _jobs[_jobCount++];
+    job.name = name;
+    job.fetch = fetch;
+    job.arg = arg;
+    job.done = done;
+    job.tag = tag;
+    job.ok = false;
+    job.connection = 0;
+    job.startMs = 0;
+    job.endMs = 0;
+    job.bytes = 0;
+    return true;
+}
+
+FetchScheduler::Job* FetchScheduler::takeJob() {
+    Job* job = nullptr;
+    xSemaphoreTake(_lock, portMAX_DELAY);
+    if (_nextJob < _jobCount) job = &_jobs[_nextJob++];
+    xSemaphoreGive(_lock);
+    return job;
+}
+
+void FetchScheduler::work(uint8_t connection) {
+    // One client per connection, kept alive across the jobs it picks up
+    WeatherClient client(connection);
+    Job* job;
+    while ((job = takeJob()) != nullptr) {
+        job->connection = connection;
+        job->startMs = millis();
+        uint32_t bytesBefore = client.bodyBytes();
+        job->ok = job->fetch(client, job->arg);
+        job->endMs = millis();
+        job->bytes = client.bodyBytes() - bytesBefore;
+        Serial.printf("[%u] %s %s in %lu ms\n", connection, job->name, job->ok ? "fetched" : "failed",
+                      job->endMs - job->startMs);
+        if (job->done) job->done(job->tag, job->ok);
+    }
+    client.stop();
+}
+
+void FetchScheduler::workerTask(void* arg) {
+    Worker* worker = static_cast<Worker*>(arg);
+    worker->scheduler->work(worker->connection);
+    xSemaphoreGive(worker->scheduler->_finished);
+    vTaskDelete(NULL);
+}
+
+void FetchScheduler::run() {
+    if (_jobCount == 0 || !_lock || !_finished) return;
+    _runStart = millis();
+    _nextJob = 0;
+
+    uint8_t connections = min(_maxConnections, _jobCount);
+    uint8_t started = 0;
+    for (uint8_t i = 1; i < connections; i++) {
+        Worker& worker = _workers[i];
+        worker.scheduler = this;
+        worker.connection = i;
+        char name[12];
+        snprintf(name, sizeof(name), "fetch%u", i);
+        if (xTaskCreate(workerTask, name, FETCH_TASK_STACK, &worker, 1, NULL) != pdPASS) {
+            Serial.printf("Fetch task %u failed to start\n", i);
+            continue;
+        }
+        started++;
+    }
+    Serial.printf("Fetching %u requests over %u connections\n", _jobCount, started + 1);
+
+    work(0);
+    for (uint8_t i = 0; i < started; i++) {
+        xSemaphoreTake(_finished, portMAX_DELAY);
+    }
+
+    unsigned long elapsed = millis() - _runStart;
+    unsigned long serial = 0;
+    uint32_t bytes = 0;
+    for (uint8_t i = 0; i < _jobCount; i++) {
+        const Job& job = _jobs[i];
+        serial += job.endMs - job.startMs;
+        bytes += job.bytes;
+        Serial.printf("  %-16s conn %u, %5lu..%5lu ms, %6lu bytes, %s\n", job.name, job.connection,
+                      job.startMs - _runStart, job.endMs - _runStart, (unsigned long)job.bytes, job.ok ? "ok" : "failed");
+    }
+    Serial.printf("Fetch phase: %lu ms (requests sum to %lu ms), %lu bytes downloaded\n", elapsed, serial, (unsigned long)bytes);
+}
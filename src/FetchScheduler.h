@@ -0,0 +1,71 @@
+#ifndef FETCH_SCHEDULER_H
+#define FETCH_SCHEDULER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "WeatherClient.h"
+
+// Requests in flight at once. Each connection holds its own TLS session
+// (roughly 40 KB of heap) and, beyond the first, a fetch task stack.
+#ifndef FETCH_MAX_CONNECTIONS
+#define FETCH_MAX_CONNECTIONS 2
+#endif
+#define FETCH_TASK_STACK 12288
+
+// Runs independent API requests concurrently over up to maxConnections
+// kept-alive connections. The calling task works the first connection and
+// a FreeRTOS task is started for each other one. Jobs are taken in the
+// order they were added; each job's done handler runs on the connection
+// that fetched it as soon as its response has been parsed.
+class FetchScheduler {
+public:
+    static const uint8_t MAX_JOBS = 8;
+    static const uint8_t MAX_CONNECTIONS = 4;
+
+    typedef bool (*FetchFn)(WeatherClient& client, int arg);
+    typedef void (*DoneFn)(int tag, bool ok);
+
+    explicit FetchScheduler(uint8_t maxConnections = FETCH_MAX_CONNECTIONS);
+    ~FetchScheduler();
+
+    bool add(const char* name, FetchFn fetch, int arg, DoneFn done, int tag);
+    // Run every job added so far; returns once all have finished
+    void run();
+
+    uint8_t jobCount() const { return _jobCount; }
+
+private:
+    struct Job {
+        const char* name;
+        FetchFn fetch;
+        int arg;
+        DoneFn done;
+        int tag;
+        bool ok;
+        uint8_t connection;
+        unsigned long startMs;
+        unsigned long endMs;
+        uint32_t bytes;
+    };
+
+    struct Worker {
+        FetchScheduler* scheduler;
+        uint8_t connection;
+    };
+
+    Job _jobs[MAX_JOBS];
+    Worker _workers[MAX_CONNECTIONS];
+    uint8_t _jobCount;
+    uint8_t _nextJob;
+    uint8_t _maxConnections;
+    unsigned long _runStart;
+    SemaphoreHandle_t _lock;     // Guards _nextJob
+    SemaphoreHandle_t _finished; // Given once by each fetch task
+
+    Job* takeJob();
+    void work(uint8_t connection);
+    static void workerTask(void* arg);
+};
+
+#endif
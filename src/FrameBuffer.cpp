@@ -0,0 +1,177 @@
+#include "FrameBuffer.h"
+#include <string.h>
+
+FrameBuffer::FrameBuffer(int16_t w, int16_t h)
+    : Adafruit_GFX(w, h),
+      _chunkCount(0),
+      _chunkRows(0),
+      _rows(0),
+      _top(0)
+{
+}
+
+FrameBuffer::~FrameBuffer() {
+    release();
+}
+
+bool FrameBuffer::allocate(int16_t rows, int16_t chunkRows) {
+    release();
+    if (rows <= 0 || chunkRows <= 0) return false;
+
+    uint8_t count = (rows + chunkRows - 1) / chunkRows;
+    if (count > MAX_CHUNKS) return false;
+
+    for (uint8_t i = 0; i < count; i++) {
+        int16_t chunkHeight = min<int16_t>(chunkRows, rows - i * chunkRows);
+        _chunks[i] = (uint8_t*)malloc((size_t)(_width / 2) * chunkHeight);
+        if (!_chunks[i]) {
+            _chunkCount = i;
+            release();
+            return false;
+        }
+        _chunkCount = i + 1;
+    }
+    _rows = rows;
+    _chunkRows = chunkRows;
+    return true;
+}
+
+void FrameBuffer::release() {
+    for (uint8_t i = 0; i < _chunkCount; i++) {
+        free(_chunks[i]);
+        _chunks[i] = nullptr;
+    }
+    _chunkCount = 0;
+    _rows = 0;
+}
+
+size_t FrameBuffer::chunkBytes(uint8_t i) const {
+    int16_t chunkHeight = min<int16_t>(_chunkRows, _rows - i * _chunkRows);
+    return (size_t)(_width / 2) * chunkHeight;
+}
+
+uint8_t FrameBuffer::colorIndex(uint16_t color) {
+    switch (color) {
+        case GxEPD_BLACK:  return 0x00;
+        case GxEPD_WHITE:  return 0x01;
+        case GxEPD_GREEN:  return 0x02;
+        case GxEPD_BLUE:   return 0x03;
+        case GxEPD_RED:    return 0x04;
+        case GxEPD_YELLOW: return 0x05;
+        case GxEPD_ORANGE: return 0x06;
+    }
+    // Other colours snap to the nearest panel colour by channel thresholds
+    uint16_t red = color & 0xF800;
+    uint16_t green = (color & 0x07E0) << 5;
+    uint16_t blue = (color & 0x001F) << 11;
+    if ((red < 0x8000) && (green < 0x8000) && (blue < 0x8000)) return 0x00;
+    if ((red >= 0x8000) && (green >= 0x8000) && (blue >= 0x8000)) return 0x01;
+    if ((red >= 0x8000) && (blue >= 0x8000)) return red > blue ? 0x04 : 0x03;
+    if ((green >= 0x8000) && (blue >= 0x8000)) return green > blue ? 0x02 : 0x03;
+    if ((red >= 0x8000) && (green >= 0x8000)) {
+        const uint16_t yellowToOrange = ((GxEPD_YELLOW - GxEPD_ORANGE) / 2 + (GxEPD_ORANGE & 0x07E0)) << 5;
+        return green > yellowToOrange ? 0x05 : 0x06;
+    }
+    if (red >= 0x8000) return 0x04;
+    if (green >= 0x8000) return 0x02;
+    return 0x03;
+}
+
+void FrameBuffer::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || x >= _width) return;
+    y -= _top;
+    if (y < 0 || y >= _rows) return;
+
+    uint8_t& px = row(y)[x / 2];
+    uint8_t nibble = colorIndex(color);
+    if (x & 1) px = (px & 0xF0) | nibble;
+    else px = (px & 0x0F) | (nibble << 4);
+}
+
+void FrameBuffer::fillSpan(uint8_t* row, int16_t x0, int16_t x1, uint8_t nibble) {
+    // Pixels x0..x1 inclusive: odd leading / even trailing pixels share a byte
+    // with their neighbour, everything between is whole bytes
+    if (x0 & 1) {
+        row[x0 / 2] = (row[x0 / 2] & 0xF0) | nibble;
+        x0++;
+    }
+    if (!(x1 & 1) && x1 >= x0) {
+        row[x1 / 2] = (row[x1 / 2] & 0x0F) | (nibble << 4);
+        x1--;
+    }
+    if (x1 < x0) return;
+
+    uint8_t packed = nibble | (nibble << 4);
+    uint8_t* p = row + x0 / 2;
+    uint8_t* end = row + x1 / 2 + 1;
+    // Word stores once aligned; memcpy keeps them within the aliasing rules
+    while (p < end && ((uintptr_t)p & 3)) *p++ = packed;
+    uint32_t word = packed * 0x01010101u;
+    for (; p + 4 <= end; p += 4) memcpy(p, &word, 4);
+    while (p < end) *p++ = packed;
+}
+
+void FrameBuffer::fillArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    // Clip to the screen width and to the rows this buffer holds
+    if (x0 < 0) x0 = 0;
+    if (x1 >= _width) x1 = _width - 1;
+    y0 -= _top;
+    y1 -= _top;
+    if (y0 < 0) y0 = 0;
+    if (y1 >= _rows) y1 = _rows - 1;
+    if (x0 > x1 || y0 > y1) return;
+
+    uint8_t nibble = colorIndex(color);
+    for (int16_t y = y0; y <= y1; y++) {
+        fillSpan(row(y), x0, x1, nibble);
+    }
+}
+
+// The base Adafruit_GFX versions draw these as lines between the first and
+// last pixel, so zero and negative lengths still cover both end points; the
+// same extents are kept here so the output does not change.
+void FrameBuffer::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    int16_t x1 = x + w - 1;
+    fillArea(min(x, x1), y, max(x, x1), y, color);
+}
+
+void FrameBuffer::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    int16_t y1 = y + h - 1;
+    fillArea(x, min(y, y1), x, max(y, y1), color);
+}
+
+void FrameBuffer::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (w <= 0) return;
+    int16_t y1 = y + h - 1;
+    fillArea(x, min(y, y1), x + w - 1, max(y, y1), color);
+}
+
+void FrameBuffer::fillScreen(uint16_t color) {
+    uint8_t nibble = colorIndex(color);
+    uint8_t packed = nibble | (nibble << 4);
+    for (uint8_t i = 0; i < _chunkCount; i++) {
+        memset(_chunks[i], packed, chunkBytes(i));
+    }
+}
+
+void FrameBuffer::dump(Print& out) const {
+    static const char hex[] = "0123456789abcdef";
+    size_t rowBytes = _width / 2;
+    char line[65];
+    out.printf("FRAME_BEGIN %d %d %d\n", _width, _rows, _top);
+    for (int16_t y = 0; y < _rows; y++) {
+        const uint8_t* row = _chunks[y / _chunkRows] + (size_t)(y % _chunkRows) * rowBytes;
+        // Sent in 32 byte pieces so the line buffer stays small
+        for (size_t i = 0; i < rowBytes; i += 32) {
+            size_t n = min<size_t>(32, rowBytes - i);
+            for (size_t j = 0; j < n; j++) {
+                line[j * 2] = hex[row[i + j] >> 4];
+                line[j * 2 + 1] = hex[row[i + j] & 0x0F];
+            }
+            line[n * 2] = 0;
+            out.print(line);
+        }
+        out.print('\n');
+    }
+    out.println("FRAME_END");
+}
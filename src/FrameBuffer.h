@@ -0,0 +1,62 @@
+#ifndef FRAME_BUFFER_H
+#define FRAME_BUFFER_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <GxEPD2.h>
+
+// Off-screen 4 bits per pixel canvas in the 7-colour panel's native nibble
+// format (two pixels per byte, high nibble first). The rows it holds are
+// split into separately allocated chunks so a full 800x480 frame does not
+// need a single 192 KB block, and each chunk can be streamed as one page.
+class FrameBuffer : public Adafruit_GFX {
+public:
+    static const uint8_t MAX_CHUNKS = 8;
+
+    FrameBuffer(int16_t w, int16_t h);
+    ~FrameBuffer();
+
+    // Allocate storage for `rows` rows in chunks of `chunkRows`. Returns false
+    // (holding nothing) if the heap cannot provide every chunk.
+    bool allocate(int16_t rows, int16_t chunkRows);
+    void release();
+    bool allocated() const { return _chunkCount > 0; }
+
+    // First screen row held by the buffer; pixels outside are clipped
+    void setTop(int16_t top) { _top = top; }
+    int16_t top() const { return _top; }
+    int16_t rows() const { return _rows; }
+
+    uint8_t chunkCount() const { return _chunkCount; }
+    int16_t chunkRows() const { return _chunkRows; }
+    const uint8_t* chunk(uint8_t i) const { return _chunks[i]; }
+    size_t chunkBytes(uint8_t i) const;
+
+    // Write the held rows as text for frame_dump.py: a "FRAME_BEGIN w h top"
+    // line, one line of hex nibbles per row, then "FRAME_END"
+    void dump(Print& out) const;
+
+    // Panel nibble for an RGB565 colour, matching GxEPD2_7C's mapping
+    static uint8_t colorIndex(uint16_t color);
+
+    // Adafruit_GFX hooks
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void fillScreen(uint16_t color) override;
+    // Spans are written as packed bytes / 32-bit words, clipped to the held rows
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+
+private:
+    uint8_t* _chunks[MAX_CHUNKS];
+    uint8_t _chunkCount;
+    int16_t _chunkRows;
+    int16_t _rows;
+    int16_t _top;
+
+    uint8_t* row(int16_t y) const { return _chunks[y / _chunkRows] + (size_t)(y % _chunkRows) * (_width / 2); }
+    void fillSpan(uint8_t* row, int16_t x0, int16_t x1, uint8_t nibble);
+    void fillArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+};
+
+#endif
@@ -0,0 +1,189 @@
+#include "GraphModel.h"
+#include <math.h>
+
+int16_t GraphModel::tempToY(float t) const {
+    return originY - ((t - minAxis) * graphH / (maxAxis - minAxis));
+}
+
+int16_t GraphModel::pressureToY(float p) const {
+    return originY - ((p - minAxisP) * graphH / (maxAxisP - minAxisP));
+}
+
+void GraphModel::buildTempSeries(const HourlyData hourly[], float HourlyData::*field, int16_t out[]) const {
+    for (int i = 0; i < HOURS; i++) {
+        out[i] = hourly[i].*field > -99.0 ? tempToY(hourly[i].*field) : GRAPH_NO_VALUE;
+    }
+}
+
+void GraphModel::buildPressureSeries(const HourlyData hourly[], float HourlyData::*field, int16_t out[]) const {
+    for (int i = 0; i < HOURS; i++) {
+        out[i] = hourly[i].*field > 0 ? pressureToY(hourly[i].*field) : GRAPH_NO_VALUE;
+    }
+}
+
+void GraphModel::buildMarkers(const HourlyData hourly[], float HourlyData::*field, Marker& minMarker, Marker& maxMarker) const {
+    float minV = 100.0, maxV = -100.0;
+    int minIdx = -1, maxIdx = -1;
+    for (int i = 0; i < HOURS; i++) {
+        float v = hourly[i].*field;
+        if (v > -99.0) {
+            if (v < minV) { minV = v; minIdx = i; }
+            if (v > maxV) { maxV = v; maxIdx = i; }
+        }
+    }
+    minMarker.valid = minIdx != -1;
+    if (minMarker.valid) {
+        minMarker.x = columnX[minIdx];
+        minMarker.y = tempToY(minV);
+        minMarker.value = minV;
+    }
+    // A flat series only gets the min marker
+    maxMarker.valid = maxIdx != -1 && maxIdx != minIdx;
+    if (maxMarker.valid) {
+        maxMarker.x = columnX[maxIdx];
+        maxMarker.y = tempToY(maxV);
+        maxMarker.value = maxV;
+    }
+}
+
+void GraphModel::build(int x, int y, int w, int h, const HourlyData hourly[], const DailyForecast& today) {
+    // Margins
+    int marginLeft = 40;
+    int marginBottom = 30;
+    int marginRight = 45;
+    graphW = w - marginLeft - marginRight;
+    graphH = h - marginBottom - 10;
+    originX = x + marginLeft;
+    originY = y + graphH; // Bottom of graph area
+    top = y;
+
+    for (int i = 0; i < HOURS; i++) {
+        columnX[i] = originX + (i * graphW / 24) + (graphW / 48);
+    }
+
+    // 1. Determine Min/Max Temp over every temperature series
+    float minVal = 100.0;
+    float maxVal = -100.0;
+    bool foundData = false;
+    for (int i = 0; i < HOURS; i++) {
+        const float temps[3] = {hourly[i].temp, hourly[i].actualTemp, hourly[i].indoorTemp};
+        for (int s = 0; s < 3; s++) {
+            if (temps[s] > -99.0) {
+                if (temps[s] < minVal) minVal = temps[s];
+                if (temps[s] > maxVal) maxVal = temps[s];
+                foundData = true;
+            }
+        }
+    }
+    if (!foundData) {
+        minVal = 0;
+        maxVal = 30;
+    }
+
+    // 2. Auto-range with padding (+- 5)
+    float targetMin = minVal - 5.0;
+    float targetMax = maxVal + 5.0;
+    float range = targetMax - targetMin;
+
+    // 3. Calculate Tick Step (aim for 7-10 ticks)
+    float rawStep = range / 8.0;
+    if (rawStep > 5) step = 10;
+    else if (rawStep > 2) step = 5;
+    else if (rawStep > 1) step = 2;
+    else step = 1;
+
+    // 4. Use exact range (+-5) for axis bounds, don't snap to tick steps
+    minAxis = targetMin;
+    maxAxis = targetMax;
+
+    // Start from the first multiple of 'step' that is >= minAxis
+    tempTickCount = 0;
+    int startTick = ceil(minAxis / step) * step;
+    for (int t = startTick; t <= maxAxis && tempTickCount < MAX_TICKS; t += step) {
+        int16_t py = tempToY(t);
+        if (py >= y && py <= originY) {
+            tempTicks[tempTickCount++] = {py, (int16_t)t};
+        }
+    }
+
+    int maxRain = 100;
+    for (int i = 0; i < RAIN_TICKS; i++) {
+        int r = i * 10;
+        rainTicks[i] = {(int16_t)(originY - (r * graphH / maxRain)), (int16_t)r};
+    }
+
+    // Bars sit inside their column with a 1 px gap either side
+    int barW = (graphW / 24) - 2;
+    for (int i = 0; i < HOURS; i++) {
+        int px = originX + (i * graphW / 24) + 1;
+        Bar& rain = rainBars[i];
+        rain = {(int16_t)px, 0, (int16_t)barW, -1};
+        if (hourly[i].rainProb >= 0) {
+            rain.h = (hourly[i].rainProb * graphH) / 100;
+            rain.y = originY - rain.h;
+        }
+
+        // Scale: 1mm = 1 unit on the 0-100 scale
+        Bar& actual = actualRainBars[i];
+        actual = {(int16_t)px, 0, (int16_t)barW, -1};
+        if (hourly[i].actualRain >= 0) {
+            int barH = (hourly[i].actualRain * graphH) / 100;
+            if (barH > graphH) barH = graphH; // Clamp
+            actual.h = barH;
+            actual.y = originY - barH;
+        }
+    }
+
+    buildTempSeries(hourly, &HourlyData::temp, tempY);
+    buildTempSeries(hourly, &HourlyData::actualTemp, actualTempY);
+    buildTempSeries(hourly, &HourlyData::indoorTemp, indoorTempY);
+
+    // Pressure gets its own range over every pressure series
+    float minP = 2000.0, maxP = 0.0;
+    hasPressure = false;
+    for (int i = 0; i < HOURS; i++) {
+        const float pressures[3] = {hourly[i].pressure, hourly[i].actualPressure, hourly[i].indoorPressure};
+        for (int s = 0; s < 3; s++) {
+            if (pressures[s] > 0) {
+                if (pressures[s] < minP) minP = pressures[s];
+                if (pressures[s] > maxP) maxP = pressures[s];
+                hasPressure = true;
+            }
+        }
+    }
+
+    pressureTickCount = 0;
+    if (hasPressure) {
+        // Add padding
+        float pRange = maxP - minP;
+        if (pRange < 1.0) pRange = 1.0;
+        minAxisP = minP - pRange * 0.1;
+        maxAxisP = maxP + pRange * 0.1;
+
+        int pStep = 1;
+        if (pRange > 20.0) pStep = 10;
+        else if (pRange > 10.0) pStep = 5;
+        else if (pRange > 5.0) pStep = 2;
+
+        int startP = (int)ceil(minAxisP / pStep) * pStep;
+        for (int p = startP; p <= (int)maxAxisP && pressureTickCount < MAX_TICKS; p += pStep) {
+            int16_t py = pressureToY(p);
+            // Ensure we don't draw outside graph vertical bounds
+            if (py >= (originY - graphH) && py <= originY) {
+                pressureTicks[pressureTickCount++] = {py, (int16_t)p};
+            }
+        }
+
+        buildPressureSeries(hourly, &HourlyData::pressure, pressureY);
+        buildPressureSeries(hourly, &HourlyData::actualPressure, actualPressureY);
+        buildPressureSeries(hourly, &HourlyData::indoorPressure, indoorPressureY);
+    }
+
+    buildMarkers(hourly, &HourlyData::temp, forecastMin, forecastMax);
+    buildMarkers(hourly, &HourlyData::actualTemp, historyMin, historyMax);
+
+    sunriseX = today.sunrise != TIME_OF_DAY_NONE && today.sunrise > 0 ? originX + today.sunrise * graphW / 1440 : -1;
+    sunsetX = today.sunset != TIME_OF_DAY_NONE && today.sunset > 0 ? originX + today.sunset * graphW / 1440 : -1;
+
+    _built = true;
+}
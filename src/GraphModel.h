@@ -0,0 +1,89 @@
+#ifndef GRAPH_MODEL_H
+#define GRAPH_MODEL_H
+
+#include <Arduino.h>
+#include "WeatherData.h"
+
+// Marks an hour with no value in a series
+#define GRAPH_NO_VALUE INT16_MIN
+
+// Everything drawGraphs needs in screen coordinates: axis ranges, ticks,
+// bars, series and min/max markers. Built once per frame from the hourly
+// data with no drawing involved, so the graph maths can run anywhere.
+class GraphModel {
+public:
+    static const int HOURS = 24;
+    static const int MAX_TICKS = 24;
+    static const int RAIN_TICKS = 11; // 0-100 % in steps of 10
+
+    struct Tick {
+        int16_t y;
+        int16_t value;
+    };
+
+    struct Bar {
+        int16_t x, y, w, h; // h < 0 when the hour has no value
+    };
+
+    struct Marker {
+        bool valid;
+        int16_t x, y;
+        float value;
+    };
+
+    // Plot area
+    int16_t top, originX, originY, graphW, graphH;
+
+    // Temperature axis (left)
+    float minAxis, maxAxis;
+    int step;
+    Tick tempTicks[MAX_TICKS];
+    uint8_t tempTickCount;
+
+    // Rain axis (right); labels on every other tick
+    Tick rainTicks[RAIN_TICKS];
+
+    // Centre of each hour's column
+    int16_t columnX[HOURS];
+
+    Bar rainBars[HOURS];
+    Bar actualRainBars[HOURS];
+
+    // Series y per hour, GRAPH_NO_VALUE where missing
+    int16_t tempY[HOURS];
+    int16_t actualTempY[HOURS];
+    int16_t indoorTempY[HOURS];
+
+    // Pressure (own axis, only when any pressure is present)
+    bool hasPressure;
+    float minAxisP, maxAxisP;
+    Tick pressureTicks[MAX_TICKS];
+    uint8_t pressureTickCount;
+    int16_t pressureY[HOURS];
+    int16_t actualPressureY[HOURS];
+    int16_t indoorPressureY[HOURS];
+
+    Marker forecastMin, forecastMax;
+    Marker historyMin, historyMax;
+
+    // Dashed sunrise / sunset lines, -1 if unknown
+    int16_t sunriseX, sunsetX;
+
+    GraphModel() : _built(false) {}
+
+    // Next build() recomputes (call once at the start of a frame)
+    void invalidate() { _built = false; }
+    bool built() const { return _built; }
+    void build(int x, int y, int w, int h, const HourlyData hourly[], const DailyForecast& today);
+
+private:
+    bool _built;
+
+    int16_t tempToY(float t) const;
+    int16_t pressureToY(float p) const;
+    void buildTempSeries(const HourlyData hourly[], float HourlyData::*field, int16_t out[]) const;
+    void buildPressureSeries(const HourlyData hourly[], float HourlyData::*field, int16_t out[]) const;
+    void buildMarkers(const HourlyData hourly[], float HourlyData::*field, Marker& minMarker, Marker& maxMarker) const;
+};
+
+#endif
@@ -0,0 +1,133 @@
+#include "HttpBodyStream.h"
+
+HttpBodyStream::HttpBodyStream(Stream& source, bool chunked, int contentLength)
+    : _source(source),
+      _chunked(chunked),
+      _inChunk(false),
+      _done(false),
+      _remaining(chunked ? 0 : contentLength),
+      _bytesRead(0),
+      _minFreeHeap(ESP.getFreeHeap()),
+      _pos(0),
+      _len(0) {
+    if (!chunked && contentLength == 0) _done = true;
+}
+
+void HttpBodyStream::sampleHeap() {
+    uint32_t freeHeap = ESP.getFreeHeap();
+    if (freeHeap < _minFreeHeap) _minFreeHeap = freeHeap;
+}
+
+bool HttpBodyStream::fill() {
+    if (_pos < _len) return true;
+    // Take what has already arrived; wait (with the source's timeout) for at
+    // least one byte otherwise. Never read past the known end of the body or
+    // chunk (chunk headers go a byte at a time), so a kept-alive connection
+    // is left exactly at the next response.
+    int avail = _source.available();
+    size_t want = avail > 0 ? min<size_t>(avail, sizeof(_buffer)) : 1;
+    if (_remaining > 0) want = min<size_t>(want, _remaining);
+    else if (_remaining == 0) want = 1;
+    _len = _source.readBytes((char*)_buffer, want);
+    _pos = 0;
+    sampleHeap();
+    return _len > 0;
+}
+
+int HttpBodyStream::rawRead() {
+    if (!fill()) return -1;
+    return _buffer[_pos++];
+}
+
+// Parse "<hex size>[;extension]\r\n", first consuming the CRLF that ends the
+// previous chunk. A zero size ends the body, after any trailer lines.
+bool HttpBodyStream::nextChunk() {
+    int c;
+    if (_inChunk && (rawRead() != '\r' || rawRead() != '\n')) return false;
+    int32_t size = 0;
+    int digits = 0;
+    while ((c = rawRead()) >= 0) {
+        int v;
+        if (c >= '0' && c <= '9') v = c - '0';
+        else if (c >= 'a' && c <= 'f') v = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') v = c - 'A' + 10;
+        else break;
+        if (++digits > 7) return false;
+        size = size * 16 + v;
+    }
+    if (digits == 0) return false;
+    while (c >= 0 && c != '\n') c = rawRead(); // Skip extensions and the CR
+    if (c < 0) return false;
+    if (size == 0) {
+        // Trailers end with an empty line
+        int length = 0;
+        while ((c = rawRead()) >= 0) {
+            if (c == '\n') {
+                if (length == 0) break;
+                length = 0;
+            } else if (c != '\r') {
+                length++;
+            }
+        }
+        return false;
+    }
+    _inChunk = true;
+    _remaining = size;
+    return true;
+}
+
+// True when at least one body byte can be read from the buffer
+bool HttpBodyStream::ready() {
+    if (_done) return false;
+    if (_remaining == 0 && !(_chunked && nextChunk())) {
+        _done = true;
+        return false;
+    }
+    if (!fill()) {
+        _done = true;
+        return false;
+    }
+    return true;
+}
+
+int HttpBodyStream::available() {
+    // Only what is buffered and known to be body
+    if (_done || _remaining == 0) return 0;
+    size_t n = _len - _pos;
+    if (_remaining > 0 && (size_t)_remaining < n) n = _remaining;
+    return n;
+}
+
+int HttpBodyStream::read() {
+    if (!ready()) return -1;
+    if (_remaining > 0) _remaining--;
+    _bytesRead++;
+    return _buffer[_pos++];
+}
+
+int HttpBodyStream::peek() {
+    if (!ready()) return -1;
+    return _buffer[_pos];
+}
+
+size_t HttpBodyStream::readBytes(char* buffer, size_t length) {
+    size_t copied = 0;
+    while (copied < length && ready()) {
+        size_t n = min(length - copied, _len - _pos);
+        if (_remaining >= 0 && (size_t)_remaining < n) n = _remaining;
+        memcpy(buffer + copied, _buffer + _pos, n);
+        _pos += n;
+        copied += n;
+        _bytesRead += n;
+        if (_remaining > 0) _remaining -= n;
+    }
+    return copied;
+}
+
+void HttpBodyStream::finish() {
+    // Without a length or chunking the body runs to the connection close
+    if (!_chunked && _remaining < 0) return;
+    char scratch[64];
+    while (readBytes(scratch, sizeof(scratch)) > 0) {
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef HTTP_BODY_STREAM_H
+#define HTTP_BODY_STREAM_H
+
+#include <Arduino.h>
+
+// Read-only view of an HTTP response body on the connection, so a parser
+// can consume it directly instead of via http.getString(). Reads go through
+// a small fixed buffer, and chunked transfer encoding is decoded on the fly.
+// The free heap is sampled on every refill to find the request's low point.
+class HttpBodyStream : public Stream {
+public:
+    static const size_t BUFFER_BYTES = 512;
+
+    // contentLength < 0 reads until the connection closes (or the last chunk)
+    HttpBodyStream(Stream& source, bool chunked, int contentLength);
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t readBytes(char* buffer, size_t length) override;
+    size_t write(uint8_t) override { return 0; }
+
+    // Read and discard the rest of the body (and chunked trailers) so the
+    // connection is left at the start of the next response
+    void finish();
+
+    bool chunked() const { return _chunked; }
+    size_t bytesRead() const { return _bytesRead; }
+    uint32_t minFreeHeap() const { return _minFreeHeap; }
+    void sampleHeap();
+
+private:
+    Stream& _source;
+    bool _chunked;
+    bool _inChunk;  // A chunk has been read, so its CRLF comes next
+    bool _done;
+    int32_t _remaining; // Body bytes left (in this chunk when chunked), -1 if unknown
+    size_t _bytesRead;
+    uint32_t _minFreeHeap;
+    uint8_t _buffer[BUFFER_BYTES];
+    size_t _pos;
+    size_t _len;
+
+    bool fill();
+    int rawRead();
+    bool ready();
+    bool nextChunk();
+};
+
+#endif
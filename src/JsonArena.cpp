@@ -0,0 +1,94 @@
+#include "JsonArena.h"
+
+// Each block is preceded by a header holding its requested size, padded so
+// the block itself stays ALIGN-aligned
+static const size_t HEADER = JsonArena::ALIGN;
+
+static size_t roundUp(size_t size) {
+    return (size + JsonArena::ALIGN - 1) & ~(JsonArena::ALIGN - 1);
+}
+
+JsonArena::JsonArena(uint8_t* buffer, size_t size)
+    : _buffer(buffer),
+      _size(buffer ? size : 0),
+      _top(0),
+      _last(NO_BLOCK),
+      _peak(0),
+      _heapBytes(0) {}
+
+void JsonArena::reset() {
+    _top = 0;
+    _last = NO_BLOCK;
+    _peak = 0;
+    _heapBytes = 0;
+}
+
+bool JsonArena::owns(const void* ptr) const {
+    const uint8_t* p = static_cast<const uint8_t*>(ptr);
+    return _size > 0 && p >= _buffer && p < _buffer + _size;
+}
+
+size_t JsonArena::blockSize(const void* ptr) const {
+    uint32_t size;
+    memcpy(&size, static_cast<const uint8_t*>(ptr) - HEADER, sizeof(size));
+    return size;
+}
+
+void* JsonArena::allocate(size_t size) {
+    size_t need = HEADER + roundUp(size);
+    if (need > _size - _top) {
+        _heapBytes += size;
+        return malloc(size);
+    }
+    uint32_t header = size;
+    memcpy(_buffer + _top, &header, sizeof(header));
+    _last = _top;
+    _top += need;
+    if (_top > _peak) _peak = _top;
+    return _buffer + _last + HEADER;
+}
+
+void JsonArena::deallocate(void* ptr) {
+    if (!ptr) return;
+    if (!owns(ptr)) {
+        free(ptr);
+        return;
+    }
+    // Only the newest block's space can be taken back before reset()
+    if (_last != NO_BLOCK && ptr == _buffer + _last + HEADER) {
+        _top = _last;
+        _last = NO_BLOCK;
+    }
+}
+
+void* JsonArena::reallocate(void* ptr, size_t newSize) {
+    if (!ptr) return allocate(newSize);
+    if (!owns(ptr)) {
+        _heapBytes += newSize;
+        return realloc(ptr, newSize);
+    }
+    size_t oldSize = blockSize(ptr);
+    bool newest = _last != NO_BLOCK && ptr == _buffer + _last + HEADER;
+    if (newest && HEADER + roundUp(newSize) <= _size - _last) {
+        // Grow or shrink in place
+        uint32_t header = newSize;
+        memcpy(_buffer + _last, &header, sizeof(header));
+        _top = _last + HEADER + roundUp(newSize);
+        if (_top > _peak) _peak = _top;
+        return ptr;
+    }
+    if (newSize <= oldSize) return ptr; // An older block keeps its space until reset()
+    if (newest) {
+        // Out of room: move the block to the heap and give its space back
+        void* moved = malloc(newSize);
+        if (!moved) return nullptr;
+        _heapBytes += newSize;
+        memcpy(moved, ptr, oldSize);
+        _top = _last;
+        _last = NO_BLOCK;
+        return moved;
+    }
+    void* moved = allocate(newSize);
+    if (moved) memcpy(moved, ptr, oldSize);
+    return moved;
+}
@@ -0,0 +1,56 @@
+#ifndef JSON_ARENA_H
+#define JSON_ARENA_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// ArduinoJson allocator over a fixed buffer. Blocks are handed out bottom
+// up and only the newest can be freed or resized in place; everything else
+// is reclaimed at once by reset(). When the buffer is full it falls back to
+// the heap and counts the bytes, so an undersized arena still parses.
+class JsonArena : public ArduinoJson::Allocator {
+public:
+    static const size_t ALIGN = 8;
+
+    // A null buffer or zero size makes every allocation a heap one
+    JsonArena(uint8_t* buffer, size_t size);
+
+    void* allocate(size_t size) override;
+    void deallocate(void* ptr) override;
+    void* reallocate(void* ptr, size_t newSize) override;
+
+    // Forget every block. Only call once no document uses the arena.
+    void reset();
+
+    size_t capacity() const { return _size; }
+    size_t used() const { return _top; }
+    // Most of the buffer in use since reset()
+    size_t peak() const { return _peak; }
+    // Bytes asked of the heap since reset() because the buffer was full
+    size_t heapBytes() const { return _heapBytes; }
+
+private:
+    uint8_t* _buffer;
+    size_t _size;
+    size_t _top;
+    size_t _last; // Header offset of the newest block, or NO_BLOCK
+    size_t _peak;
+    size_t _heapBytes;
+
+    static const size_t NO_BLOCK = (size_t)-1;
+
+    bool owns(const void* ptr) const;
+    size_t blockSize(const void* ptr) const;
+};
+
+// An arena with its buffer reserved statically alongside it
+template <size_t N>
+class StaticJsonArena : public JsonArena {
+public:
+    StaticJsonArena() : JsonArena(_memory, N) {}
+
+private:
+    alignas(JsonArena::ALIGN) uint8_t _memory[N];
+};
+
+#endif
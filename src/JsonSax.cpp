@@ -0,0 +1,269 @@
+#include "JsonSax.h"
+
+JsonSaxParser::JsonSaxParser(const JsonSchema& schema, JsonSaxHandler& handler)
+    : _schema(schema),
+      _handler(handler),
+      _in(nullptr),
+      _error(nullptr),
+      _bytesParsed(0),
+      _pos(0),
+      _len(0) {}
+
+int JsonSaxParser::peekChar() {
+    if (_pos == _len) {
+        _len = _in->readBytes(_buffer, sizeof(_buffer));
+        _pos = 0;
+        if (_len == 0) return -1;
+    }
+    return (uint8_t)_buffer[_pos];
+}
+
+int JsonSaxParser::nextChar() {
+    int c = peekChar();
+    if (c >= 0) {
+        _pos++;
+        _bytesParsed++;
+    }
+    return c;
+}
+
+int JsonSaxParser::skipWhitespace() {
+    int c;
+    while ((c = peekChar()) == ' ' || c == '\n' || c == '\r' || c == '\t') _pos++, _bytesParsed++;
+    return c;
+}
+
+bool JsonSaxParser::fail(const char* error) {
+    if (!_error) _error = error;
+    return false;
+}
+
+bool JsonSaxParser::parse(Stream& in) {
+    _in = &in;
+    _error = nullptr;
+    _bytesParsed = 0;
+    _pos = _len = 0;
+    return parseValue(0, 0);
+}
+
+uint8_t JsonSaxParser::childNode(uint8_t node, const char* key, size_t length, uint32_t hash) const {
+    if (node == JSON_NODE_NONE) return JSON_NODE_NONE;
+    const JsonKeySlot& slot = _schema.keySlots[hash % _schema.keySlotCount];
+    if (slot.key == 0 || slot.hash != hash) return JSON_NODE_NONE;
+    const char* name = _schema.keyNames[slot.key];
+    if (strncmp(name, key, length) != 0 || name[length] != '\0') return JSON_NODE_NONE;
+    for (uint8_t i = 1; i < _schema.nodeCount; i++) {
+        if (_schema.nodes[i].parent == node && _schema.nodes[i].key == slot.key) return i;
+    }
+    return JSON_NODE_NONE;
+}
+
+bool JsonSaxParser::parseValue(uint8_t node, uint8_t depth) {
+    int c = skipWhitespace();
+    uint8_t field = node == JSON_NODE_NONE ? 0 : _schema.nodes[node].field;
+    switch (c) {
+        case '{': {
+            // The root object itself can be the record
+            bool record = depth == 0 && node != JSON_NODE_NONE && (_schema.nodes[node].flags & JSON_NODE_RECORDS);
+            if (record) _handler.beginRecord(field, 0);
+            if (!parseObject(node, depth)) return false;
+            if (record) _handler.endRecord(field, 0);
+            return true;
+        }
+        case '[':
+            return parseArray(node, depth);
+        case '"': {
+            nextChar();
+            size_t length;
+            uint32_t hash;
+            if (!field) return parseString(nullptr, 0, length, hash);
+            if (!parseString(_string, sizeof(_string), length, hash)) return false;
+            JsonSaxValue value;
+            value.type = JsonSaxValue::STRING;
+            value.str = _string;
+            value.length = min(length, sizeof(_string) - 1);
+            value.number = 0;
+            value.boolean = false;
+            _handler.value(field, value);
+            return true;
+        }
+        case 't':
+            return parseLiteral("true", field, JsonSaxValue::BOOLEAN, true);
+        case 'f':
+            return parseLiteral("false", field, JsonSaxValue::BOOLEAN, false);
+        case 'n':
+            return parseLiteral("null", field, JsonSaxValue::NUL, false);
+        case -1:
+            return fail("unexpected end of input");
+        default:
+            if (c == '-' || (c >= '0' && c <= '9')) return parseNumber(field);
+            return fail("unexpected character");
+    }
+}
+
+bool JsonSaxParser::parseObject(uint8_t node, uint8_t depth) {
+    if (depth >= MAX_DEPTH) return fail("nesting too deep");
+    nextChar(); // '{'
+    if (skipWhitespace() == '}') {
+        nextChar();
+        return true;
+    }
+    char key[32];
+    while (true) {
+        if (skipWhitespace() != '"') return fail("expected a key");
+        nextChar();
+        size_t length;
+        uint32_t hash;
+        if (!parseString(key, sizeof(key), length, hash)) return false;
+        uint8_t child = length < sizeof(key) ? childNode(node, key, length, hash) : JSON_NODE_NONE;
+        if (skipWhitespace() != ':') return fail("expected ':'");
+        nextChar();
+        if (!parseValue(child, depth + 1)) return false;
+        int c = skipWhitespace();
+        nextChar();
+        if (c == '}') return true;
+        if (c != ',') return fail(c < 0 ? "unexpected end of input" : "expected ',' or '}'");
+    }
+}
+
+bool JsonSaxParser::parseArray(uint8_t node, uint8_t depth) {
+    if (depth >= MAX_DEPTH) return fail("nesting too deep");
+    nextChar(); // '['
+    if (skipWhitespace() == ']') {
+        nextChar();
+        return true;
+    }
+    // Elements belong to the array's node; records are reported one by one
+    bool records = node != JSON_NODE_NONE && (_schema.nodes[node].flags & JSON_NODE_RECORDS);
+    uint8_t field = records ? _schema.nodes[node].field : 0;
+    for (uint16_t index = 0;; index++) {
+        if (records) _handler.beginRecord(field, index);
+        if (!parseValue(records ? node : JSON_NODE_NONE, depth + 1)) return false;
+        if (records) _handler.endRecord(field, index);
+        int c = skipWhitespace();
+        nextChar();
+        if (c == ']') return true;
+        if (c != ',') return fail(c < 0 ? "unexpected end of input" : "expected ',' or ']'");
+    }
+}
+
+// Reads the rest of a string (the opening quote is consumed), decoding
+// escapes into out. length is the full decoded length even when out (or a
+// zero capacity) holds less; hash is its FNV-1a.
+bool JsonSaxParser::parseString(char* out, size_t capacity, size_t& length, uint32_t& hash) {
+    length = 0;
+    hash = 2166136261u;
+    uint32_t pendingHigh = 0; // UTF-16 high surrogate waiting for its pair
+    while (true) {
+        int c = nextChar();
+        if (c < 0) return fail("unterminated string");
+        if (c == '"') break;
+        if (c != '\\') {
+            uint8_t byte = (uint8_t)c;
+            if (length + 1 < capacity) out[length] = byte;
+            length++;
+            hash = (hash ^ byte) * 16777619u;
+            continue;
+        }
+        uint32_t codepoint;
+        c = nextChar();
+        switch (c) {
+            case '"': case '\\': case '/': codepoint = c; break;
+            case 'b': codepoint = '\b'; break;
+            case 'f': codepoint = '\f'; break;
+            case 'n': codepoint = '\n'; break;
+            case 'r': codepoint = '\r'; break;
+            case 't': codepoint = '\t'; break;
+            case 'u': {
+                codepoint = 0;
+                for (int i = 0; i < 4; i++) {
+                    int h = nextChar();
+                    int v;
+                    if (h >= '0' && h <= '9') v = h - '0';
+                    else if (h >= 'a' && h <= 'f') v = h - 'a' + 10;
+                    else if (h >= 'A' && h <= 'F') v = h - 'A' + 10;
+                    else return fail("bad \\u escape");
+                    codepoint = codepoint * 16 + v;
+                }
+                if (codepoint >= 0xD800 && codepoint < 0xDC00) {
+                    pendingHigh = codepoint;
+                    continue;
+                }
+                if (codepoint >= 0xDC00 && codepoint < 0xE000 && pendingHigh) {
+                    codepoint = 0x10000 + ((pendingHigh - 0xD800) << 10) + (codepoint - 0xDC00);
+                }
+                break;
+            }
+            default:
+                return fail(c < 0 ? "unterminated string" : "bad escape");
+        }
+        pendingHigh = 0;
+        // Encode as UTF-8
+        uint8_t bytes[4];
+        size_t count;
+        if (codepoint < 0x80) {
+            bytes[0] = codepoint;
+            count = 1;
+        } else if (codepoint < 0x800) {
+            bytes[0] = 0xC0 | (codepoint >> 6);
+            bytes[1] = 0x80 | (codepoint & 0x3F);
+            count = 2;
+        } else if (codepoint < 0x10000) {
+            bytes[0] = 0xE0 | (codepoint >> 12);
+            bytes[1] = 0x80 | ((codepoint >> 6) & 0x3F);
+            bytes[2] = 0x80 | (codepoint & 0x3F);
+            count = 3;
+        } else {
+            bytes[0] = 0xF0 | (codepoint >> 18);
+            bytes[1] = 0x80 | ((codepoint >> 12) & 0x3F);
+            bytes[2] = 0x80 | ((codepoint >> 6) & 0x3F);
+            bytes[3] = 0x80 | (codepoint & 0x3F);
+            count = 4;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (length + 1 < capacity) out[length] = bytes[i];
+            length++;
+            hash = (hash ^ bytes[i]) * 16777619u;
+        }
+    }
+    if (capacity > 0) out[min(length, capacity - 1)] = '\0';
+    return true;
+}
+
+bool JsonSaxParser::parseNumber(uint8_t field) {
+    char text[32];
+    size_t length = 0;
+    int c;
+    while ((c = peekChar()) == '-' || c == '+' || c == '.' || c == 'e' || c == 'E' || (c >= '0' && c <= '9')) {
+        if (length + 1 < sizeof(text)) text[length++] = c;
+        nextChar();
+    }
+    if (!field) return true;
+    text[length] = '\0';
+    char* end;
+    double number = strtod(text, &end);
+    if (end == text) return fail("bad number");
+    JsonSaxValue value;
+    value.type = JsonSaxValue::NUMBER;
+    value.str = text;
+    value.length = length;
+    value.number = number;
+    value.boolean = false;
+    _handler.value(field, value);
+    return true;
+}
+
+bool JsonSaxParser::parseLiteral(const char* rest, uint8_t field, JsonSaxValue::Type type, bool boolean) {
+    for (; *rest; rest++) {
+        if (nextChar() != *rest) return fail("bad literal");
+    }
+    if (!field) return true;
+    JsonSaxValue value;
+    value.type = type;
+    value.str = "";
+    value.length = 0;
+    value.number = 0;
+    value.boolean = boolean;
+    _handler.value(field, value);
+    return true;
+}
@@ -0,0 +1,98 @@
+#ifndef JSON_SAX_H
+#define JSON_SAX_H
+
+#include <Arduino.h>
+
+// Streaming (SAX-style) JSON reader driven by a schema of the paths of
+// interest (see generate_json_schema.py). It walks the document once as it
+// arrives, builds no tree and allocates nothing: values on a schema path are
+// handed to a JsonSaxHandler as they are read, everything else is skipped.
+
+#define JSON_NODE_NONE 0xFF
+#define JSON_NODE_RECORDS 0x01 // Each array element (or the root object) is a record
+
+struct JsonKeySlot {
+    uint32_t hash;
+    uint8_t key;
+};
+
+struct JsonSchemaNode {
+    uint8_t parent;
+    uint8_t key;
+    uint8_t field; // Reported for scalar values and records, 0 for none
+    uint8_t flags;
+};
+
+struct JsonSchema {
+    const JsonSchemaNode* nodes;
+    uint8_t nodeCount;
+    const JsonKeySlot* keySlots;
+    uint16_t keySlotCount;
+    const char* const* keyNames;
+};
+
+struct JsonSaxValue {
+    enum Type : uint8_t { STRING, NUMBER, BOOLEAN, NUL };
+
+    Type type;
+    const char* str;  // STRING: NUL-terminated, truncated to STRING_BYTES - 1
+    size_t length;
+    double number;
+    bool boolean;
+
+    // Missing or mistyped values read as 0 / "", as ArduinoJson's do
+    float asFloat() const { return type == NUMBER ? (float)number : 0.0f; }
+    int asInt() const { return type == NUMBER ? (int)number : 0; }
+    const char* asString() const { return type == STRING ? str : ""; }
+};
+
+class JsonSaxHandler {
+public:
+    virtual ~JsonSaxHandler() {}
+    // Around each element of a record array (index counts from 0), or the
+    // whole document when the root is the record
+    virtual void beginRecord(uint8_t /*field*/, uint16_t /*index*/) {}
+    virtual void endRecord(uint8_t /*field*/, uint16_t /*index*/) {}
+    virtual void value(uint8_t field, const JsonSaxValue& value) = 0;
+};
+
+class JsonSaxParser {
+public:
+    static const uint8_t MAX_DEPTH = 16;
+    static const size_t STRING_BYTES = 96;
+
+    JsonSaxParser(const JsonSchema& schema, JsonSaxHandler& handler);
+
+    // Reads one JSON value from the stream. False on a syntax error or
+    // truncated input (see error()); the handler may have seen part of it.
+    bool parse(Stream& in);
+
+    const char* error() const { return _error; }
+    size_t bytesParsed() const { return _bytesParsed; }
+
+private:
+    const JsonSchema& _schema;
+    JsonSaxHandler& _handler;
+    Stream* _in;
+    const char* _error;
+    size_t _bytesParsed;
+    char _buffer[128];
+    size_t _pos;
+    size_t _len;
+    char _string[STRING_BYTES];
+
+    int peekChar();
+    int nextChar();
+    int skipWhitespace();
+    bool fail(const char* error);
+
+    bool parseValue(uint8_t node, uint8_t depth);
+    bool parseObject(uint8_t node, uint8_t depth);
+    bool parseArray(uint8_t node, uint8_t depth);
+    bool parseString(char* out, size_t capacity, size_t& length, uint32_t& hash);
+    bool parseNumber(uint8_t field);
+    bool parseLiteral(const char* rest, uint8_t field, JsonSaxValue::Type type, bool boolean);
+    uint8_t childNode(uint8_t node, const char* key, size_t length, uint32_t hash) const;
+};
+
+#endif
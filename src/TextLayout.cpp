@@ -0,0 +1,154 @@
+#include "TextLayout.h"
+
+TextLayout::TextLayout() {
+    clear();
+}
+
+void TextLayout::clear() {
+    _used = 0;
+    _runCount = 0;
+    _blockCount = 0;
+    _nextBlock = 0;
+    _replaying = false;
+    _overflow = false;
+    setBand(INT16_MIN, INT16_MAX);
+}
+
+void TextLayout::rewind() {
+    _nextBlock = 0;
+    _replaying = true;
+}
+
+void TextLayout::setBand(int16_t top, int16_t bottom) {
+    _bandTop = top;
+    _bandBottom = bottom;
+}
+
+bool TextLayout::beginRun(const GFXfont* font, uint16_t color, int16_t x, int16_t y) {
+    if (_runCount >= MAX_RUNS) return false;
+    Run& run = _runs[_runCount++];
+    run.font = font;
+    run.color = color;
+    run.x = x;
+    run.y = y;
+    run.offset = _used;
+    run.length = 0;
+    return true;
+}
+
+bool TextLayout::append(const char* s, uint16_t len) {
+    Run& run = _runs[_runCount - 1];
+    if (_used + len > ARENA_BYTES || run.length + len > 255) return false;
+    memcpy(_text + _used, s, len);
+    _used += len;
+    run.length += len;
+    return true;
+}
+
+void TextLayout::measure(Run& run) const {
+    // Inked bounds from the glyph table, following Adafruit_GFX's cursor
+    // advance; runs with no ink end up with top > bottom and are never drawn
+    run.left = INT16_MAX;
+    run.right = INT16_MIN;
+    run.top = INT16_MAX;
+    run.bottom = INT16_MIN;
+    int16_t cursorX = run.x;
+    for (uint8_t i = 0; i < run.length; i++) {
+        uint8_t c = _text[run.offset + i];
+        if (!run.font) {
+            // Classic 6x8 font
+            run.left = min(run.left, cursorX);
+            run.right = max<int16_t>(run.right, cursorX + 5);
+            run.top = min(run.top, run.y);
+            run.bottom = max<int16_t>(run.bottom, run.y + 7);
+            cursorX += 6;
+            continue;
+        }
+        uint8_t first = pgm_read_byte(&run.font->first);
+        if (c < first || c > (uint8_t)pgm_read_byte(&run.font->last)) continue;
+        const GFXglyph* glyph = run.font->glyph + (c - first);
+        uint8_t w = pgm_read_byte(&glyph->width);
+        uint8_t h = pgm_read_byte(&glyph->height);
+        if (w > 0 && h > 0) {
+            int16_t xo = (int8_t)pgm_read_byte(&glyph->xOffset);
+            int16_t yo = (int8_t)pgm_read_byte(&glyph->yOffset);
+            run.left = min<int16_t>(run.left, cursorX + xo);
+            run.right = max<int16_t>(run.right, cursorX + xo + w - 1);
+            run.top = min<int16_t>(run.top, run.y + yo);
+            run.bottom = max<int16_t>(run.bottom, run.y + yo + h - 1);
+        }
+        cursorX += (uint8_t)pgm_read_byte(&glyph->xAdvance);
+    }
+}
+
+int8_t TextLayout::layout(int16_t x, int16_t y, const GFXfont* font, uint16_t color, const char* text, int maxCharsPerLine) {
+    if (_replaying) {
+        // Same scene, same call order: hand back the stored block
+        return _nextBlock < _blockCount ? _nextBlock++ : -1;
+    }
+    if (_overflow || _blockCount >= MAX_BLOCKS || !text) {
+        _overflow = true;
+        return -1;
+    }
+
+    uint8_t firstRun = _runCount;
+    uint16_t used = _used;
+    int16_t yAdvance = font ? pgm_read_byte(&font->yAdvance) : 8;
+    int16_t lineY = y;
+    bool ok = beginRun(font, color, x, lineY);
+
+    int currentLineLen = 0;
+    const char* start = text;
+    while (ok) {
+        const char* end = strchr(start, ' ');
+        uint16_t len = end ? end - start : strlen(start);
+        if (!end && len == 0) break;
+
+        // Wrap only if it's not the first word on the line
+        if (currentLineLen + len > maxCharsPerLine && currentLineLen > 0) {
+            lineY += yAdvance;
+            ok = beginRun(font, color, 0, lineY);
+            currentLineLen = 0;
+        } else if (currentLineLen > 0) {
+            ok = append(" ", 1);
+            currentLineLen++;
+        }
+        ok = ok && append(start, len);
+        currentLineLen += len;
+
+        if (!end) break;
+        start = end + 1;
+    }
+
+    if (!ok) {
+        _runCount = firstRun;
+        _used = used;
+        _overflow = true;
+        return -1;
+    }
+
+    for (uint8_t i = firstRun; i < _runCount; i++) {
+        measure(_runs[i]);
+    }
+    Block& block = _blocks[_blockCount];
+    block.firstRun = firstRun;
+    block.runCount = _runCount - firstRun;
+    return _blockCount++;
+}
+
+void TextLayout::draw(int8_t block, Adafruit_GFX& gfx) const {
+    if (block < 0 || block >= _blockCount) return;
+    const Block& b = _blocks[block];
+    for (uint8_t i = 0; i < b.runCount; i++) {
+        const Run& run = _runs[b.firstRun + i];
+        // Cursor and font are set even for skipped runs so the target's
+        // text state matches a full draw
+        gfx.setFont(run.font);
+        gfx.setTextColor(run.color);
+        gfx.setCursor(run.x, run.y);
+        if (run.bottom < _bandTop || run.top > _bandBottom) continue;
+        for (uint8_t c = 0; c < run.length; c++) {
+            gfx.write((uint8_t)_text[run.offset + c]);
+        }
+    }
+}
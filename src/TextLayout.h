@@ -0,0 +1,68 @@
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+// Word wraps and measures text once per frame into a fixed arena of
+// positioned line runs. Each RenderText call becomes one block of runs;
+// when the scene is drawn again for another page the blocks are reused in
+// call order and only runs overlapping the current band are emitted.
+class TextLayout {
+public:
+    static const uint16_t ARENA_BYTES = 768;
+    static const uint8_t MAX_RUNS = 48;
+    static const uint8_t MAX_BLOCKS = 32;
+
+    struct Run {
+        const GFXfont* font;
+        uint16_t color;
+        int16_t x, y;                       // Cursor at the start of the line
+        int16_t left, top, right, bottom;   // Inked bounds
+        uint16_t offset;                    // Text in the arena
+        uint8_t length;
+    };
+
+    TextLayout();
+
+    // Forget the previous frame's layout
+    void clear();
+    // Draw the same frame again: layout() hands back stored blocks in order
+    void rewind();
+    // Rows the next draw() calls cover (defaults to everything)
+    void setBand(int16_t top, int16_t bottom);
+
+    // Wrap text to maxCharsPerLine at spaces, in the same way as printing
+    // word by word with println() (so wrapped lines start at x = 0). Returns
+    // the block index, or -1 if the arena is full.
+    int8_t layout(int16_t x, int16_t y, const GFXfont* font, uint16_t color, const char* text, int maxCharsPerLine);
+    void draw(int8_t block, Adafruit_GFX& gfx) const;
+
+    uint8_t runCount() const { return _runCount; }
+    uint16_t bytesUsed() const { return _used; }
+    bool overflowed() const { return _overflow; }
+
+private:
+    struct Block {
+        uint8_t firstRun;
+        uint8_t runCount;
+    };
+
+    char _text[ARENA_BYTES];
+    Run _runs[MAX_RUNS];
+    Block _blocks[MAX_BLOCKS];
+    uint16_t _used;
+    uint8_t _runCount;
+    uint8_t _blockCount;
+    uint8_t _nextBlock;
+    bool _replaying;
+    bool _overflow;
+    int16_t _bandTop;
+    int16_t _bandBottom;
+
+    bool beginRun(const GFXfont* font, uint16_t color, int16_t x, int16_t y);
+    bool append(const char* s, uint16_t len);
+    void measure(Run& run) const;
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include "TimeUtil.h"
+
+void civilFromDays(int32_t days, int32_t& y, uint8_t& m, uint8_t& d) {
+    days += 719468;
+    const int32_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const uint32_t doe = (uint32_t)(days - era * 146097);                  // [0, 146096]
+    const uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365; // [0, 399]
+    const uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);          // [0, 365]
+    const uint32_t mp = (5 * doy + 2) / 153;                               // [0, 11]
+    d = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);
+    m = (uint8_t)(mp < 10 ? mp + 3 : mp - 9);
+    y = (int32_t)yoe + era * 400 + (m <= 2);
+}
+
+// Reads exactly `digits` decimal digits
+static bool readDigits(const char*& s, uint8_t digits, int& value) {
+    value = 0;
+    for (uint8_t i = 0; i < digits; i++) {
+        if (s[i] < '0' || s[i] > '9') return false;
+        value = value * 10 + (s[i] - '0');
+    }
+    s += digits;
+    return true;
+}
+
+bool parseIso8601(const char* s, IsoTime& out) {
+    if (!s) return false;
+    int year, month, day, hour, minute, second = 0;
+    if (!readDigits(s, 4, year) || *s++ != '-' ||
+        !readDigits(s, 2, month) || *s++ != '-' ||
+        !readDigits(s, 2, day)) {
+        return false;
+    }
+    if (*s != 'T' && *s != ' ') return false;
+    s++;
+    if (!readDigits(s, 2, hour) || *s++ != ':' || !readDigits(s, 2, minute)) return false;
+    if (*s == ':') {
+        s++;
+        if (!readDigits(s, 2, second)) return false;
+        if (*s == '.') {
+            s++;
+            while (*s >= '0' && *s <= '9') s++;
+        }
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) return false;
+    out.year = year;
+    out.month = month;
+    out.day = day;
+    out.hour = hour;
+    out.minute = minute;
+    out.second = second;
+    out.utc = *s == 'Z';
+    return true;
+}
+
+int32_t LocalTimeTable::sampleOffset(time_t t, bool& dst) {
+    struct tm local;
+    localtime_r(&t, &local);
+    dst = local.tm_isdst > 0;
+    int64_t localSeconds = (int64_t)daysFromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday) * 86400 +
+                           local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec;
+    return (int32_t)(localSeconds - t);
+}
+
+void LocalTimeTable::build(time_t now, int16_t daysBefore, int16_t daysAfter) {
+    // Offsets change at most a couple of times a year, so sampling every six
+    // hours cannot step over a change and back; each change found is then
+    // narrowed to the second by bisection
+    const time_t step = 6 * 3600;
+    const time_t from = now - (time_t)daysBefore * 86400;
+    const time_t to = now + (time_t)daysAfter * 86400;
+
+    _count = 0;
+    Span& first = _spans[_count++];
+    first.start = from;
+    first.offset = sampleOffset(from, first.dst);
+
+    for (time_t t = from + step; t < to + step && _count < MAX_SPANS; t += step) {
+        bool dst;
+        int32_t offset = sampleOffset(t, dst);
+        if (offset == _spans[_count - 1].offset) continue;
+        time_t lo = t - step, hi = t; // Old offset at lo, new one at hi
+        while (hi - lo > 1) {
+            time_t mid = lo + (hi - lo) / 2;
+            bool midDst;
+            if (sampleOffset(mid, midDst) == _spans[_count - 1].offset) lo = mid;
+            else hi = mid;
+        }
+        Span& span = _spans[_count++];
+        span.start = hi;
+        span.offset = offset;
+        span.dst = dst;
+    }
+}
+
+const LocalTimeTable::Span& LocalTimeTable::spanAt(time_t t) const {
+    uint8_t i = 0;
+    while (i + 1 < _count && _spans[i + 1].start <= t) i++;
+    return _spans[i];
+}
+
+int32_t LocalTimeTable::offsetAt(time_t t) const {
+    return _count > 0 ? spanAt(t).offset : 0;
+}
+
+void LocalTimeTable::toLocal(time_t t, struct tm& local) const {
+    if (_count == 0) {
+        localtime_r(&t, &local);
+        return;
+    }
+    const Span& span = spanAt(t);
+    int64_t seconds = (int64_t)t + span.offset;
+    int32_t days = (int32_t)(seconds / 86400);
+    int32_t secondOfDay = (int32_t)(seconds % 86400);
+    if (secondOfDay < 0) {
+        secondOfDay += 86400;
+        days--;
+    }
+    int32_t y;
+    uint8_t m, d;
+    civilFromDays(days, y, m, d);
+
+    local.tm_year = y - 1900;
+    local.tm_mon = m - 1;
+    local.tm_mday = d;
+    local.tm_hour = secondOfDay / 3600;
+    local.tm_min = secondOfDay / 60 % 60;
+    local.tm_sec = secondOfDay % 60;
+    local.tm_wday = (int)(((days % 7) + 11) % 7); // 1970-01-01 was a Thursday
+    local.tm_yday = days - daysFromCivil(y, 1, 1);
+    local.tm_isdst = span.dst;
+}
@@ -0,0 +1,71 @@
+#ifndef TIME_UTIL_H
+#define TIME_UTIL_H
+
+#include <Arduino.h>
+#include <time.h>
+
+// Days since 1970-01-01 for a proleptic Gregorian date (month 1-12).
+// Howard Hinnant's days_from_civil, in integer arithmetic only.
+inline int32_t daysFromCivil(int32_t y, uint32_t m, uint32_t d) {
+    y -= m <= 2;
+    const int32_t era = (y >= 0 ? y : y - 399) / 400;
+    const uint32_t yoe = (uint32_t)(y - era * 400);                    // [0, 399]
+    const uint32_t doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1; // [0, 365]
+    const uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;        // [0, 146096]
+    return era * 146097 + (int32_t)doe - 719468;
+}
+
+// Inverse of daysFromCivil
+void civilFromDays(int32_t days, int32_t& y, uint8_t& m, uint8_t& d);
+
+// Fields of an ISO-8601 timestamp such as "2026-01-03T17:00:00Z"
+struct IsoTime {
+    int16_t year;
+    uint8_t month, day, hour, minute, second;
+    bool utc; // Ended in 'Z'
+};
+
+// Integer parse of "YYYY-MM-DDTHH:MM[:SS[.fraction]][Z]"; fractions are dropped
+bool parseIso8601(const char* s, IsoTime& out);
+
+// Seconds since the epoch, reading the fields as UTC
+inline time_t isoToEpoch(const IsoTime& t) {
+    return (time_t)daysFromCivil(t.year, t.month, t.day) * 86400 + t.hour * 3600 + t.minute * 60 + t.second;
+}
+
+// UTC offsets of the current TZ rules around one moment, sampled once with
+// localtime_r (so any POSIX TZ string works, DST changes included). After
+// build(), converting a timestamp to local time is a table lookup plus
+// integer arithmetic, with no TZ swapping.
+class LocalTimeTable {
+public:
+    static const uint8_t MAX_SPANS = 8;
+
+    LocalTimeTable() : _count(0) {}
+
+    // Cover [now - daysBefore, now + daysAfter]; outside it the nearest
+    // span's offset is used
+    void build(time_t now, int16_t daysBefore = 2, int16_t daysAfter = 7);
+    bool built() const { return _count > 0; }
+
+    int32_t offsetAt(time_t t) const;
+    // Like localtime_r; falls back to it until build() has run
+    void toLocal(time_t t, struct tm& local) const;
+
+    uint8_t spanCount() const { return _count; }
+
+private:
+    struct Span {
+        time_t start;   // First second the offset applies
+        int32_t offset; // Local minus UTC, in seconds
+        bool dst;
+    };
+
+    Span _spans[MAX_SPANS];
+    uint8_t _count;
+
+    const Span& spanAt(time_t t) const;
+    static int32_t sampleOffset(time_t t, bool& dst);
+};
+
+#endif
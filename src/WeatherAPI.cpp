@@ -2,14 +2,22 @@
 #include <WiFi.h>
 #include <HTTPClient.h>
 #include <WiFiClientSecure.h>
+#include "TimeUtil.h"
+#include "WeatherJsonSchema.h"
+#include "JsonArena.h"
+#include "FetchScheduler.h"
 #include "secrets.h"
 
+WeatherData currentWeather;
+DailyForecast dailyForecasts[5];
+HourlyData hourlyData[24];
+LocalTimeTable localTimes;
+
 void getMockForecastData() {
   // Mock 3-day forecast
-  // struct DailyForecast { String dayName; String iconName; String conditionText; float tempHigh; float tempLow; String sunrise; String sunset; float sunriseHour; float sunsetHour; };
-  dailyForecasts[0] = DailyForecast{"Tomorrow", "partly_cloudy", "Partly Cloudy", 22.5, 14.0, "06:30", "20:15", 6.5, 20.25};
-  dailyForecasts[1] = DailyForecast{"Wednesday", "rain", "Rain", 18.0, 12.5, "06:31", "20:14", 6.52, 20.23};
-  dailyForecasts[2] = DailyForecast{"Thursday", "sunny", "Sunny", 25.0, 15.0, "06:32", "20:13", 6.53, 20.22};
+  dailyForecasts[0] = DailyForecast{2, ICON_PARTLY_CLOUDY, "Partly Cloudy", 22.5, 14.0, 6 * 60 + 30, 20 * 60 + 15};
+  dailyForecasts[1] = DailyForecast{3, ICON_RAIN, "Rain", 18.0, 12.5, 6 * 60 + 31, 20 * 60 + 14};
+  dailyForecasts[2] = DailyForecast{4, ICON_SUNNY, "Sunny", 25.0, 15.0, 6 * 60 + 32, 20 * 60 + 13};
 
   // Mock 24-hour data
   for (int i = 0; i < 24; i++) {
@@ -23,16 +31,29 @@ void getMockForecastData() {
   }
 }
 
-// e.g. "https://maps.gstatic.com/weather/v1/partly_clear.png" -> "partly_clear"
-String getIconNameFromUri(String uri) {
-  int lastSlash = uri.lastIndexOf('/');
-  int dot = uri.lastIndexOf('.');
-  if (lastSlash != -1 && dot != -1 && dot > lastSlash) {
-    return uri.substring(lastSlash + 1, dot);
-  }
+// e.g. "https://maps.gstatic.com/weather/v1/partly_clear.png" -> ICON_PARTLY_CLEAR
+static WeatherIconId iconIdFromUri(const char* uri) {
+  if (!uri) return ICON_UNKNOWN;
+  const char* name = uri;
+  const char* end = uri + strlen(uri);
+  const char* lastSlash = strrchr(uri, '/');
+  if (lastSlash) name = lastSlash + 1;
   // If no extension, maybe it's just the name
-  if (lastSlash != -1) return uri.substring(lastSlash + 1);
-  return uri;
+  const char* dot = strrchr(name, '.');
+  if (dot) end = dot;
+  return weatherIconId(name, end - name);
+}
+
+// Falls back to the condition type (e.g. "LIGHT_RAIN") when the icon name is unknown.
+WeatherIconId getIconIdFromUri(const char* uri, const char* conditionType) {
+  WeatherIconId id = iconIdFromUri(uri);
+  if (id == ICON_UNKNOWN && conditionType) {
+    id = weatherIconId(conditionType);
+  }
+  if (id == ICON_UNKNOWN) {
+    Serial.printf("Unknown weather icon: %s (%s)\n", uri ? uri : "null", conditionType ? conditionType : "null");
+  }
+  return id;
 }
 
 String getAPIData(String url) {
@@ -64,522 +85,606 @@ String getAPIData(String url) {
   return "";
 }
 
-void updateCurrentWeather(JsonObject hourly) {
-  currentWeather.conditionText = hourly["weatherCondition"]["description"]["text"].as<String>();
-  String uri = hourly["weatherCondition"]["iconBaseUri"].as<String>();
-  currentWeather.iconName = getIconNameFromUri(uri);
+void updateCurrentWeather(JsonObject hourly, WeatherData& weather) {
+  strlcpy(weather.conditionText, hourly["weatherCondition"]["description"]["text"] | "", sizeof(weather.conditionText));
+  weather.iconId = getIconIdFromUri(hourly["weatherCondition"]["iconBaseUri"].as<const char*>(), hourly["weatherCondition"]["type"].as<const char*>());
   
-  currentWeather.temp = hourly["temperature"]["degrees"];
-  currentWeather.feelsLike = hourly["feelsLikeTemperature"]["degrees"];
-  currentWeather.windSpeed = hourly["wind"]["speed"]["value"];
-  currentWeather.windGust = hourly["wind"]["gust"]["value"];
-  currentWeather.windDirection = hourly["wind"]["direction"]["degrees"];
+  weather.temp = hourly["temperature"]["degrees"];
+  weather.feelsLike = hourly["feelsLikeTemperature"]["degrees"];
+  weather.windSpeed = hourly["wind"]["speed"]["value"];
+  weather.windGust = hourly["wind"]["gust"]["value"];
+  weather.windDirection = hourly["wind"]["direction"]["degrees"];
   
-  currentWeather.humidity = hourly["relativeHumidity"];
-  currentWeather.precipitationProbability = hourly["precipitation"]["probability"]["percent"];
+  weather.humidity = hourly["relativeHumidity"];
+  weather.precipitationProbability = hourly["precipitation"]["probability"]["percent"];
   
-  currentWeather.uvIndex = hourly["uvIndex"];
-  currentWeather.pressure = hourly["airPressure"]["meanSeaLevelMillibars"];
-  
-  currentWeather.valid = true;
+  weather.uvIndex = hourly["uvIndex"];
+  weather.pressure = hourly["airPressure"]["meanSeaLevelMillibars"];
   
+  weather.valid = true;
+  logCurrentWeather(weather);
+}
+
+void logCurrentWeather(const WeatherData& weather) {
   Serial.println("--- Parsed Weather Data ---");
-  Serial.println("Condition: " + currentWeather.conditionText);
-  Serial.println("Icon Name: " + currentWeather.iconName);
-  Serial.println("Temp: " + String(currentWeather.temp));
-  Serial.println("Feels Like: " + String(currentWeather.feelsLike));
-  Serial.println("Wind: " + String(currentWeather.windSpeed) + " km/h, Dir: " + String(currentWeather.windDirection));
-  Serial.println("Humidity: " + String(currentWeather.humidity) + "%");
-  Serial.println("Rain Prob: " + String(currentWeather.precipitationProbability) + "%");
-  Serial.println("UV: " + String(currentWeather.uvIndex));
-  Serial.println("Pressure: " + String(currentWeather.pressure));
+  Serial.printf("Condition: %s\n", weather.conditionText);
+  Serial.println("Icon Name: " + String(weatherIconName(weather.iconId)));
+  Serial.println("Temp: " + String(weather.temp));
+  Serial.println("Feels Like: " + String(weather.feelsLike));
+  Serial.println("Wind: " + String(weather.windSpeed) + " km/h, Dir: " + String(weather.windDirection));
+  Serial.println("Humidity: " + String(weather.humidity) + "%");
+  Serial.println("Rain Prob: " + String(weather.precipitationProbability) + "%");
+  Serial.println("UV: " + String(weather.uvIndex));
+  Serial.println("Pressure: " + String(weather.pressure));
 }
 
-String getDayName(int year, int month, int day) {
-    // Zeller's congruence
-    if (month < 3) {
-        month += 12;
-        year -= 1;
+// "YYYY-MM-DDTHH:MM:SSZ" (UTC) as local minutes after midnight; time is
+// left alone when the string does not parse
+static void parseTimeOfDay(const char* tStr, TimeOfDay& time) {
+  IsoTime iso;
+  if (parseIso8601(tStr, iso)) {
+    int h = iso.hour;
+    int m = iso.minute;
+    if (iso.utc) {
+      struct tm loc;
+      localTimes.toLocal(isoToEpoch(iso), loc);
+      h = loc.tm_hour;
+      m = loc.tm_min;
     }
-    int k = year % 100;
-    int j = year / 100;
-    int h = (day + 13 * (month + 1) / 5 + k + k / 4 + j / 4 + 5 * j) % 7;
-    
-    String days[] = {"Saturday", "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday"};
-    return days[h];
+    time = h * 60 + m;
+  }
 }
 
-bool getDailyForecastData() {
-  if (WiFi.status() == WL_CONNECTED) {
-    String url = "https://weather.googleapis.com/v1/forecast/days:lookup?key=" + String(GOOGLE_API_KEY) 
-      + "&location.latitude=" + String(LATITUDE) 
-      + "&location.longitude=" + String(LONGITUDE) 
-      + "&days=5"
-      + "&unitsSystem=METRIC";
-    
-    Serial.println("Requesting URL: " + url);
+// Day of the month now, to keep only today's hours; -1 when the clock is
+// not set, as the hours could not be placed on the right day
+static int todayOfMonth(const char* purpose) {
+  struct tm timeinfo = {};
+  if(!getLocalTime(&timeinfo, 1000)){
+      Serial.printf("Failed to obtain time for %s filtering\n", purpose);
+      return -1;
+  }
+  return timeinfo.tm_mday;
+}
 
-    WiFiClientSecure client;
-    client.setInsecure();
-    client.setTimeout(10000); // 10s timeout
-    HTTPClient http;
-    http.begin(client, url);
-    http.setTimeout(10000);
-    int httpResponseCode = http.GET();
-    
-    if (httpResponseCode > 0) {
-      String payload = http.getString();
-      Serial.println("HTTP Response code: " + String(httpResponseCode));
-      
-      JsonDocument filter;
-      filter["forecastDays"][0]["displayDate"] = true;
-      filter["forecastDays"][0]["maxTemperature"]["degrees"] = true;
-      filter["forecastDays"][0]["minTemperature"]["degrees"] = true;
-      filter["forecastDays"][0]["daytimeForecast"]["weatherCondition"]["description"]["text"] = true;
-      filter["forecastDays"][0]["daytimeForecast"]["weatherCondition"]["iconBaseUri"] = true;
-      filter["forecastDays"][0]["sunEvents"]["sunriseTime"] = true;
-      filter["forecastDays"][0]["sunEvents"]["sunsetTime"] = true;
-
-      JsonDocument doc;
-      DeserializationError error = deserializeJson(doc, payload, DeserializationOption::Filter(filter));
-
-      if (error) {
-        Serial.print("deserializeJson() failed: ");
-        Serial.println(error.c_str());
-        http.end();
-        return false;
-      } else {
-        JsonArray forecasts = doc["forecastDays"];
-        for(int i=0; i<5 && i<forecasts.size(); i++) {
-            JsonObject f = forecasts[i];
-            int y = f["displayDate"]["year"];
-            int m = f["displayDate"]["month"];
-            int d = f["displayDate"]["day"];
-            
-            dailyForecasts[i].dayName = getDayName(y, m, d);
-            dailyForecasts[i].tempHigh = f["maxTemperature"]["degrees"];
-            dailyForecasts[i].tempLow = f["minTemperature"]["degrees"];
-            dailyForecasts[i].conditionText = f["daytimeForecast"]["weatherCondition"]["description"]["text"].as<String>();
-            
-            String uri = f["daytimeForecast"]["weatherCondition"]["iconBaseUri"].as<String>();
-            dailyForecasts[i].iconName = getIconNameFromUri(uri);
-            
-            // Parse Sunrise/Sunset
-            String rise = f["sunEvents"]["sunriseTime"].as<String>();
-            String set = f["sunEvents"]["sunsetTime"].as<String>();
-            
-            //Serial.printf("Day %d Raw Sunrise: %s, Sunset: %s\n", i, rise.c_str(), set.c_str());
-
-            // Helper to parse "YYYY-MM-DDTHH:MM:SSZ"
-            auto parseTime = [](String tStr, float &hourVal, String &dispStr) {
-                int Y, M, D, h, m, s;
-                if (sscanf(tStr.c_str(), "%d-%d-%dT%d:%d:%d", &Y, &M, &D, &h, &m, &s) >= 6) {
-                    // Check for 'Z' to detect UTC
-                    bool isUtc = tStr.endsWith("Z");
-                    
-                    if (isUtc) {
-                        // Very basic timezone handling using system time if configured
-                        // or just assume local if we can't do better easily.
-                        // Assuming system TZ is set, we can use mktime/localtime logic.
-                        struct tm tm = {0};
-                        tm.tm_year = Y - 1900;
-                        tm.tm_mon = M - 1;
-                        tm.tm_mday = D;
-                        tm.tm_hour = h;
-                        tm.tm_min = m;
-                        tm.tm_sec = s;
-                        
-                        // Treat as UTC -> Local
-                        
-                        // timegm is not standard, use mktime with UTC TZ trick
-                        const char* tz = getenv("TZ");
-                        String oldTz = tz ? String(tz) : "";
-                        setenv("TZ", "UTC0", 1);
-                        tzset();
-                        time_t t = mktime(&tm); 
-                        if (oldTz.length() > 0) setenv("TZ", oldTz.c_str(), 1);
-                        else unsetenv("TZ");
-                        tzset();
-
-                        struct tm *loc = localtime(&t);
-                        h = loc->tm_hour;
-                        m = loc->tm_min;
-                    }
-                    
-                    hourVal = h + m / 60.0;
-                    char buf[6];
-                    sprintf(buf, "%02d:%02d", h, m);
-                    dispStr = String(buf);
-                    //Serial.printf("Parsed %s -> %.2f\n", tStr.c_str(), hourVal);
-                } else {
-                    //Serial.printf("Failed to parse time string: %s\n", tStr.c_str());
-                }
-            };
-            
-            parseTime(rise, dailyForecasts[i].sunriseHour, dailyForecasts[i].sunrise);
-            parseTime(set, dailyForecasts[i].sunsetHour, dailyForecasts[i].sunset);
-
-            Serial.printf("Day %d: %s, High: %.1f, Low: %.1f, Icon: %s\n", i, dailyForecasts[i].dayName.c_str(), dailyForecasts[i].tempHigh, dailyForecasts[i].tempLow, dailyForecasts[i].iconName.c_str());
-        }
-        http.end();
-        return true;
+// Fetch buffers start out as "no data", so the merge below can tell which
+// hours a response held
+void clearFetchBuffers(WeatherData& current, DailyForecast daily[5], HourlyData forecast[24], HourlyData history[24]) {
+  clearWeatherData(current);
+  for(int i=0; i<5; i++) clearDailyForecast(daily[i]);
+  for(int i=0; i<24; i++) {
+      clearHourlyData(forecast[i], i);
+      clearHourlyData(history[i], i);
+  }
+}
+
+void mergeCurrentWeather(const WeatherData& weather) {
+  // Everything before the indoor readings comes from the API
+  memcpy(&currentWeather, &weather, offsetof(WeatherData, indoorTemp));
+}
+
+void mergeDailyForecast(const DailyForecast days[5]) {
+  // Days missing from the response keep what was there
+  for(int i=0; i<5; i++) {
+      if (days[i].weekday != WEEKDAY_NONE) dailyForecasts[i] = days[i];
+  }
+}
+
+// Every hour's forecast fields are replaced (hours outside the response
+// become "no data"); the indoor readings are kept
+void mergeHourlyForecast(const HourlyData hours[24]) {
+  for(int i=0; i<24; i++) {
+      float preservedIndoorP = hourlyData[i].indoorPressure;
+
+      hourlyData[i].hour = i;
+      hourlyData[i].temp = hours[i].temp;
+      hourlyData[i].rainProb = hours[i].rainProb;
+      // Preserving indoor pressure
+      if (preservedIndoorP == 0 || isnan(preservedIndoorP)) {
+           hourlyData[i].indoorPressure = -1.0;
       }
-    } else {
-      Serial.print("Error code: ");
-      Serial.println(httpResponseCode);
+      hourlyData[i].pressure = hours[i].pressure;
+  }
+}
+
+// Only the hours in the response are replaced, so an incremental history
+// fetch keeps the older observations
+void mergeHistory(const HourlyData hours[24]) {
+  for(int i=0; i<24; i++) {
+      if (hours[i].actualTemp == -100.0f) continue;
+      hourlyData[i].actualTemp = hours[i].actualTemp;
+      hourlyData[i].actualRain = hours[i].actualRain;
+      if (hours[i].actualPressure != -1.0f) hourlyData[i].actualPressure = hours[i].actualPressure;
+  }
+}
+
+#if WEATHER_JSON_SAX
+// Streaming handlers for the four responses. Each fills a scratch copy as
+// values arrive and the caller copies it to the fetch buffer once the whole
+// body has parsed, so a failed request leaves the buffer as it was (as with
+// the document path).
+
+// A condition's icon from its iconBaseUri, else from its type
+struct SaxIcon {
+  WeatherIconId fromUri;
+  WeatherIconId fromType;
+  char type[32];
+
+  void reset() {
+    fromUri = fromType = ICON_UNKNOWN;
+    type[0] = 0;
+  }
+
+  void setType(const char* t) {
+    strlcpy(type, t, sizeof(type));
+    fromType = weatherIconId(t);
+  }
+
+  WeatherIconId resolve() const {
+    WeatherIconId id = fromUri != ICON_UNKNOWN ? fromUri : fromType;
+    if (id == ICON_UNKNOWN) Serial.printf("Unknown weather icon (%s)\n", type);
+    return id;
+  }
+};
+
+class DailySax : public JsonSaxHandler {
+public:
+  DailyForecast days[5];
+  uint8_t count;
+
+  DailySax() : count(0), _day(nullptr) {
+    for (int i = 0; i < 5; i++) clearDailyForecast(days[i]);
+  }
+
+  void beginRecord(uint8_t, uint16_t index) override {
+    _day = index < 5 ? &days[index] : nullptr;
+    if (!_day) return;
+    _day->tempHigh = 0;
+    _day->tempLow = 0;
+    _day->conditionText[0] = 0;
+    _year = _month = _date = 0;
+    _icon.reset();
+  }
+
+  void value(uint8_t field, const JsonSaxValue& v) override {
+    if (!_day) return;
+    switch (field) {
+      case FIELD_DAY_YEAR: _year = v.asInt(); break;
+      case FIELD_DAY_MONTH: _month = v.asInt(); break;
+      case FIELD_DAY_DAY: _date = v.asInt(); break;
+      case FIELD_DAY_MAX_TEMP: _day->tempHigh = v.asFloat(); break;
+      case FIELD_DAY_MIN_TEMP: _day->tempLow = v.asFloat(); break;
+      case FIELD_DAY_CONDITION_TEXT: strlcpy(_day->conditionText, v.asString(), sizeof(_day->conditionText)); break;
+      case FIELD_DAY_ICON_URI: _icon.fromUri = iconIdFromUri(v.asString()); break;
+      case FIELD_DAY_CONDITION_TYPE: _icon.setType(v.asString()); break;
+      case FIELD_DAY_SUNRISE: parseTimeOfDay(v.asString(), _day->sunrise); break;
+      case FIELD_DAY_SUNSET: parseTimeOfDay(v.asString(), _day->sunset); break;
     }
-    http.end();
-  } else {
-    Serial.println("WiFi Disconnected");
   }
-  return false;
+
+  void endRecord(uint8_t, uint16_t index) override {
+    if (!_day) return;
+    _day->weekday = getWeekday(_year, _month, _date);
+    _day->iconId = _icon.resolve();
+    count = index + 1;
+    _day = nullptr;
+  }
+
+private:
+  DailyForecast* _day;
+  int _year, _month, _date;
+  SaxIcon _icon;
+};
+
+// Local hour of an interval's startTime when it falls on currentDay (day of
+// the month), otherwise -1
+static int localHourOn(const char* startTime, int currentDay) {
+  IsoTime start;
+  if (!parseIso8601(startTime, start)) return -1;
+  struct tm local;
+  localTimes.toLocal(isoToEpoch(start), local);
+  return local.tm_mday == currentDay ? local.tm_hour : -1;
 }
 
-bool getHourlyForecastData(int hoursCount) {
-  if (WiFi.status() == WL_CONNECTED) {
-    // Request hoursCount hours to ensure we cover the rest of the current day
-    String url = "https://weather.googleapis.com/v1/forecast/hours:lookup?key=" + String(GOOGLE_API_KEY) 
-      + "&location.latitude=" + String(LATITUDE) 
-      + "&location.longitude=" + String(LONGITUDE) 
-      + "&hours=" + String(hoursCount)
-      + "&unitsSystem=METRIC";
-    
-    Serial.println("Requesting URL: " + url);
+// Shared by the forecast and history hours: one value set per local hour
+class HoursSax : public JsonSaxHandler {
+public:
+  float temp[24];
+  float rain[24];     // Rain probability (forecast) or rainfall (history)
+  float pressure[24]; // -1 when neither pressure key was present
+  bool have[24];
+
+  HoursSax(int today, uint8_t startField, uint8_t tempField, uint8_t rainField, uint8_t pressureField, uint8_t airPressureField)
+    : _today(today), _startField(startField), _tempField(tempField), _rainField(rainField),
+      _pressureField(pressureField), _airPressureField(airPressureField) {
+    memset(have, 0, sizeof(have));
+  }
 
-    WiFiClientSecure client;
-    client.setInsecure();
-    client.setTimeout(15000); // 15s timeout for larger payload
-    HTTPClient http;
-    http.begin(client, url);
-    http.setTimeout(15000);
-    int httpResponseCode = http.GET();
-    
-    if (httpResponseCode > 0) {
-      String payload = http.getString();
-      Serial.println("HTTP Response code: " + String(httpResponseCode));
-      
-      JsonDocument filter;
-      filter["forecastHours"][0]["interval"]["startTime"] = true; // "2026-01-03T17:00:00Z"
-      filter["forecastHours"][0]["temperature"]["degrees"] = true;
-      filter["forecastHours"][0]["precipitation"]["probability"]["percent"] = true;
-      filter["forecastHours"][0]["pressure"]["meanSeaLevelMillibars"] = true;
-      filter["forecastHours"][0]["airPressure"]["meanSeaLevelMillibars"] = true;
-
-      JsonDocument doc;
-      DeserializationError error = deserializeJson(doc, payload, DeserializationOption::Filter(filter));
-
-      if (error) {
-        Serial.print("deserializeJson() failed: ");
-        Serial.println(error.c_str());
-        http.end();
-        return false;
-      } else {
-        // Reset hourly data for the new day
-        for(int i=0; i<24; i++) {
-            float preservedIndoor = hourlyData[i].indoorTemp;
-            float preservedIndoorP = hourlyData[i].indoorPressure;
-
-            hourlyData[i].hour = i;
-            hourlyData[i].temp = -100.0; // Sentinel for no data
-            hourlyData[i].rainProb = -1; // Sentinel for no data
-            hourlyData[i].actualTemp = -100.0;
-            hourlyData[i].actualRain = -1.0;
-            hourlyData[i].indoorTemp = preservedIndoor;
-            // Preserving indoor pressure
-            if (preservedIndoorP != 0 && !isnan(preservedIndoorP)) {
-                 hourlyData[i].indoorPressure = preservedIndoorP;
-            } else {
-                 hourlyData[i].indoorPressure = -1.0;
-            }
-            hourlyData[i].pressure = -1.0;
-            hourlyData[i].actualPressure = -1.0;
-        }
-
-        // Get current day to filter forecast
-        struct tm timeinfo;
-        if(!getLocalTime(&timeinfo, 1000)){
-            Serial.println("Failed to obtain time for forecast filtering");
-        }
-        int currentDay = timeinfo.tm_mday;
-
-        JsonArray forecasts = doc["forecastHours"];
-        for(int i=0; i<forecasts.size(); i++) {
-            JsonObject f = forecasts[i];
-            String timeStr = f["interval"]["startTime"].as<String>();
-            
-            // Parse ISO string "2026-01-03T17:00:00Z"
-            // Note: The API returns UTC time. We need to convert to local time or rely on the fact that we want "today" in local time.
-            // However, parsing the string manually is tricky with timezones.
-            // Better approach: Parse the time string into a tm struct, apply timezone offset, then check day.
-            
-            struct tm tm_forecast;
-            strptime(timeStr.c_str(), "%Y-%m-%dT%H:%M:%SZ", &tm_forecast);
-            time_t t_forecast = mktime(&tm_forecast); // This assumes local time if not careful, but strptime doesn't set timezone.
-            // Actually, the API returns UTC (Z).
-            // We need to adjust for our timezone offset.
-            // Our timezone is set in setup() with configTime.
-            // But mktime uses the TZ environment variable.
-            // Since we set TZ in setup, mktime might interpret the input as local time? No, strptime just fills the struct.
-            // Let's manually adjust for UTC+10/11 (Melbourne).
-            // Or simpler: The API returns UTC. We know our offset.
-            // But DST makes it hard.
-            
-            // Alternative: Use the hour from the string and assume the API returns what we want? No, it returns UTC.
-            // If we are in Melbourne (UTC+11 in Jan), 00:00 Local is 13:00 UTC previous day.
-            // 10:00 Local is 23:00 UTC previous day.
-            // 11:00 Local is 00:00 UTC current day.
-            
-            // Let's use the system time functions which are already configured.
-            // We can parse the year, month, day, hour, min, sec from the string.
-            int y, M, d, h, m, s;
-            sscanf(timeStr.c_str(), "%d-%d-%dT%d:%d:%dZ", &y, &M, &d, &h, &m, &s);
-            
-            struct tm tm_utc = {0};
-            tm_utc.tm_year = y - 1900;
-            tm_utc.tm_mon = M - 1;
-            tm_utc.tm_mday = d;
-            tm_utc.tm_hour = h;
-            tm_utc.tm_min = m;
-            tm_utc.tm_sec = s;
-            tm_utc.tm_isdst = 0; // UTC has no DST
-            
-            // Convert UTC tm to time_t (assuming UTC)
-            // timegm is not standard in all Arduino, but _mkgmtime might be available or we use mktime and adjust.
-            // Since we set TZ to Melbourne, mktime will interpret this as Melbourne time, which is wrong.
-            // We need to treat it as UTC.
-            // Let's just add the offset manually? No, DST.
-            
-            // Let's use the standard time library correctly.
-            // We have the current epoch time.
-            // We can convert the forecast time string to epoch.
-            // Then convert that epoch to local tm.
-            
-            // Manual UTC to epoch:
-            // This is getting complicated.
-            // Simpler hack: The device has the correct local time.
-            // We can just iterate 0-23 of "today" and see if we can find a matching forecast in the list?
-            // No, we have the list.
-            
-            // Let's try to convert the UTC struct to time_t as if it was UTC.
-            // setenv("TZ", "UTC0", 1); tzset(); time_t t = mktime(&tm_utc); setenv("TZ", time_zone, 1); tzset();
-            // This is safe if we restore it.
-            
-            char oldTZ[64];
-            strcpy(oldTZ, getenv("TZ"));
-            setenv("TZ", "UTC0", 1);
-            tzset();
-            time_t t_utc = mktime(&tm_utc);
-            
-            // Restore TZ
-            setenv("TZ", oldTZ, 1);
-            tzset();
-            
-            // Now convert t_utc to local time
-            struct tm *tm_local = localtime(&t_utc);
-            
-            // Debug print
-            // Serial.printf("Forecast Time: %s -> Local: Day %d, Hour %d\n", timeStr.c_str(), tm_local->tm_mday, tm_local->tm_hour);
-
-            // Check if this forecast is for "today" (the day we are currently in)
-            if (tm_local->tm_mday == currentDay) {
-                int hour = tm_local->tm_hour;
-                if (hour >= 0 && hour < 24) {
-                    hourlyData[hour].hour = hour;
-                    hourlyData[hour].temp = f["temperature"]["degrees"];
-                    hourlyData[hour].rainProb = f["precipitation"]["probability"]["percent"];
-                    
-                    if (!f["pressure"]["meanSeaLevelMillibars"].isNull()) {
-                         hourlyData[hour].pressure = f["pressure"]["meanSeaLevelMillibars"];
-                    } else if (!f["airPressure"]["meanSeaLevelMillibars"].isNull()) {
-                         hourlyData[hour].pressure = f["airPressure"]["meanSeaLevelMillibars"];
-                    }
-                    // actualTemp is left as -100.0
-                }
-            }
-        }
-        Serial.println("Hourly data updated (Midnight to Midnight).");
-        http.end();
-        return true;
-      }
-    } else {
-      Serial.print("Error code: ");
-      Serial.println(httpResponseCode);
+  void beginRecord(uint8_t, uint16_t) override {
+    _hour = -1;
+    _temp = _rain = 0;
+    _pressure = _airPressure = -1;
+    _hasPressure = _hasAirPressure = false;
+  }
+
+  void value(uint8_t field, const JsonSaxValue& v) override {
+    if (field == _startField) _hour = localHourOn(v.asString(), _today);
+    else if (field == _tempField) _temp = v.asFloat();
+    else if (field == _rainField) _rain = v.asFloat();
+    else if (field == _pressureField) { _pressure = v.asFloat(); _hasPressure = v.type != JsonSaxValue::NUL; }
+    else if (field == _airPressureField) { _airPressure = v.asFloat(); _hasAirPressure = v.type != JsonSaxValue::NUL; }
+  }
+
+  void endRecord(uint8_t, uint16_t) override {
+    if (_hour < 0 || _hour >= 24) return;
+    temp[_hour] = _temp;
+    rain[_hour] = _rain;
+    pressure[_hour] = _hasPressure ? _pressure : (_hasAirPressure ? _airPressure : -1);
+    have[_hour] = true;
+  }
+
+private:
+  int _today;
+  uint8_t _startField, _tempField, _rainField, _pressureField, _airPressureField;
+  int _hour;
+  float _temp, _rain, _pressure, _airPressure;
+  bool _hasPressure, _hasAirPressure;
+};
+
+class CurrentSax : public JsonSaxHandler {
+public:
+  WeatherData weather;
+
+  CurrentSax() {
+    clearWeatherData(weather);
+  }
+
+  void beginRecord(uint8_t, uint16_t) override {
+    weather.conditionText[0] = 0;
+    weather.temp = weather.feelsLike = weather.windSpeed = weather.windGust = 0;
+    weather.windDirection = weather.humidity = weather.precipitationProbability = weather.uvIndex = weather.pressure = 0;
+    _icon.reset();
+  }
+
+  void value(uint8_t field, const JsonSaxValue& v) override {
+    switch (field) {
+      case FIELD_CURRENT_CONDITION_TEXT: strlcpy(weather.conditionText, v.asString(), sizeof(weather.conditionText)); break;
+      case FIELD_CURRENT_ICON_URI: _icon.fromUri = iconIdFromUri(v.asString()); break;
+      case FIELD_CURRENT_CONDITION_TYPE: _icon.setType(v.asString()); break;
+      case FIELD_CURRENT_TEMP: weather.temp = v.asFloat(); break;
+      case FIELD_CURRENT_FEELS_LIKE: weather.feelsLike = v.asFloat(); break;
+      case FIELD_CURRENT_WIND_SPEED: weather.windSpeed = v.asFloat(); break;
+      case FIELD_CURRENT_WIND_GUST: weather.windGust = v.asFloat(); break;
+      case FIELD_CURRENT_WIND_DIRECTION: weather.windDirection = v.asInt(); break;
+      case FIELD_CURRENT_HUMIDITY: weather.humidity = v.asInt(); break;
+      case FIELD_CURRENT_RAIN_PROB: weather.precipitationProbability = v.asInt(); break;
+      case FIELD_CURRENT_UV_INDEX: weather.uvIndex = v.asInt(); break;
+      case FIELD_CURRENT_PRESSURE: weather.pressure = v.asInt(); break;
     }
-    http.end();
-  } else {
-    Serial.println("WiFi Disconnected");
   }
-  return false;
+
+  void endRecord(uint8_t, uint16_t) override {
+    weather.iconId = _icon.resolve();
+    weather.valid = true;
+  }
+
+private:
+  SaxIcon _icon;
+};
+#else
+// Document memory for the ArduinoJson path. Each connection parses into its
+// own statically reserved arena, reset at the start of every request, so the
+// documents never touch the heap while the arena is big enough.
+#ifndef JSON_ARENA_BYTES
+#define JSON_ARENA_BYTES 12288
+#endif
+
+enum JsonEndpoint : uint8_t { JSON_DAILY, JSON_HOURLY, JSON_HISTORY, JSON_CURRENT, JSON_ENDPOINTS };
+static const char* const jsonEndpointNames[JSON_ENDPOINTS] = {"daily", "hourly", "history", "current"};
+
+static StaticJsonArena<JSON_ARENA_BYTES> documentArenas[FETCH_MAX_CONNECTIONS];
+static JsonArena heapArena(nullptr, 0); // For a connection beyond FETCH_MAX_CONNECTIONS
+
+// Most arena bytes (heap overflow included) each endpoint has needed
+// since power-on, for sizing JSON_ARENA_BYTES
+RTC_DATA_ATTR static uint32_t arenaHighWater[JSON_ENDPOINTS];
+
+static JsonArena& documentArena(WeatherClient& client) {
+  if (client.slot() >= FETCH_MAX_CONNECTIONS) return heapArena;
+  JsonArena& arena = documentArenas[client.slot()];
+  arena.reset();
+  return arena;
 }
 
-bool getHistoryData(int hoursCount) {
-  if (WiFi.status() == WL_CONNECTED) {
-    // Request hoursCount hours of history to cover the current day so far
-    String url = "https://weather.googleapis.com/v1/history/hours:lookup?key=" + String(GOOGLE_API_KEY) 
-      + "&location.latitude=" + String(LATITUDE) 
-      + "&location.longitude=" + String(LONGITUDE) 
-      + "&hours=" + String(hoursCount)
-      + "&unitsSystem=METRIC";
-    
-    Serial.println("Requesting History URL: " + url);
+static void logArena(JsonEndpoint endpoint, const JsonArena& arena) {
+  uint32_t needed = arena.peak() + arena.heapBytes();
+  if (needed > arenaHighWater[endpoint]) arenaHighWater[endpoint] = needed;
+  Serial.printf("JSON arena (%s): %u of %u bytes, %u from heap, high water %u\n", jsonEndpointNames[endpoint],
+                (unsigned)arena.peak(), (unsigned)arena.capacity(), (unsigned)arena.heapBytes(),
+                (unsigned)arenaHighWater[endpoint]);
+}
 
-    WiFiClientSecure client;
-    client.setInsecure();
-    client.setTimeout(15000);
-    HTTPClient http;
-    http.begin(client, url);
-    http.setTimeout(15000);
-    int httpResponseCode = http.GET();
-    
-    if (httpResponseCode > 0) {
-      String payload = http.getString();
-      Serial.println("HTTP Response code: " + String(httpResponseCode));
-      
-      JsonDocument filter;
-      filter["historyHours"][0]["interval"]["startTime"] = true;
-      filter["historyHours"][0]["temperature"]["degrees"] = true;
-      filter["historyHours"][0]["precipitation"]["rainfallMM"] = true;
-      filter["historyHours"][0]["pressure"]["meanSeaLevelMillibars"] = true;
-      filter["historyHours"][0]["airPressure"]["meanSeaLevelMillibars"] = true; // Try both keys just in case
-
-      JsonDocument doc;
-      DeserializationError error = deserializeJson(doc, payload, DeserializationOption::Filter(filter));
-
-      if (error) {
-        Serial.print("deserializeJson() failed: ");
-        Serial.println(error.c_str());
-        http.end();
-        return false;
-      } else {
-        // Get current day to filter history
-        struct tm timeinfo;
-        if(!getLocalTime(&timeinfo, 1000)){
-            Serial.println("Failed to obtain time for history filtering");
-        }
-        int currentDay = timeinfo.tm_mday;
-
-        JsonArray history = doc["historyHours"];
-        for(int i=0; i<history.size(); i++) {
-            JsonObject h_data = history[i];
-            String timeStr = h_data["interval"]["startTime"].as<String>();
-            
-            // Parse ISO string "2026-01-03T17:00:00Z"
-            int y, M, d, h, m, s;
-            sscanf(timeStr.c_str(), "%d-%d-%dT%d:%d:%dZ", &y, &M, &d, &h, &m, &s);
-            
-            struct tm tm_utc = {0};
-            tm_utc.tm_year = y - 1900;
-            tm_utc.tm_mon = M - 1;
-            tm_utc.tm_mday = d;
-            tm_utc.tm_hour = h;
-            tm_utc.tm_min = m;
-            tm_utc.tm_sec = s;
-            tm_utc.tm_isdst = 0;
-            
-            // Convert UTC to local time
-            char oldTZ[64];
-            strcpy(oldTZ, getenv("TZ"));
-            setenv("TZ", "UTC0", 1);
-            tzset();
-            time_t t_utc = mktime(&tm_utc);
-            setenv("TZ", oldTZ, 1);
-            tzset();
-            
-            struct tm *tm_local = localtime(&t_utc);
-            
-            // Debug print
-            // Serial.printf("History Time: %s -> Local: Day %d, Hour %d\n", timeStr.c_str(), tm_local->tm_mday, tm_local->tm_hour);
-
-            // Check if this history point is for "today"
-            if (tm_local->tm_mday == currentDay) {
-                int hour = tm_local->tm_hour;
-                if (hour >= 0 && hour < 24) {
-                    hourlyData[hour].actualTemp = h_data["temperature"]["degrees"];
-                    if (!h_data["precipitation"]["rainfallMM"].isNull()) {
-                        hourlyData[hour].actualRain = h_data["precipitation"]["rainfallMM"];
-                    } else {
-                        hourlyData[hour].actualRain = 0.0;
-                    }
-
-                    if (!h_data["pressure"]["meanSeaLevelMillibars"].isNull()) {
-                         hourlyData[hour].actualPressure = h_data["pressure"]["meanSeaLevelMillibars"];
-                    } else if (!h_data["airPressure"]["meanSeaLevelMillibars"].isNull()) {
-                         hourlyData[hour].actualPressure = h_data["airPressure"]["meanSeaLevelMillibars"];
-                    }
-                }
-            }
-        }
-        Serial.println("History data updated.");
-        http.end();
-        return true;
+// The response filters, built once before setup() and only read after that,
+// so the fetch tasks can share them
+struct JsonFilters {
+  JsonDocument daily;
+  JsonDocument hourly;
+  JsonDocument history;
+  JsonDocument current;
+
+  JsonFilters() {
+    daily["forecastDays"][0]["displayDate"] = true;
+    daily["forecastDays"][0]["maxTemperature"]["degrees"] = true;
+    daily["forecastDays"][0]["minTemperature"]["degrees"] = true;
+    daily["forecastDays"][0]["daytimeForecast"]["weatherCondition"]["description"]["text"] = true;
+    daily["forecastDays"][0]["daytimeForecast"]["weatherCondition"]["iconBaseUri"] = true;
+    daily["forecastDays"][0]["daytimeForecast"]["weatherCondition"]["type"] = true;
+    daily["forecastDays"][0]["sunEvents"]["sunriseTime"] = true;
+    daily["forecastDays"][0]["sunEvents"]["sunsetTime"] = true;
+
+    hourly["forecastHours"][0]["interval"]["startTime"] = true; // "2026-01-03T17:00:00Z"
+    hourly["forecastHours"][0]["temperature"]["degrees"] = true;
+    hourly["forecastHours"][0]["precipitation"]["probability"]["percent"] = true;
+    hourly["forecastHours"][0]["pressure"]["meanSeaLevelMillibars"] = true;
+    hourly["forecastHours"][0]["airPressure"]["meanSeaLevelMillibars"] = true;
+
+    history["historyHours"][0]["interval"]["startTime"] = true;
+    history["historyHours"][0]["temperature"]["degrees"] = true;
+    history["historyHours"][0]["precipitation"]["rainfallMM"] = true;
+    history["historyHours"][0]["pressure"]["meanSeaLevelMillibars"] = true;
+    history["historyHours"][0]["airPressure"]["meanSeaLevelMillibars"] = true; // Try both keys just in case
+
+    current["weatherCondition"]["description"]["text"] = true;
+    current["weatherCondition"]["iconBaseUri"] = true;
+    current["weatherCondition"]["type"] = true;
+    current["temperature"]["degrees"] = true;
+    current["feelsLikeTemperature"]["degrees"] = true;
+    current["wind"]["speed"]["value"] = true;
+    current["wind"]["gust"]["value"] = true;
+    current["wind"]["direction"]["degrees"] = true;
+    current["relativeHumidity"] = true;
+    current["precipitation"]["probability"]["percent"] = true;
+    current["uvIndex"] = true;
+    current["airPressure"]["meanSeaLevelMillibars"] = true;
+
+    daily.shrinkToFit();
+    hourly.shrinkToFit();
+    history.shrinkToFit();
+    current.shrinkToFit();
+  }
+};
+
+static JsonFilters jsonFilters;
+#endif
+
+// 0 = Sunday (1970-01-01 was a Thursday)
+uint8_t getWeekday(int year, int month, int day) {
+    return (uint8_t)((daysFromCivil(year, month, day) % 7 + 11) % 7);
+}
+
+bool getDailyForecastData(WeatherClient& client, DailyForecast daily[5]) {
+  String url = "https://weather.googleapis.com/v1/forecast/days:lookup?key=" + String(GOOGLE_API_KEY) 
+    + "&location.latitude=" + String(LATITUDE) 
+    + "&location.longitude=" + String(LONGITUDE) 
+    + "&days=5"
+    + "&unitsSystem=METRIC";
+
+#if WEATHER_JSON_SAX
+  DailySax days;
+  if (!client.getJson(url, 10000, dailyJsonSchema, days)) {
+    return false;
+  }
+  memcpy(daily, days.days, sizeof(DailyForecast) * days.count);
+  for(int i=0; i<days.count; i++) {
+      Serial.printf("Day %d: %s, High: %.1f, Low: %.1f, Icon: %s\n", i, weekdayName(daily[i].weekday), daily[i].tempHigh, daily[i].tempLow, weatherIconName(daily[i].iconId));
+  }
+  return true;
+#else
+  JsonArena& arena = documentArena(client);
+  JsonDocument doc(&arena);
+  bool ok = client.getJson(url, 10000, jsonFilters.daily, doc);
+  logArena(JSON_DAILY, arena);
+  if (!ok) {
+    return false;
+  }
+
+  JsonArray forecasts = doc["forecastDays"];
+  for(int i=0; i<5 && i<forecasts.size(); i++) {
+      JsonObject f = forecasts[i];
+      int y = f["displayDate"]["year"];
+      int m = f["displayDate"]["month"];
+      int d = f["displayDate"]["day"];
+
+      daily[i].weekday = getWeekday(y, m, d);
+      daily[i].tempHigh = f["maxTemperature"]["degrees"];
+      daily[i].tempLow = f["minTemperature"]["degrees"];
+      strlcpy(daily[i].conditionText, f["daytimeForecast"]["weatherCondition"]["description"]["text"] | "", sizeof(daily[i].conditionText));
+
+      daily[i].iconId = getIconIdFromUri(f["daytimeForecast"]["weatherCondition"]["iconBaseUri"].as<const char*>(), f["daytimeForecast"]["weatherCondition"]["type"].as<const char*>());
+
+      // Parse Sunrise/Sunset
+      const char* rise = f["sunEvents"]["sunriseTime"].as<const char*>();
+      const char* set = f["sunEvents"]["sunsetTime"].as<const char*>();
+
+      //Serial.printf("Day %d Raw Sunrise: %s, Sunset: %s\n", i, rise, set);
+
+      parseTimeOfDay(rise, daily[i].sunrise);
+      parseTimeOfDay(set, daily[i].sunset);
+
+      Serial.printf("Day %d: %s, High: %.1f, Low: %.1f, Icon: %s\n", i, weekdayName(daily[i].weekday), daily[i].tempHigh, daily[i].tempLow, weatherIconName(daily[i].iconId));
+  }
+  return true;
+#endif
+}
+
+bool getHourlyForecastData(WeatherClient& client, int hoursCount, HourlyData forecast[24]) {
+  // Only today's hours are kept, so there is nothing to fetch without a clock
+  int currentDay = todayOfMonth("forecast");
+  if (currentDay < 0) {
+    return false;
+  }
+
+  // Request hoursCount hours to ensure we cover the rest of the current day
+  String url = "https://weather.googleapis.com/v1/forecast/hours:lookup?key=" + String(GOOGLE_API_KEY) 
+    + "&location.latitude=" + String(LATITUDE) 
+    + "&location.longitude=" + String(LONGITUDE) 
+    + "&hours=" + String(hoursCount)
+    + "&unitsSystem=METRIC";
+
+#if WEATHER_JSON_SAX
+  HoursSax hours(currentDay, FIELD_HOUR_START, FIELD_HOUR_TEMP, FIELD_HOUR_RAIN_PROB,
+                 FIELD_HOUR_PRESSURE, FIELD_HOUR_AIR_PRESSURE);
+  if (!client.getJson(url, 15000, hourlyJsonSchema, hours)) {
+    return false;
+  }
+
+  for(int hour=0; hour<24; hour++) {
+      if (!hours.have[hour]) continue;
+      forecast[hour].temp = hours.temp[hour];
+      forecast[hour].rainProb = (int)hours.rain[hour];
+      if (hours.pressure[hour] != -1) forecast[hour].pressure = hours.pressure[hour];
+  }
+#else
+  JsonArena& arena = documentArena(client);
+  JsonDocument doc(&arena);
+  bool ok = client.getJson(url, 15000, jsonFilters.hourly, doc);
+  logArena(JSON_HOURLY, arena);
+  if (!ok) {
+    return false;
+  }
+
+  JsonArray forecasts = doc["forecastHours"];
+  for(int i=0; i<forecasts.size(); i++) {
+      JsonObject f = forecasts[i];
+      // Start of the hour in UTC ("2026-01-03T17:00:00Z"), in local time
+      IsoTime start;
+      if (!parseIso8601(f["interval"]["startTime"].as<const char*>(), start)) continue;
+      struct tm local;
+      localTimes.toLocal(isoToEpoch(start), local);
+      struct tm *tm_local = &local;
+
+      // Debug print
+      // Serial.printf("Forecast Time: %s -> Local: Day %d, Hour %d\n", f["interval"]["startTime"].as<const char*>(), tm_local->tm_mday, tm_local->tm_hour);
+
+      // Check if this forecast is for "today" (the day we are currently in)
+      if (tm_local->tm_mday == currentDay) {
+          int hour = tm_local->tm_hour;
+          if (hour >= 0 && hour < 24) {
+              forecast[hour].hour = hour;
+              forecast[hour].temp = f["temperature"]["degrees"];
+              forecast[hour].rainProb = f["precipitation"]["probability"]["percent"];
+
+              if (!f["pressure"]["meanSeaLevelMillibars"].isNull()) {
+                   forecast[hour].pressure = f["pressure"]["meanSeaLevelMillibars"];
+              } else if (!f["airPressure"]["meanSeaLevelMillibars"].isNull()) {
+                   forecast[hour].pressure = f["airPressure"]["meanSeaLevelMillibars"];
+              }
+              // actualTemp is left as -100.0
+          }
       }
-    } else {
-      Serial.print("Error code: ");
-      Serial.println(httpResponseCode);
-    }
-    http.end();
-  } else {
-    Serial.println("WiFi Disconnected");
   }
-  return false;
+#endif
+  Serial.println("Hourly data updated (Midnight to Midnight).");
+  return true;
 }
 
-bool getWeatherCurrentData(){
-    if (WiFi.status() == WL_CONNECTED) {
-    String url = "https://weather.googleapis.com/v1/currentConditions:lookup?key=" + String(GOOGLE_API_KEY) 
-      + "&location.latitude=" + String(LATITUDE) 
-      + "&location.longitude=" + String(LONGITUDE)
-      + "&unitsSystem=METRIC";
-    
-    Serial.println("Requesting URL: " + url);
+bool getHistoryData(WeatherClient& client, int hoursCount, HourlyData history[24]) {
+  // Only today's hours are kept, so there is nothing to fetch without a clock
+  int currentDay = todayOfMonth("history");
+  if (currentDay < 0) {
+    return false;
+  }
 
-    WiFiClientSecure client;
-    client.setInsecure();
-    client.setTimeout(10000);
-    HTTPClient http;
-    http.begin(client, url);
-    http.setTimeout(10000);
-    int httpResponseCode = http.GET();
-    
-    if (httpResponseCode > 0) {
-      String payload = http.getString();
-      Serial.println("HTTP Response code: " + String(httpResponseCode));
-      //Serial.println("Payload: " + payload);
-
-      JsonDocument filter;
-      filter["weatherCondition"]["description"]["text"] = true;
-      filter["weatherCondition"]["iconBaseUri"] = true;
-      filter["temperature"]["degrees"] = true;
-      filter["feelsLikeTemperature"]["degrees"] = true;
-      filter["wind"]["speed"]["value"] = true;
-      filter["wind"]["gust"]["value"] = true;
-      filter["wind"]["direction"]["degrees"] = true;
-      filter["relativeHumidity"] = true;
-      filter["precipitation"]["probability"]["percent"] = true;
-      filter["uvIndex"] = true;
-      filter["airPressure"]["meanSeaLevelMillibars"] = true;
-
-      JsonDocument doc;
-      DeserializationError error = deserializeJson(doc, payload, DeserializationOption::Filter(filter));
-
-      if (error) {
-        Serial.print("deserializeJson() failed: ");
-        Serial.println(error.c_str());
-        http.end();
-        return false;
-      } else {
-        JsonObject newWeather = doc.as<JsonObject>();
-        updateCurrentWeather(newWeather);
-        http.end();
-        return true;
+  // Request hoursCount hours of history to cover the current day so far
+  String url = "https://weather.googleapis.com/v1/history/hours:lookup?key=" + String(GOOGLE_API_KEY) 
+    + "&location.latitude=" + String(LATITUDE) 
+    + "&location.longitude=" + String(LONGITUDE) 
+    + "&hours=" + String(hoursCount)
+    + "&unitsSystem=METRIC";
+
+#if WEATHER_JSON_SAX
+  HoursSax hours(currentDay, FIELD_HISTORY_START, FIELD_HISTORY_TEMP, FIELD_HISTORY_RAIN,
+                 FIELD_HISTORY_PRESSURE, FIELD_HISTORY_AIR_PRESSURE);
+  if (!client.getJson(url, 15000, historyJsonSchema, hours)) {
+    return false;
+  }
+
+  for(int hour=0; hour<24; hour++) {
+      if (!hours.have[hour]) continue;
+      history[hour].actualTemp = hours.temp[hour];
+      history[hour].actualRain = hours.rain[hour];
+      if (hours.pressure[hour] != -1) history[hour].actualPressure = hours.pressure[hour];
+  }
+#else
+  JsonArena& arena = documentArena(client);
+  JsonDocument doc(&arena);
+  bool ok = client.getJson(url, 15000, jsonFilters.history, doc);
+  logArena(JSON_HISTORY, arena);
+  if (!ok) {
+    return false;
+  }
+
+  JsonArray historyHours = doc["historyHours"];
+  for(int i=0; i<historyHours.size(); i++) {
+      JsonObject h_data = historyHours[i];
+      // Start of the hour in UTC ("2026-01-03T17:00:00Z"), in local time
+      IsoTime start;
+      if (!parseIso8601(h_data["interval"]["startTime"].as<const char*>(), start)) continue;
+      struct tm local;
+      localTimes.toLocal(isoToEpoch(start), local);
+      struct tm *tm_local = &local;
+
+      // Debug print
+      // Serial.printf("History Time: %s -> Local: Day %d, Hour %d\n", h_data["interval"]["startTime"].as<const char*>(), tm_local->tm_mday, tm_local->tm_hour);
+
+      // Check if this history point is for "today"
+      if (tm_local->tm_mday == currentDay) {
+          int hour = tm_local->tm_hour;
+          if (hour >= 0 && hour < 24) {
+              history[hour].actualTemp = h_data["temperature"]["degrees"];
+              if (!h_data["precipitation"]["rainfallMM"].isNull()) {
+                  history[hour].actualRain = h_data["precipitation"]["rainfallMM"];
+              } else {
+                  history[hour].actualRain = 0.0;
+              }
+
+              if (!h_data["pressure"]["meanSeaLevelMillibars"].isNull()) {
+                   history[hour].actualPressure = h_data["pressure"]["meanSeaLevelMillibars"];
+              } else if (!h_data["airPressure"]["meanSeaLevelMillibars"].isNull()) {
+                   history[hour].actualPressure = h_data["airPressure"]["meanSeaLevelMillibars"];
+              }
+          }
       }
-    } else {
-      Serial.print("Error code: ");
-      Serial.println(httpResponseCode);
-    }
-    http.end();
-  } else {
-    Serial.println("WiFi Disconnected");
   }
-  return false;
+#endif
+  Serial.println("History data updated.");
+  return true;
+}
+
+bool getWeatherCurrentData(WeatherClient& client, WeatherData& weather) {
+  String url = "https://weather.googleapis.com/v1/currentConditions:lookup?key=" + String(GOOGLE_API_KEY) 
+    + "&location.latitude=" + String(LATITUDE) 
+    + "&location.longitude=" + String(LONGITUDE)
+    + "&unitsSystem=METRIC";
+
+#if WEATHER_JSON_SAX
+  CurrentSax current;
+  if (!client.getJson(url, 10000, currentJsonSchema, current)) {
+    return false;
+  }
+  weather = current.weather;
+  logCurrentWeather(weather);
+  return true;
+#else
+  JsonArena& arena = documentArena(client);
+  JsonDocument doc(&arena);
+  bool ok = client.getJson(url, 10000, jsonFilters.current, doc);
+  logArena(JSON_CURRENT, arena);
+  if (!ok) {
+    return false;
+  }
+
+  JsonObject newWeather = doc.as<JsonObject>();
+  updateCurrentWeather(newWeather, weather);
+  return true;
+#endif
 }
@@ -4,21 +4,44 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
 #include "Display.h"
+#include "WeatherClient.h"
+#include "TimeUtil.h"
 
-// Declare external global variables that these functions modify
+// Parse responses with the schema-driven streaming parser (JsonSax.h,
+// WeatherJsonSchema.h) rather than into ArduinoJson documents
+#ifndef WEATHER_JSON_SAX
+#define WEATHER_JSON_SAX 1
+#endif
+
+// The weather these functions fill, defined in WeatherAPI.cpp so the
+// native test build links without main.cpp
 extern WeatherData currentWeather;
 extern DailyForecast dailyForecasts[5];
 extern HourlyData hourlyData[24];
+// UTC offsets for this wake, built once the clock and TZ are set
+extern LocalTimeTable localTimes;
 
 // Function declarations
 void getMockForecastData();
-String getIconNameFromUri(String uri);
+WeatherIconId getIconIdFromUri(const char* uri, const char* conditionType = nullptr);
 String getAPIData(String url);
-void updateCurrentWeather(JsonObject hourly);
-String getDayName(int year, int month, int day);
-bool getDailyForecastData();
-bool getHourlyForecastData(int hoursCount);
-bool getHistoryData(int hoursCount);
-bool getWeatherCurrentData();
+void updateCurrentWeather(JsonObject hourly, WeatherData& weather);
+void logCurrentWeather(const WeatherData& weather);
+uint8_t getWeekday(int year, int month, int day);
+// Fetch and parse one endpoint over the given connection into a buffer of
+// the caller's (cleared with clearFetchBuffers()), leaving the globals
+// alone. Safe to run concurrently with each other (see FetchScheduler).
+bool getDailyForecastData(WeatherClient& client, DailyForecast daily[5]);
+bool getHourlyForecastData(WeatherClient& client, int hoursCount, HourlyData forecast[24]);
+bool getHistoryData(WeatherClient& client, int hoursCount, HourlyData history[24]);
+bool getWeatherCurrentData(WeatherClient& client, WeatherData& weather);
+void clearFetchBuffers(WeatherData& current, DailyForecast daily[5], HourlyData forecast[24], HourlyData history[24]);
+// Copy one endpoint's fields from its fetch buffer into the globals. The
+// forecast and history share hourlyData, so callers on different fetch
+// tasks must hold a common lock.
+void mergeCurrentWeather(const WeatherData& weather);
+void mergeDailyForecast(const DailyForecast daily[5]);
+void mergeHourlyForecast(const HourlyData forecast[24]);
+void mergeHistory(const HourlyData history[24]);
 
 #endif
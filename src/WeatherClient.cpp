@@ -0,0 +1,124 @@
+#include "WeatherClient.h"
+#include <WiFi.h>
+#include "HttpBodyStream.h"
+
+WeatherClient::WeatherClient(uint8_t slot) : _slot(slot), _requests(0), _handshakes(0), _handshakeMs(0), _bodyBytes(0), _heapBefore(0) {
+    _client.setInsecure(); // Skip certificate validation
+    _http.setReuse(true);
+}
+
+bool WeatherClient::connect() {
+    if (_client.connected()) {
+        Serial.println("Reusing connection to " WEATHER_API_HOST);
+        return true;
+    }
+    unsigned long start = millis();
+    bool connected = _client.connect(WEATHER_API_HOST, WEATHER_API_PORT);
+    unsigned long elapsed = millis() - start;
+    _handshakes++;
+    _handshakeMs += elapsed;
+    Serial.printf("TLS handshake %u %s in %lu ms\n", _handshakes, connected ? "done" : "failed", elapsed);
+    return connected;
+}
+
+int WeatherClient::sendGet(const String& url, uint32_t timeoutMs) {
+    int httpResponseCode = HTTPC_ERROR_CONNECTION_REFUSED;
+    for (uint8_t attempt = 0; attempt < 2; attempt++) {
+        bool reused = _client.connected();
+        if (!connect()) break;
+        _http.begin(_client, url);
+        _http.setTimeout(timeoutMs);
+        httpResponseCode = _http.GET();
+        if (httpResponseCode > 0 || !reused) break;
+        // The server dropped the idle connection; retry once on a fresh one
+        Serial.println("Kept-alive connection lost, reconnecting");
+        _http.end();
+        _client.stop();
+    }
+    return httpResponseCode;
+}
+
+// Sends the GET; on success the response body is ready to read
+bool WeatherClient::beginGet(const String& url, uint32_t timeoutMs) {
+    if (WiFi.status() != WL_CONNECTED) {
+        Serial.println("WiFi Disconnected");
+        return false;
+    }
+    Serial.println("Requesting URL: " + url);
+    _heapBefore = ESP.getFreeHeap();
+    _requests++;
+
+    _client.setTimeout(timeoutMs);
+    const char* headerKeys[] = {"Transfer-Encoding"};
+    _http.collectHeaders(headerKeys, 1);
+    int httpResponseCode = sendGet(url, timeoutMs);
+    if (httpResponseCode <= 0) {
+        Serial.print("Error code: ");
+        Serial.println(httpResponseCode);
+        _http.end();
+        _client.stop();
+        return false;
+    }
+    Serial.println("HTTP Response code: " + String(httpResponseCode));
+    if (httpResponseCode < 200 || httpResponseCode >= 300) {
+        // The body is the API's error object, which would parse as a
+        // response with no data; drop it with the connection
+        _http.end();
+        _client.stop();
+        return false;
+    }
+    return true;
+}
+
+bool WeatherClient::chunkedResponse() {
+    return _http.header("Transfer-Encoding").equalsIgnoreCase("chunked");
+}
+
+void WeatherClient::endGet(HttpBodyStream& body, bool complete) {
+    if (complete) body.finish();
+    body.sampleHeap();
+    _bodyBytes += body.bytesRead();
+    // Keeps the socket open when the server allows keep-alive, but the rest
+    // of a body we gave up on would be read as the next response
+    _http.end();
+    if (!complete) _client.stop();
+    uint32_t lowest = min(_heapBefore, body.minFreeHeap());
+
+    Serial.printf("Payload: %u bytes%s, heap free %u before, %u at lowest (peak use %u), largest block %u\n",
+                  (unsigned)body.bytesRead(), body.chunked() ? " (chunked)" : "", _heapBefore, lowest,
+                  _heapBefore - lowest, ESP.getMaxAllocHeap());
+}
+
+bool WeatherClient::getJson(const String& url, uint32_t timeoutMs, JsonDocument& filter, JsonDocument& doc) {
+    if (!beginGet(url, timeoutMs)) return false;
+    HttpBodyStream body(_http.getStream(), chunkedResponse(), _http.getSize());
+    DeserializationError error = deserializeJson(doc, body, DeserializationOption::Filter(filter));
+    endGet(body, !error);
+    if (error) {
+        Serial.print("deserializeJson() failed: ");
+        Serial.println(error.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool WeatherClient::getJson(const String& url, uint32_t timeoutMs, const JsonSchema& schema, JsonSaxHandler& handler) {
+    if (!beginGet(url, timeoutMs)) return false;
+    HttpBodyStream body(_http.getStream(), chunkedResponse(), _http.getSize());
+    JsonSaxParser parser(schema, handler);
+    bool ok = parser.parse(body);
+    endGet(body, ok);
+    if (!ok) {
+        Serial.printf("JSON parse failed after %u bytes: %s\n", (unsigned)parser.bytesParsed(), parser.error());
+    }
+    return ok;
+}
+
+void WeatherClient::stop() {
+    _http.end();
+    _client.stop();
+    if (_requests > 0) {
+        Serial.printf("WeatherClient: %u requests, %u TLS handshakes, %lu ms handshaking, %lu body bytes\n",
+                      _requests, _handshakes, (unsigned long)_handshakeMs, (unsigned long)_bodyBytes);
+    }
+}
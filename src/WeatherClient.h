@@ -0,0 +1,59 @@
+#ifndef WEATHER_CLIENT_H
+#define WEATHER_CLIENT_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <HTTPClient.h>
+#include <WiFiClientSecure.h>
+#include "JsonSax.h"
+
+class HttpBodyStream;
+
+#define WEATHER_API_HOST "weather.googleapis.com"
+#define WEATHER_API_PORT 443
+
+// One TLS connection to the Google Weather API, reused by every request made
+// through it in a wake (FetchScheduler keeps one per concurrent connection).
+// HTTP keep-alive lets every request after the first skip the TLS handshake;
+// a new connection is only made when the server has closed it.
+class WeatherClient {
+public:
+    // slot numbers the concurrent connections from 0, so per-connection
+    // resources (the JSON document arenas) can be picked without locking
+    explicit WeatherClient(uint8_t slot = 0);
+
+    // GET url and deserialise the body straight off the connection through
+    // the filter. Logs the body size and the lowest free heap seen meanwhile.
+    bool getJson(const String& url, uint32_t timeoutMs, JsonDocument& filter, JsonDocument& doc);
+    // GET url and stream the body through the schema's parser into handler,
+    // with no document in between
+    bool getJson(const String& url, uint32_t timeoutMs, const JsonSchema& schema, JsonSaxHandler& handler);
+
+    // Close the connection and log the handshake totals
+    void stop();
+
+    uint8_t slot() const { return _slot; }
+    uint16_t requests() const { return _requests; }
+    uint16_t handshakes() const { return _handshakes; }
+    uint32_t handshakeMs() const { return _handshakeMs; }
+    // Response body bytes read over this connection
+    uint32_t bodyBytes() const { return _bodyBytes; }
+
+private:
+    WiFiClientSecure _client;
+    HTTPClient _http;
+    uint8_t _slot;
+    uint16_t _requests;
+    uint16_t _handshakes;
+    uint32_t _handshakeMs;
+    uint32_t _bodyBytes;
+    uint32_t _heapBefore; // Free heap when the current request started
+
+    bool connect();
+    int sendGet(const String& url, uint32_t timeoutMs);
+    bool beginGet(const String& url, uint32_t timeoutMs);
+    bool chunkedResponse();
+    void endGet(HttpBodyStream& body, bool complete);
+};
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef WEATHER_DATA_H
+#define WEATHER_DATA_H
+
+#include <Arduino.h>
+#include <type_traits>
+#include "WeatherIconIds.h"
+
+// These structs are stored as-is (WeatherStorage saves and loads them with a
+// single memcpy), so they hold no pointers or Strings and their layout is
+// pinned by the static_asserts below. Changing a field changes the stored
+// format.
+//
+// They also live in RTC memory, which keeps its contents across deep sleep
+// but would be overwritten by a constructor on every wake. So they have no
+// default member initialisers and stay trivially default-constructible;
+// clearWeatherData() and friends set the "no data" values instead.
+
+#define CONDITION_TEXT_LEN 64
+
+// Minutes after local midnight
+typedef uint16_t TimeOfDay;
+#define TIME_OF_DAY_NONE 0xFFFF
+
+// 0 = Sunday
+#define WEEKDAY_NONE 0xFF
+
+inline const char* weekdayName(uint8_t weekday) {
+  static const char* const names[] = {"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
+  return weekday < 7 ? names[weekday] : "";
+}
+
+// "HH:MM" into buf (at least 6 bytes), or "" when unknown
+inline void formatTimeOfDay(TimeOfDay t, char* buf) {
+  if (t == TIME_OF_DAY_NONE) {
+    buf[0] = 0;
+    return;
+  }
+  snprintf(buf, 6, "%02u:%02u", (uint8_t)(t / 60 % 24), (uint8_t)(t % 60));
+}
+
+struct WeatherData {
+  char conditionText[CONDITION_TEXT_LEN];
+  WeatherIconId iconId;
+  float temp;
+  float feelsLike;
+  float windSpeed;
+  float windGust;
+  int windDirection;
+  int humidity;
+  int precipitationProbability;
+  int uvIndex;
+  int pressure;
+  bool valid;
+  float indoorTemp;     // -100 indicates no data
+  float indoorHumidity; // -1 indicates no data
+  float indoorPressure; // -1 indicates no data
+};
+
+struct DailyForecast {
+  char conditionText[CONDITION_TEXT_LEN];
+  WeatherIconId iconId;
+  uint8_t weekday;
+  TimeOfDay sunrise;
+  TimeOfDay sunset;
+  float tempHigh;
+  float tempLow;
+
+  DailyForecast() = default;
+  DailyForecast(uint8_t day, WeatherIconId icon, const char* ct, float th, float tl, TimeOfDay sr, TimeOfDay ss)
+    : iconId(icon), weekday(day), sunrise(sr), sunset(ss), tempHigh(th), tempLow(tl) {
+    strlcpy(conditionText, ct, sizeof(conditionText));
+  }
+};
+
+struct HourlyData {
+  int hour; // 0-23
+  float temp;
+  int rainProb;
+  float actualTemp; // -100 indicates no data
+  float actualRain; // -1 indicates no data
+  float indoorTemp; // -100 indicates no data
+  float pressure;   // -1 indicates no data (as for the other pressures)
+  float actualPressure;
+  float indoorPressure;
+};
+
+inline void clearWeatherData(WeatherData& w) {
+  memset(&w, 0, sizeof(w));
+  w.iconId = ICON_UNKNOWN;
+  w.indoorTemp = -100.0;
+  w.indoorHumidity = -1.0;
+  w.indoorPressure = -1.0;
+}
+
+inline void clearDailyForecast(DailyForecast& d) {
+  memset(&d, 0, sizeof(d));
+  d.iconId = ICON_UNKNOWN;
+  d.weekday = WEEKDAY_NONE;
+  d.sunrise = TIME_OF_DAY_NONE;
+  d.sunset = TIME_OF_DAY_NONE;
+}
+
+inline void clearHourlyData(HourlyData& h, int hour) {
+  h.hour = hour;
+  h.temp = -100.0;
+  h.rainProb = -1;
+  h.actualTemp = -100.0;
+  h.actualRain = -1.0;
+  h.indoorTemp = -100.0;
+  h.pressure = -1.0;
+  h.actualPressure = -1.0;
+  h.indoorPressure = -1.0;
+}
+
+static_assert(std::is_trivially_copyable<WeatherData>::value, "WeatherData is stored with memcpy");
+static_assert(std::is_trivially_copyable<DailyForecast>::value, "DailyForecast is stored with memcpy");
+static_assert(std::is_trivially_copyable<HourlyData>::value, "HourlyData is stored with memcpy");
+static_assert(std::is_trivially_default_constructible<WeatherData>::value, "WeatherData is kept in RTC memory");
+static_assert(std::is_trivially_default_constructible<DailyForecast>::value, "DailyForecast is kept in RTC memory");
+static_assert(std::is_trivially_default_constructible<HourlyData>::value, "HourlyData is kept in RTC memory");
+static_assert(sizeof(WeatherIconId) == 1, "icon IDs are stored as one byte");
+static_assert(sizeof(WeatherData) == 120, "WeatherData layout changed");
+static_assert(sizeof(DailyForecast) == 80, "DailyForecast layout changed");
+static_assert(sizeof(HourlyData) == 36, "HourlyData layout changed");
+
+#endif
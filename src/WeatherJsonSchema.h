@@ -0,0 +1,404 @@
+// Generated by generate_json_schema.py - do not edit.
+#ifndef WEATHER_JSON_SCHEMA_H
+#define WEATHER_JSON_SCHEMA_H
+
+#include "JsonSax.h"
+
+enum WeatherJsonKey : uint8_t {
+    JSON_KEY_UNKNOWN = 0,
+    JSON_KEY_FORECAST_DAYS,
+    JSON_KEY_DISPLAY_DATE,
+    JSON_KEY_YEAR,
+    JSON_KEY_MONTH,
+    JSON_KEY_DAY,
+    JSON_KEY_MAX_TEMPERATURE,
+    JSON_KEY_DEGREES,
+    JSON_KEY_MIN_TEMPERATURE,
+    JSON_KEY_DAYTIME_FORECAST,
+    JSON_KEY_WEATHER_CONDITION,
+    JSON_KEY_DESCRIPTION,
+    JSON_KEY_TEXT,
+    JSON_KEY_ICON_BASE_URI,
+    JSON_KEY_TYPE,
+    JSON_KEY_SUN_EVENTS,
+    JSON_KEY_SUNRISE_TIME,
+    JSON_KEY_SUNSET_TIME,
+    JSON_KEY_FORECAST_HOURS,
+    JSON_KEY_INTERVAL,
+    JSON_KEY_START_TIME,
+    JSON_KEY_TEMPERATURE,
+    JSON_KEY_PRECIPITATION,
+    JSON_KEY_PROBABILITY,
+    JSON_KEY_PERCENT,
+    JSON_KEY_PRESSURE,
+    JSON_KEY_MEAN_SEA_LEVEL_MILLIBARS,
+    JSON_KEY_AIR_PRESSURE,
+    JSON_KEY_HISTORY_HOURS,
+    JSON_KEY_RAINFALL_M_M,
+    JSON_KEY_FEELS_LIKE_TEMPERATURE,
+    JSON_KEY_WIND,
+    JSON_KEY_SPEED,
+    JSON_KEY_VALUE,
+    JSON_KEY_GUST,
+    JSON_KEY_DIRECTION,
+    JSON_KEY_RELATIVE_HUMIDITY,
+    JSON_KEY_UV_INDEX,
+    JSON_KEY_COUNT
+};
+
+static constexpr const char* weatherJsonKeyNames[JSON_KEY_COUNT] = {
+    "",
+    "forecastDays",
+    "displayDate",
+    "year",
+    "month",
+    "day",
+    "maxTemperature",
+    "degrees",
+    "minTemperature",
+    "daytimeForecast",
+    "weatherCondition",
+    "description",
+    "text",
+    "iconBaseUri",
+    "type",
+    "sunEvents",
+    "sunriseTime",
+    "sunsetTime",
+    "forecastHours",
+    "interval",
+    "startTime",
+    "temperature",
+    "precipitation",
+    "probability",
+    "percent",
+    "pressure",
+    "meanSeaLevelMillibars",
+    "airPressure",
+    "historyHours",
+    "rainfallMM",
+    "feelsLikeTemperature",
+    "wind",
+    "speed",
+    "value",
+    "gust",
+    "direction",
+    "relativeHumidity",
+    "uvIndex",
+};
+
+// Perfect hash of the keys: FNV-1a % WEATHER_JSON_KEY_HASH_SIZE
+#define WEATHER_JSON_KEY_HASH_SIZE 174
+
+static constexpr JsonKeySlot weatherJsonKeySlots[WEATHER_JSON_KEY_HASH_SIZE] = {
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x7B80C780u, JSON_KEY_SPEED},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x75F9FA5Au, JSON_KEY_PERCENT},
+    {0xE44F21FDu, JSON_KEY_DAY},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x1414F107u, JSON_KEY_WIND},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0xAE7F4D1Cu, JSON_KEY_YEAR},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x345DBF78u, JSON_KEY_SUN_EVENTS},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0xC2A5A414u, JSON_KEY_AIR_PRESSURE},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0xA8BCC3B9u, JSON_KEY_MAX_TEMPERATURE},
+    {0xAA3CBAC6u, JSON_KEY_UV_INDEX},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0xAF5442EEu, JSON_KEY_DEGREES},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0xEC94BD68u, JSON_KEY_RELATIVE_HUMIDITY},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x5127F14Du, JSON_KEY_TYPE},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0xEFCA576Du, JSON_KEY_ICON_BASE_URI},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x64A95D7Cu, JSON_KEY_PROBABILITY},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0xFE136722u, JSON_KEY_MEAN_SEA_LEVEL_MILLIBARS},
+    {0x346F3B69u, JSON_KEY_DESCRIPTION},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0xFE3D81A9u, JSON_KEY_DISPLAY_DATE},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x39D8DCE8u, JSON_KEY_RAINFALL_M_M},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0xCEDD8578u, JSON_KEY_INTERVAL},
+    {0x1F08EAABu, JSON_KEY_FORECAST_DAYS},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0xD67A0605u, JSON_KEY_MONTH},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0xCFA8A3A2u, JSON_KEY_PRESSURE},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x425ED3CAu, JSON_KEY_VALUE},
+    {0x3B8204B1u, JSON_KEY_DAYTIME_FORECAST},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x4A5DE925u, JSON_KEY_SUNRISE_TIME},
+    {0x84B76F4Eu, JSON_KEY_HISTORY_HOURS},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x51718F36u, JSON_KEY_SUNSET_TIME},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x3F5E4CD0u, JSON_KEY_PRECIPITATION},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0xC777E78Fu, JSON_KEY_FORECAST_HOURS},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0xE9F2A935u, JSON_KEY_TEMPERATURE},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0xDF6DC76Au, JSON_KEY_DIRECTION},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x4E8F1861u, JSON_KEY_FEELS_LIKE_TEMPERATURE},
+    {0xBDE64E3Eu, JSON_KEY_TEXT},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x107B9454u, JSON_KEY_WEATHER_CONDITION},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x0107D3D3u, JSON_KEY_MIN_TEMPERATURE},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x0A9E6D0Eu, JSON_KEY_START_TIME},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+    {0x50DC5F0Eu, JSON_KEY_GUST},
+    {0x00000000u, JSON_KEY_UNKNOWN},
+};
+
+// Reported to JsonSaxHandler; 0 is never reported
+enum WeatherJsonField : uint8_t {
+    FIELD_NONE = 0,
+    FIELD_DAY,
+    FIELD_DAY_YEAR,
+    FIELD_DAY_MONTH,
+    FIELD_DAY_DAY,
+    FIELD_DAY_MAX_TEMP,
+    FIELD_DAY_MIN_TEMP,
+    FIELD_DAY_CONDITION_TEXT,
+    FIELD_DAY_ICON_URI,
+    FIELD_DAY_CONDITION_TYPE,
+    FIELD_DAY_SUNRISE,
+    FIELD_DAY_SUNSET,
+    FIELD_HOUR,
+    FIELD_HOUR_START,
+    FIELD_HOUR_TEMP,
+    FIELD_HOUR_RAIN_PROB,
+    FIELD_HOUR_PRESSURE,
+    FIELD_HOUR_AIR_PRESSURE,
+    FIELD_HISTORY,
+    FIELD_HISTORY_START,
+    FIELD_HISTORY_TEMP,
+    FIELD_HISTORY_RAIN,
+    FIELD_HISTORY_PRESSURE,
+    FIELD_HISTORY_AIR_PRESSURE,
+    FIELD_CURRENT,
+    FIELD_CURRENT_CONDITION_TEXT,
+    FIELD_CURRENT_ICON_URI,
+    FIELD_CURRENT_CONDITION_TYPE,
+    FIELD_CURRENT_TEMP,
+    FIELD_CURRENT_FEELS_LIKE,
+    FIELD_CURRENT_WIND_SPEED,
+    FIELD_CURRENT_WIND_GUST,
+    FIELD_CURRENT_WIND_DIRECTION,
+    FIELD_CURRENT_HUMIDITY,
+    FIELD_CURRENT_RAIN_PROB,
+    FIELD_CURRENT_UV_INDEX,
+    FIELD_CURRENT_PRESSURE,
+    FIELD_COUNT
+};
+
+static constexpr JsonSchemaNode dailyJsonNodes[] = {
+    {JSON_NODE_NONE, JSON_KEY_UNKNOWN, FIELD_NONE, 0}, // 0
+    {0, JSON_KEY_FORECAST_DAYS, FIELD_DAY, JSON_NODE_RECORDS}, // 1
+    {1, JSON_KEY_DISPLAY_DATE, FIELD_NONE, 0}, // 2
+    {2, JSON_KEY_YEAR, FIELD_DAY_YEAR, 0}, // 3
+    {2, JSON_KEY_MONTH, FIELD_DAY_MONTH, 0}, // 4
+    {2, JSON_KEY_DAY, FIELD_DAY_DAY, 0}, // 5
+    {1, JSON_KEY_MAX_TEMPERATURE, FIELD_NONE, 0}, // 6
+    {6, JSON_KEY_DEGREES, FIELD_DAY_MAX_TEMP, 0}, // 7
+    {1, JSON_KEY_MIN_TEMPERATURE, FIELD_NONE, 0}, // 8
+    {8, JSON_KEY_DEGREES, FIELD_DAY_MIN_TEMP, 0}, // 9
+    {1, JSON_KEY_DAYTIME_FORECAST, FIELD_NONE, 0}, // 10
+    {10, JSON_KEY_WEATHER_CONDITION, FIELD_NONE, 0}, // 11
+    {11, JSON_KEY_DESCRIPTION, FIELD_NONE, 0}, // 12
+    {12, JSON_KEY_TEXT, FIELD_DAY_CONDITION_TEXT, 0}, // 13
+    {11, JSON_KEY_ICON_BASE_URI, FIELD_DAY_ICON_URI, 0}, // 14
+    {11, JSON_KEY_TYPE, FIELD_DAY_CONDITION_TYPE, 0}, // 15
+    {1, JSON_KEY_SUN_EVENTS, FIELD_NONE, 0}, // 16
+    {16, JSON_KEY_SUNRISE_TIME, FIELD_DAY_SUNRISE, 0}, // 17
+    {16, JSON_KEY_SUNSET_TIME, FIELD_DAY_SUNSET, 0}, // 18
+};
+
+static constexpr JsonSchema dailyJsonSchema = {
+    dailyJsonNodes, 19, weatherJsonKeySlots, WEATHER_JSON_KEY_HASH_SIZE, weatherJsonKeyNames};
+
+static constexpr JsonSchemaNode hourlyJsonNodes[] = {
+    {JSON_NODE_NONE, JSON_KEY_UNKNOWN, FIELD_NONE, 0}, // 0
+    {0, JSON_KEY_FORECAST_HOURS, FIELD_HOUR, JSON_NODE_RECORDS}, // 1
+    {1, JSON_KEY_INTERVAL, FIELD_NONE, 0}, // 2
+    {2, JSON_KEY_START_TIME, FIELD_HOUR_START, 0}, // 3
+    {1, JSON_KEY_TEMPERATURE, FIELD_NONE, 0}, // 4
+    {4, JSON_KEY_DEGREES, FIELD_HOUR_TEMP, 0}, // 5
+    {1, JSON_KEY_PRECIPITATION, FIELD_NONE, 0}, // 6
+    {6, JSON_KEY_PROBABILITY, FIELD_NONE, 0}, // 7
+    {7, JSON_KEY_PERCENT, FIELD_HOUR_RAIN_PROB, 0}, // 8
+    {1, JSON_KEY_PRESSURE, FIELD_NONE, 0}, // 9
+    {9, JSON_KEY_MEAN_SEA_LEVEL_MILLIBARS, FIELD_HOUR_PRESSURE, 0}, // 10
+    {1, JSON_KEY_AIR_PRESSURE, FIELD_NONE, 0}, // 11
+    {11, JSON_KEY_MEAN_SEA_LEVEL_MILLIBARS, FIELD_HOUR_AIR_PRESSURE, 0}, // 12
+};
+
+static constexpr JsonSchema hourlyJsonSchema = {
+    hourlyJsonNodes, 13, weatherJsonKeySlots, WEATHER_JSON_KEY_HASH_SIZE, weatherJsonKeyNames};
+
+static constexpr JsonSchemaNode historyJsonNodes[] = {
+    {JSON_NODE_NONE, JSON_KEY_UNKNOWN, FIELD_NONE, 0}, // 0
+    {0, JSON_KEY_HISTORY_HOURS, FIELD_HISTORY, JSON_NODE_RECORDS}, // 1
+    {1, JSON_KEY_INTERVAL, FIELD_NONE, 0}, // 2
+    {2, JSON_KEY_START_TIME, FIELD_HISTORY_START, 0}, // 3
+    {1, JSON_KEY_TEMPERATURE, FIELD_NONE, 0}, // 4
+    {4, JSON_KEY_DEGREES, FIELD_HISTORY_TEMP, 0}, // 5
+    {1, JSON_KEY_PRECIPITATION, FIELD_NONE, 0}, // 6
+    {6, JSON_KEY_RAINFALL_M_M, FIELD_HISTORY_RAIN, 0}, // 7
+    {1, JSON_KEY_PRESSURE, FIELD_NONE, 0}, // 8
+    {8, JSON_KEY_MEAN_SEA_LEVEL_MILLIBARS, FIELD_HISTORY_PRESSURE, 0}, // 9
+    {1, JSON_KEY_AIR_PRESSURE, FIELD_NONE, 0}, // 10
+    {10, JSON_KEY_MEAN_SEA_LEVEL_MILLIBARS, FIELD_HISTORY_AIR_PRESSURE, 0}, // 11
+};
+
+static constexpr JsonSchema historyJsonSchema = {
+    historyJsonNodes, 12, weatherJsonKeySlots, WEATHER_JSON_KEY_HASH_SIZE, weatherJsonKeyNames};
+
+static constexpr JsonSchemaNode currentJsonNodes[] = {
+    {JSON_NODE_NONE, JSON_KEY_UNKNOWN, FIELD_CURRENT, JSON_NODE_RECORDS}, // 0
+    {0, JSON_KEY_WEATHER_CONDITION, FIELD_NONE, 0}, // 1
+    {1, JSON_KEY_DESCRIPTION, FIELD_NONE, 0}, // 2
+    {2, JSON_KEY_TEXT, FIELD_CURRENT_CONDITION_TEXT, 0}, // 3
+    {1, JSON_KEY_ICON_BASE_URI, FIELD_CURRENT_ICON_URI, 0}, // 4
+    {1, JSON_KEY_TYPE, FIELD_CURRENT_CONDITION_TYPE, 0}, // 5
+    {0, JSON_KEY_TEMPERATURE, FIELD_NONE, 0}, // 6
+    {6, JSON_KEY_DEGREES, FIELD_CURRENT_TEMP, 0}, // 7
+    {0, JSON_KEY_FEELS_LIKE_TEMPERATURE, FIELD_NONE, 0}, // 8
+    {8, JSON_KEY_DEGREES, FIELD_CURRENT_FEELS_LIKE, 0}, // 9
+    {0, JSON_KEY_WIND, FIELD_NONE, 0}, // 10
+    {10, JSON_KEY_SPEED, FIELD_NONE, 0}, // 11
+    {11, JSON_KEY_VALUE, FIELD_CURRENT_WIND_SPEED, 0}, // 12
+    {10, JSON_KEY_GUST, FIELD_NONE, 0}, // 13
+    {13, JSON_KEY_VALUE, FIELD_CURRENT_WIND_GUST, 0}, // 14
+    {10, JSON_KEY_DIRECTION, FIELD_NONE, 0}, // 15
+    {15, JSON_KEY_DEGREES, FIELD_CURRENT_WIND_DIRECTION, 0}, // 16
+    {0, JSON_KEY_RELATIVE_HUMIDITY, FIELD_CURRENT_HUMIDITY, 0}, // 17
+    {0, JSON_KEY_PRECIPITATION, FIELD_NONE, 0}, // 18
+    {18, JSON_KEY_PROBABILITY, FIELD_NONE, 0}, // 19
+    {19, JSON_KEY_PERCENT, FIELD_CURRENT_RAIN_PROB, 0}, // 20
+    {0, JSON_KEY_UV_INDEX, FIELD_CURRENT_UV_INDEX, 0}, // 21
+    {0, JSON_KEY_AIR_PRESSURE, FIELD_NONE, 0}, // 22
+    {22, JSON_KEY_MEAN_SEA_LEVEL_MILLIBARS, FIELD_CURRENT_PRESSURE, 0}, // 23
+};
+
+static constexpr JsonSchema currentJsonSchema = {
+    currentJsonNodes, 24, weatherJsonKeySlots, WEATHER_JSON_KEY_HASH_SIZE, weatherJsonKeyNames};
+
+#endif
@@ -1,145 +1,325 @@
 #include "WeatherStorage.h"
+#include <esp_rom_crc.h>
+#include <type_traits>
 
-void WeatherStorage::begin() {
-    // No explicit initialization needed for Preferences here, handled in methods
+// Working copy of the stored data. The structs are kept as they are in
+// memory (see WeatherData.h), so saving and loading are plain copies.
+struct RtcWeatherStore {
+    uint16_t schema;
+    uint16_t size;
+    int16_t day;
+    uint8_t status;         // DATA_* parts held for the day
+    uint8_t wakesSinceFlush; // Wakes that ended with changes not yet in NVS
+    int8_t historyHour;      // See WeatherStorage::historyHour()
+    uint32_t saves;          // stageWeatherData() calls kept in RTC memory
+    uint32_t flushes;        // NVS sessions that wrote anything
+    uint32_t bytesWritten;   // NVS payload bytes written
+    CacheEntry cache[CACHE_ENTRIES]; // Indexed by DATA_* bit number
+    // What NVS holds, so commit() only writes keys that differ
+    int16_t nvsDay, nvsStatus;
+    uint32_t nvsCurrentCrc, nvsDailyCrc, nvsHourlyCrc, nvsCacheCrc;
+    WeatherData current;
+    DailyForecast daily[5];
+    HourlyData hourly[24];
+    uint32_t crc;            // Over everything above
+};
+
+static const uint32_t cacheTtl[CACHE_ENTRIES] = {CACHE_TTL_CURRENT, CACHE_TTL_DAILY, CACHE_TTL_HOURLY, CACHE_TTL_HISTORY};
+static const char* const cacheNames[CACHE_ENTRIES] = {"Current", "Daily", "Hourly", "History"};
+
+// A constructor would run on every wake and wipe the store, so it must be
+// trivially constructible to survive deep sleep
+static_assert(std::is_trivially_default_constructible<RtcWeatherStore>::value,
+              "RtcWeatherStore must not be re-initialised on wake");
+
+// Zeroed on a cold boot, so it fails the schema check until restored
+RTC_DATA_ATTR static RtcWeatherStore rtcStore;
+
+static uint32_t blobCrc(const void* data, size_t size) {
+    return esp_rom_crc32_le(0, (const uint8_t*)data, size);
 }
 
-void WeatherStorage::saveWeatherData(int typeMask, int currentHour, int currentDay, const WeatherData& current, const DailyForecast daily[], const HourlyData hourly[]) {
-    preferences.begin("weather", false);
-    
-    int savedHour = preferences.getInt("hour", -1);
-    int savedDay = preferences.getInt("day", -1);
-    int status = preferences.getInt("status", DATA_NONE);
+static uint32_t storeCrc() {
+    return blobCrc(&rtcStore, offsetof(RtcWeatherStore, crc));
+}
 
-    // If day changed, reset everything
-    if (savedDay != currentDay) {
-        status = DATA_NONE;
-        preferences.putInt("day", currentDay);
-        preferences.putInt("hour", currentHour);
+static void sealStore() {
+    rtcStore.crc = storeCrc();
+}
+
+static int8_t newestHistoryHour(const HourlyData hourly[]) {
+    int newest = -1;
+    for (int i = 23; i >= 0 && newest < 0; i--) {
+        if (hourly[i].actualTemp != -100.0f) newest = i;
     }
-    // If hour changed (but day is same), keep Daily, clear others
-    else if (savedHour != currentHour) {
-        status &= DATA_DAILY;
-        preferences.putInt("hour", currentHour);
+    for (int i = 0; i < newest; i++) {
+        if (hourly[i].actualTemp == -100.0f) return -1; // Gap
+    }
+    return newest;
+}
+
+static uint32_t hourlyFieldCrc(uint32_t crc, float HourlyData::*field) {
+    for (int i = 0; i < 24; i++) {
+        crc = esp_rom_crc32_le(crc, (const uint8_t*)&(rtcStore.hourly[i].*field), sizeof(float));
+    }
+    return crc;
+}
+
+// Hash of what an endpoint provides, leaving out the indoor readings and
+// the other endpoint's half of the hourly array
+static uint32_t contentHash(int index) {
+    uint32_t crc = 0;
+    switch (1 << index) {
+        case DATA_CURRENT:
+            return blobCrc(&rtcStore.current, offsetof(WeatherData, indoorTemp));
+        case DATA_DAILY:
+            return blobCrc(rtcStore.daily, sizeof(rtcStore.daily));
+        case DATA_HOURLY:
+            crc = hourlyFieldCrc(crc, &HourlyData::temp);
+            crc = hourlyFieldCrc(crc, &HourlyData::pressure);
+            for (int i = 0; i < 24; i++) {
+                crc = esp_rom_crc32_le(crc, (const uint8_t*)&rtcStore.hourly[i].rainProb, sizeof(int));
+            }
+            return crc;
+        default:
+            crc = hourlyFieldCrc(crc, &HourlyData::actualTemp);
+            crc = hourlyFieldCrc(crc, &HourlyData::actualRain);
+            return hourlyFieldCrc(crc, &HourlyData::actualPressure);
+    }
+}
+
+// Opens the wake's transaction: makes sure the RTC copy is usable before
+// anything is loaded or staged
+void WeatherStorage::begin() {
+    if (!rtcValid()) restoreFromNvs();
+}
+
+bool WeatherStorage::rtcValid() const {
+    return rtcStore.schema == STORAGE_SCHEMA_VERSION && rtcStore.size == sizeof(RtcWeatherStore) && rtcStore.crc == storeCrc();
+}
+
+// Only a blob of exactly the expected size is read, so one written with a
+// different struct layout is ignored rather than copied over the data
+bool WeatherStorage::loadBlob(const char* key, void* data, size_t size) {
+    if (preferences.getBytesLength(key) != size) return false;
+    return preferences.getBytes(key, data, size) == size;
+}
+
+void WeatherStorage::restoreFromNvs() {
+    bool coldBoot = rtcStore.schema != STORAGE_SCHEMA_VERSION || rtcStore.size != sizeof(RtcWeatherStore);
+    Serial.printf("RTC weather store %s, restoring from NVS\n", coldBoot ? "empty (cold boot)" : "failed CRC check");
+    unsigned long start = millis();
+
+    rtcStore = RtcWeatherStore();
+    rtcStore.schema = STORAGE_SCHEMA_VERSION;
+    rtcStore.size = sizeof(RtcWeatherStore);
+
+    preferences.begin("weather", true); // Read-only mode
+    rtcStore.day = rtcStore.nvsDay = preferences.getInt("day", -1);
+    int status = rtcStore.nvsStatus = preferences.getInt("status", DATA_NONE);
+    // A key that is missing or the wrong size keeps CRC 0, so it is rewritten
+    if (loadBlob("current", &rtcStore.current, sizeof(WeatherData))) rtcStore.nvsCurrentCrc = blobCrc(&rtcStore.current, sizeof(WeatherData));
+    else status &= ~DATA_CURRENT;
+    if (loadBlob("daily", rtcStore.daily, sizeof(rtcStore.daily))) rtcStore.nvsDailyCrc = blobCrc(rtcStore.daily, sizeof(rtcStore.daily));
+    else status &= ~DATA_DAILY;
+    if (loadBlob("hourly", rtcStore.hourly, sizeof(rtcStore.hourly))) rtcStore.nvsHourlyCrc = blobCrc(rtcStore.hourly, sizeof(rtcStore.hourly));
+    else status &= ~(DATA_HOURLY | DATA_HISTORY);
+    // Without the fetch times everything is stale, which is still safe
+    if (loadBlob("cache", rtcStore.cache, sizeof(rtcStore.cache))) rtcStore.nvsCacheCrc = blobCrc(rtcStore.cache, sizeof(rtcStore.cache));
+    preferences.end();
+    rtcStore.historyHour = (status & (DATA_HOURLY | DATA_HISTORY)) ? newestHistoryHour(rtcStore.hourly) : -1;
+
+    rtcStore.status = status;
+    sealStore();
+    Serial.printf("Restored from NVS in %lu ms (Status: %d)\n", millis() - start, status);
+}
+
+void WeatherStorage::stageWeatherData(int typeMask, int currentDay, const WeatherData& current, const DailyForecast daily[], const HourlyData hourly[]) {
+    if (!rtcValid()) restoreFromNvs();
+
+    // If day changed, reset everything. Within a day, each part stays
+    // until its cache entry goes stale (see isStale).
+    if (rtcStore.day != currentDay) {
+        rtcStore.status = DATA_NONE;
+        rtcStore.day = currentDay;
+        rtcStore.historyHour = -1;
+        memset(rtcStore.cache, 0, sizeof(rtcStore.cache));
     }
 
     // Save specific data based on mask
     if (typeMask & DATA_CURRENT) {
-        WeatherDataRTC wd;
-        strlcpy(wd.conditionText, current.conditionText.c_str(), sizeof(wd.conditionText));
-        strlcpy(wd.iconName, current.iconName.c_str(), sizeof(wd.iconName));
-        wd.temp = current.temp;
-        wd.feelsLike = current.feelsLike;
-        wd.windSpeed = current.windSpeed;
-        wd.windGust = current.windGust;
-        wd.windDirection = current.windDirection;
-        wd.humidity = current.humidity;
-        wd.precipitationProbability = current.precipitationProbability;
-        wd.uvIndex = current.uvIndex;
-        wd.pressure = current.pressure;
-        wd.valid = current.valid;
-        preferences.putBytes("current", &wd, sizeof(wd));
+        rtcStore.current = current;
     }
 
     if (typeMask & DATA_DAILY) {
-        DailyForecastRTC dailyRTC[5];
-        for(int i=0; i<5; i++) {
-            strlcpy(dailyRTC[i].dayName, daily[i].dayName.c_str(), sizeof(dailyRTC[i].dayName));
-            strlcpy(dailyRTC[i].iconName, daily[i].iconName.c_str(), sizeof(dailyRTC[i].iconName));
-            strlcpy(dailyRTC[i].conditionText, daily[i].conditionText.c_str(), sizeof(dailyRTC[i].conditionText));
-            dailyRTC[i].tempHigh = daily[i].tempHigh;
-            dailyRTC[i].tempLow = daily[i].tempLow;
-            strlcpy(dailyRTC[i].sunrise, daily[i].sunrise.c_str(), sizeof(dailyRTC[i].sunrise));
-            strlcpy(dailyRTC[i].sunset, daily[i].sunset.c_str(), sizeof(dailyRTC[i].sunset));
-            dailyRTC[i].sunriseHour = daily[i].sunriseHour;
-            dailyRTC[i].sunsetHour = daily[i].sunsetHour;
-        }
-        preferences.putBytes("daily", dailyRTC, sizeof(dailyRTC));
+        memcpy(rtcStore.daily, daily, sizeof(rtcStore.daily));
     }
 
     // Both Hourly Forecast and History update the hourlyData array
     if ((typeMask & DATA_HOURLY) || (typeMask & DATA_HISTORY)) {
-        preferences.putBytes("hourly", (void*)hourly, sizeof(HourlyData) * 24);
+        memcpy(rtcStore.hourly, hourly, sizeof(rtcStore.hourly));
+        rtcStore.historyHour = newestHistoryHour(rtcStore.hourly);
     }
 
     // Update status
-    status |= typeMask;
-    preferences.putInt("status", status);
-
-    preferences.end();
-    Serial.printf("Weather data saved (Mask: %d, New Status: %d)\n", typeMask, status);
+    rtcStore.status |= typeMask;
+    rtcStore.saves++;
+    sealStore();
+    Serial.printf("Weather data staged (Mask: %d, New Status: %d)\n", typeMask, rtcStore.status);
 }
 
-int WeatherStorage::loadWeatherData(int currentHour, int currentDay, WeatherData& current, DailyForecast daily[], HourlyData hourly[]) {
-    preferences.begin("weather", true); // Read-only mode
-    int savedHour = preferences.getInt("hour", -1);
-    int savedDay = preferences.getInt("day", -1);
-    int status = preferences.getInt("status", DATA_NONE);
-    
+int WeatherStorage::loadWeatherData(int currentDay, WeatherData& current, DailyForecast daily[], HourlyData hourly[]) {
+    if (!rtcValid()) restoreFromNvs();
+    int savedDay = rtcStore.day;
+    int status = rtcStore.status;
+
     if (savedDay != currentDay) {
         Serial.printf("New day (Saved: %d, Current: %d). Resetting data.\n", savedDay, currentDay);
-        preferences.end();
         return DATA_NONE;
     }
 
     int validStatus = DATA_NONE;
 
-    // Load Daily (Valid as long as day matches)
+    // Everything held for the day is loaded; whether it needs fetching
+    // again is up to isStale()
     if (status & DATA_DAILY) {
-        DailyForecastRTC dailyRTC[5];
-        if (preferences.getBytes("daily", dailyRTC, sizeof(dailyRTC)) == sizeof(dailyRTC)) {
-            for(int i=0; i<5; i++) {
-                daily[i].dayName = String(dailyRTC[i].dayName);
-                daily[i].iconName = String(dailyRTC[i].iconName);
-                daily[i].conditionText = String(dailyRTC[i].conditionText);
-                daily[i].tempHigh = dailyRTC[i].tempHigh;
-                daily[i].tempLow = dailyRTC[i].tempLow;
-                daily[i].sunrise = String(dailyRTC[i].sunrise);
-                daily[i].sunset = String(dailyRTC[i].sunset);
-                daily[i].sunriseHour = dailyRTC[i].sunriseHour;
-                daily[i].sunsetHour = dailyRTC[i].sunsetHour;
-            }
-            validStatus |= DATA_DAILY;
-        }
+        memcpy(daily, rtcStore.daily, sizeof(rtcStore.daily));
+        validStatus |= DATA_DAILY;
     }
 
-    // Load Hour-Specific Data (Only if hour matches)
-    if (savedHour == currentHour) {
-        // Load Current
-        if (status & DATA_CURRENT) {
-            WeatherDataRTC wd;
-            if (preferences.getBytes("current", &wd, sizeof(wd)) == sizeof(wd)) {
-                current.conditionText = String(wd.conditionText);
-                current.iconName = String(wd.iconName);
-                current.temp = wd.temp;
-                current.feelsLike = wd.feelsLike;
-                current.windSpeed = wd.windSpeed;
-                current.windGust = wd.windGust;
-                current.windDirection = wd.windDirection;
-                current.humidity = wd.humidity;
-                current.precipitationProbability = wd.precipitationProbability;
-                current.uvIndex = wd.uvIndex;
-                current.pressure = wd.pressure;
-                current.valid = wd.valid;
-                validStatus |= DATA_CURRENT;
-            }
-        }
-    } else {
-        Serial.printf("New hour (Saved: %d, Current: %d). Retaining Daily, clearing others.\n", savedHour, currentHour);
+    if (status & DATA_CURRENT) {
+        current = rtcStore.current;
+        validStatus |= DATA_CURRENT;
     }
-    
-    // Load Hourly/History even if hour doesn't match (as long as day matches, which is checked above)
-    // We need this to preserve accumulated indoor temperature and history data
+
+    // Also keeps the accumulated indoor temperature and history data
     if ((status & DATA_HOURLY) || (status & DATA_HISTORY)) {
-        if (preferences.getBytes("hourly", (void*)hourly, sizeof(HourlyData) * 24) == sizeof(HourlyData) * 24) {
-                // If hour matches, we consider the forecast/history valid (no need to re-fetch)
-                if (savedHour == currentHour) {
-                    validStatus |= (status & (DATA_HOURLY | DATA_HISTORY));
-                }
-        }
+        memcpy(hourly, rtcStore.hourly, sizeof(rtcStore.hourly));
+        validStatus |= (status & (DATA_HOURLY | DATA_HISTORY));
     }
 
-    preferences.end();
     Serial.printf("Weather data loaded (Status: %d)\n", validStatus);
     return validStatus;
 }
+
+void WeatherStorage::recordFetch(int dataType, time_t now) {
+    if (!rtcValid()) return;
+    for (int i = 0; i < CACHE_ENTRIES; i++) {
+        if (!(dataType & (1 << i))) continue;
+        CacheEntry& entry = rtcStore.cache[i];
+        uint32_t hash = contentHash(i);
+        Serial.printf("%s data fetched (%s), fresh for %lu s\n", cacheNames[i],
+                      entry.fetchedAt == 0 ? "first today" : (hash == entry.hash ? "unchanged" : "changed"), (unsigned long)cacheTtl[i]);
+        entry.fetchedAt = now;
+        entry.ttl = cacheTtl[i];
+        entry.hash = hash;
+    }
+    sealStore();
+}
+
+bool WeatherStorage::isStale(int dataType, time_t now, int currentDay) const {
+    return staleMask(now, currentDay) & dataType;
+}
+
+int WeatherStorage::staleMask(time_t now, int currentDay) const {
+    if (!rtcValid() || rtcStore.day != currentDay) return DATA_ALL;
+    int stale = DATA_NONE;
+    for (int i = 0; i < CACHE_ENTRIES; i++) {
+        const CacheEntry& entry = rtcStore.cache[i];
+        if (!(rtcStore.status & (1 << i)) || entry.fetchedAt == 0 ||
+            (uint32_t)now + CACHE_TTL_SLACK >= entry.fetchedAt + entry.ttl) {
+            stale |= 1 << i;
+        }
+    }
+    return stale;
+}
+
+void WeatherStorage::logCache(time_t now) const {
+    if (!rtcValid()) return;
+    for (int i = 0; i < CACHE_ENTRIES; i++) {
+        const CacheEntry& entry = rtcStore.cache[i];
+        if (entry.fetchedAt == 0) {
+            Serial.printf("  %-8s never fetched\n", cacheNames[i]);
+        } else {
+            long age = (long)((uint32_t)now - entry.fetchedAt);
+            Serial.printf("  %-8s age %5ld s, ttl %5lu s, hash %08lx\n", cacheNames[i], age,
+                          (unsigned long)entry.ttl, (unsigned long)entry.hash);
+        }
+    }
+}
+
+int WeatherStorage::historyHour(int currentDay) const {
+    if (!rtcValid() || rtcStore.day != currentDay) return -1;
+    return rtcStore.historyHour;
+}
+
+bool WeatherStorage::pendingChanges() const {
+    return rtcStore.day != rtcStore.nvsDay || rtcStore.status != rtcStore.nvsStatus ||
+           blobCrc(&rtcStore.current, sizeof(WeatherData)) != rtcStore.nvsCurrentCrc ||
+           blobCrc(rtcStore.daily, sizeof(rtcStore.daily)) != rtcStore.nvsDailyCrc ||
+           blobCrc(rtcStore.hourly, sizeof(rtcStore.hourly)) != rtcStore.nvsHourlyCrc ||
+           blobCrc(rtcStore.cache, sizeof(rtcStore.cache)) != rtcStore.nvsCacheCrc;
+}
+
+// Returns the bytes written (0 when NVS already holds the value)
+size_t WeatherStorage::putIntIfChanged(const char* key, int16_t& stored, int value) {
+    if (stored == value) return 0;
+    size_t written = preferences.putInt(key, value);
+    if (written) stored = value;
+    return written;
+}
+
+size_t WeatherStorage::putBlobIfChanged(const char* key, uint32_t& storedCrc, const void* data, size_t size) {
+    uint32_t crc = blobCrc(data, size);
+    if (crc == storedCrc) return 0;
+    size_t written = preferences.putBytes(key, data, size);
+    if (written == size) storedCrc = crc;
+    return written;
+}
+
+void WeatherStorage::commit() {
+    if (!rtcValid()) return;
+    if (!pendingChanges()) {
+        Serial.println("NVS weather data up to date (0 bytes written this wake)");
+        return;
+    }
+    if (++rtcStore.wakesSinceFlush < STORAGE_NVS_FLUSH_WAKES) {
+        sealStore();
+        Serial.printf("NVS flush deferred (%d/%d wakes, NVS writes avoided: %lu, 0 bytes written this wake)\n",
+                      rtcStore.wakesSinceFlush, STORAGE_NVS_FLUSH_WAKES, (unsigned long)nvsWritesAvoided());
+        return;
+    }
+
+    // One session for the whole wake; each key at most once
+    unsigned long start = millis();
+    size_t bytes = 0;
+    preferences.begin("weather", false);
+    bytes += putIntIfChanged("day", rtcStore.nvsDay, rtcStore.day);
+    bytes += putIntIfChanged("status", rtcStore.nvsStatus, rtcStore.status);
+    bytes += putBlobIfChanged("current", rtcStore.nvsCurrentCrc, &rtcStore.current, sizeof(WeatherData));
+    bytes += putBlobIfChanged("daily", rtcStore.nvsDailyCrc, rtcStore.daily, sizeof(rtcStore.daily));
+    bytes += putBlobIfChanged("hourly", rtcStore.nvsHourlyCrc, rtcStore.hourly, sizeof(rtcStore.hourly));
+    bytes += putBlobIfChanged("cache", rtcStore.nvsCacheCrc, rtcStore.cache, sizeof(rtcStore.cache));
+    preferences.end();
+
+    rtcStore.wakesSinceFlush = 0;
+    rtcStore.flushes++;
+    rtcStore.bytesWritten += bytes;
+    sealStore();
+    Serial.printf("Committed weather data to NVS in %lu ms: %u bytes written this wake (%lu since cold boot)\n",
+                  millis() - start, (unsigned)bytes, (unsigned long)rtcStore.bytesWritten);
+    Serial.printf("NVS writes: %lu, avoided: %lu\n", (unsigned long)nvsWrites(), (unsigned long)nvsWritesAvoided());
+}
+
+uint32_t WeatherStorage::nvsWrites() const {
+    return rtcStore.flushes;
+}
+
+// Each stage used to be its own NVS write; now a commit covers several
+uint32_t WeatherStorage::nvsWritesAvoided() const {
+    return rtcStore.saves > rtcStore.flushes ? rtcStore.saves - rtcStore.flushes : 0;
+}
+
+uint32_t WeatherStorage::nvsBytesWritten() const {
+    return rtcStore.bytesWritten;
+}
@@ -11,42 +11,90 @@
 #define DATA_DAILY   2
 #define DATA_HOURLY  4
 #define DATA_HISTORY 8
+#define DATA_ALL     (DATA_CURRENT | DATA_DAILY | DATA_HOURLY | DATA_HISTORY)
 
-struct WeatherDataRTC {
-  char conditionText[64];
-  char iconName[32];
-  float temp;
-  float feelsLike;
-  float windSpeed;
-  float windGust;
-  int windDirection;
-  int humidity;
-  int precipitationProbability;
-  int uvIndex;
-  int pressure;
-  bool valid;
-};
+// How long each endpoint's data stays fresh, in seconds. Wakes land a little
+// after the hour, so data within CACHE_TTL_SLACK of expiring counts as stale.
+// The TTLs are multiples of two hours so the endpoints fall due on the same
+// wakes and every other wake can skip WiFi altogether (an hourly TTL is
+// always stale at the next wake). History lags by up to an hour as a result.
+#ifndef CACHE_TTL_CURRENT
+#define CACHE_TTL_CURRENT (2 * 3600)
+#endif
+#ifndef CACHE_TTL_DAILY
+#define CACHE_TTL_DAILY (12 * 3600)
+#endif
+#ifndef CACHE_TTL_HOURLY
+#define CACHE_TTL_HOURLY (4 * 3600)
+#endif
+#ifndef CACHE_TTL_HISTORY
+#define CACHE_TTL_HISTORY (2 * 3600)
+#endif
+#define CACHE_TTL_SLACK 300
+
+// One per DATA_* flag, indexed by its bit number
+#define CACHE_ENTRIES 4
 
-struct DailyForecastRTC {
-  char dayName[16];
-  char iconName[32];
-  char conditionText[64];
-  float tempHigh;
-  float tempLow;
-  char sunrise[8];
-  char sunset[8];
-  float sunriseHour;
-  float sunsetHour;
+struct CacheEntry {
+    uint32_t fetchedAt; // Epoch seconds, 0 if never fetched today
+    uint32_t ttl;
+    uint32_t hash;      // Of the data as fetched, to log whether it changed
 };
 
+// Bump when the layout of the stored structs changes
+#define STORAGE_SCHEMA_VERSION 4
+
+// Wakes that changed data may stay in RTC memory only before it is flushed
+// to NVS. Losing power (not deep sleep) loses at most this many hours.
+#ifndef STORAGE_NVS_FLUSH_WAKES
+#define STORAGE_NVS_FLUSH_WAKES 6
+#endif
+
+// Two-tier store: the working copy lives in RTC slow memory, which survives
+// deep sleep, and NVS flash is only a backup. NVS is read back after a cold
+// boot or when the RTC copy fails its CRC check.
+//
+// Each wake is one transaction: begin(), any number of stageWeatherData()
+// calls (RTC memory only), then commit(). When the NVS flush is due, commit
+// writes every key in one session, each at most once and only if its bytes
+// differ from what NVS already holds.
 class WeatherStorage {
 public:
     void begin();
-    void saveWeatherData(int typeMask, int currentHour, int currentDay, const WeatherData& current, const DailyForecast daily[], const HourlyData hourly[]);
-    int loadWeatherData(int currentHour, int currentDay, WeatherData& current, DailyForecast daily[], HourlyData hourly[]);
+    void stageWeatherData(int typeMask, int currentDay, const WeatherData& current, const DailyForecast daily[], const HourlyData hourly[]);
+    // Returns the DATA_* parts held for currentDay, however old
+    int loadWeatherData(int currentDay, WeatherData& current, DailyForecast daily[], HourlyData hourly[]);
+
+    // Per-endpoint cache: call recordFetch() after staging freshly fetched
+    // data, then ask isStale() / staleMask() whether a part needs fetching.
+    // Everything is stale on a new day or when it has never been fetched.
+    void recordFetch(int dataType, time_t now);
+    bool isStale(int dataType, time_t now, int currentDay) const;
+    int staleMask(time_t now, int currentDay) const;
+    void logCache(time_t now) const;
+
+    // Newest hour of currentDay with an observed (history) temperature, so
+    // only later hours need fetching. -1 after a day change or when an
+    // earlier hour is missing, meaning the whole day should be fetched.
+    int historyHour(int currentDay) const;
+
+    // Call once per wake, before sleeping
+    void commit();
+
+    // Since the last cold boot
+    uint32_t nvsWrites() const;
+    uint32_t nvsWritesAvoided() const;
+    uint32_t nvsBytesWritten() const;
 
 private:
     Preferences preferences;
+
+    bool loadBlob(const char* key, void* data, size_t size);
+    bool rtcValid() const;
+    void restoreFromNvs();
+    bool pendingChanges() const;
+    size_t putIntIfChanged(const char* key, int16_t& stored, int value);
+    size_t putBlobIfChanged(const char* key, uint32_t& storedCrc, const void* data, size_t size);
 };
 
 #endif
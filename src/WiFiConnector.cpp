@@ -0,0 +1,115 @@
+#include "WiFiConnector.h"
+#include <esp_rom_crc.h>
+
+// Last good connection and the connect-time totals, kept across deep sleep
+struct RtcWiFiCache {
+    bool valid;
+    uint32_t ssidCrc;          // Network the entry was made for
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint8_t connectsSinceDhcp; // Fast connects on the current lease
+    uint32_t ip, gateway, subnet, dns1, dns2;
+    uint16_t fastFailures;
+    uint16_t connects[WiFiConnector::PATH_COUNT]; // Indexed by the path that connected
+    uint32_t connectMs[WiFiConnector::PATH_COUNT];
+    uint32_t crc;              // Over everything above
+};
+
+static const char* const pathNames[WiFiConnector::PATH_COUNT] = {"none", "fast", "cached AP + DHCP", "full scan"};
+
+// Zeroed on a cold boot, so it fails the CRC check and starts empty
+RTC_DATA_ATTR static RtcWiFiCache rtcWiFi;
+
+static uint32_t cacheCrc() {
+    return esp_rom_crc32_le(0, (const uint8_t*)&rtcWiFi, offsetof(RtcWiFiCache, crc));
+}
+
+WiFiConnector::WiFiConnector() : _path(PATH_NONE), _connectMs(0) {}
+
+bool WiFiConnector::connect(const char* ssid, const char* password) {
+    if (rtcWiFi.crc != cacheCrc()) rtcWiFi = RtcWiFiCache();
+    uint32_t ssidCrc = esp_rom_crc32_le(0, (const uint8_t*)ssid, strlen(ssid));
+    unsigned long start = millis();
+
+    // The credentials come from secrets.h, so don't rewrite them to flash every wake
+    WiFi.persistent(false);
+    WiFi.mode(WIFI_STA);
+
+    bool connected = false;
+    if (rtcWiFi.valid && rtcWiFi.ssidCrc == ssidCrc) {
+        Path path = rtcWiFi.connectsSinceDhcp < WIFI_DHCP_REFRESH_CONNECTS ? PATH_FAST : PATH_DHCP;
+        connected = attempt(path, ssid, password);
+        if (!connected) {
+            Serial.println("Cached access point failed, connecting normally");
+            rtcWiFi.valid = false;
+            rtcWiFi.fastFailures++;
+            WiFi.disconnect();
+            // Zero addresses switch DHCP back on
+            WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0));
+        }
+    }
+    if (!connected) connected = attempt(PATH_FULL, ssid, password);
+
+    _connectMs = millis() - start;
+    if (connected) {
+        rtcWiFi.connects[_path]++;
+        rtcWiFi.connectMs[_path] += _connectMs;
+        saveCache(ssidCrc);
+    } else {
+        _path = PATH_NONE;
+    }
+    rtcWiFi.crc = cacheCrc();
+    Serial.printf("WiFi %s in %lu ms (%s)\n", connected ? "connected" : "failed", (unsigned long)_connectMs, pathNames[_path]);
+    logStats();
+    return connected;
+}
+
+bool WiFiConnector::attempt(Path path, const char* ssid, const char* password) {
+    if (path == PATH_FAST) {
+        WiFi.config(IPAddress(rtcWiFi.ip), IPAddress(rtcWiFi.gateway), IPAddress(rtcWiFi.subnet),
+                    IPAddress(rtcWiFi.dns1), IPAddress(rtcWiFi.dns2));
+    }
+    if (path == PATH_FULL) {
+        WiFi.begin(ssid, password);
+    } else {
+        WiFi.begin(ssid, password, rtcWiFi.channel, rtcWiFi.bssid);
+    }
+
+    uint32_t timeoutMs = path == PATH_FULL ? WIFI_FULL_TIMEOUT_MS : WIFI_FAST_TIMEOUT_MS;
+    Serial.printf("Connecting to WiFi (%s)", pathNames[path]);
+    unsigned long start = millis();
+    uint16_t polls = 0;
+    while (WiFi.status() != WL_CONNECTED && millis() - start < timeoutMs) {
+        delay(50);
+        if (++polls % 10 == 0) Serial.print(".");
+    }
+    Serial.println();
+    if (WiFi.status() != WL_CONNECTED) return false;
+    _path = path;
+    return true;
+}
+
+void WiFiConnector::saveCache(uint32_t ssidCrc) {
+    const uint8_t* bssid = WiFi.BSSID();
+    if (!bssid) return;
+    rtcWiFi.valid = true;
+    rtcWiFi.ssidCrc = ssidCrc;
+    memcpy(rtcWiFi.bssid, bssid, sizeof(rtcWiFi.bssid));
+    rtcWiFi.channel = WiFi.channel();
+    rtcWiFi.ip = WiFi.localIP();
+    rtcWiFi.gateway = WiFi.gatewayIP();
+    rtcWiFi.subnet = WiFi.subnetMask();
+    rtcWiFi.dns1 = WiFi.dnsIP(0);
+    rtcWiFi.dns2 = WiFi.dnsIP(1);
+    rtcWiFi.connectsSinceDhcp = _path == PATH_FAST ? rtcWiFi.connectsSinceDhcp + 1 : 0;
+}
+
+void WiFiConnector::logStats() const {
+    Serial.print("WiFi connects since power-on:");
+    for (uint8_t path = PATH_FAST; path < PATH_COUNT; path++) {
+        uint16_t count = rtcWiFi.connects[path];
+        Serial.printf(" %s %u (avg %lu ms),", pathNames[path], count,
+                      count ? (unsigned long)(rtcWiFi.connectMs[path] / count) : 0UL);
+    }
+    Serial.printf(" fast failures %u\n", rtcWiFi.fastFailures);
+}
@@ -0,0 +1,47 @@
+#ifndef WIFI_CONNECTOR_H
+#define WIFI_CONNECTOR_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+// How long a fast connect (cached access point and address) may take
+// before falling back to a normal connect
+#ifndef WIFI_FAST_TIMEOUT_MS
+#define WIFI_FAST_TIMEOUT_MS 4000
+#endif
+#define WIFI_FULL_TIMEOUT_MS 20000
+
+// The cached address is reused without asking DHCP, so the lease is renewed
+// with a DHCP connect (still straight to the cached access point) after
+// this many fast connects
+#ifndef WIFI_DHCP_REFRESH_CONNECTS
+#define WIFI_DHCP_REFRESH_CONNECTS 12
+#endif
+
+// Joins the network, reconnecting straight to the last good access point
+// when it can. After each successful connect the BSSID, channel and IP
+// configuration are kept in RTC memory, so the next wake skips the scan and
+// DHCP. A failed fast connect drops the cache and connects normally.
+// Connect times are logged per wake, with running averages per path.
+class WiFiConnector {
+public:
+    enum Path : uint8_t { PATH_NONE, PATH_FAST, PATH_DHCP, PATH_FULL, PATH_COUNT };
+
+    WiFiConnector();
+
+    // False when neither path connected within its timeout
+    bool connect(const char* ssid, const char* password);
+
+    Path path() const { return _path; }
+    uint32_t connectMs() const { return _connectMs; }
+
+private:
+    Path _path;
+    uint32_t _connectMs; // Whole connect(), a failed fast attempt included
+
+    bool attempt(Path path, const char* ssid, const char* password);
+    void saveCache(uint32_t ssidCrc);
+    void logStats() const;
+};
+
+#endif
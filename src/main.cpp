@@ -4,6 +4,10 @@
 #include <WiFiClientSecure.h>
 #include <ArduinoJson.h>
 #include <time.h>
+#include <esp_sntp.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <freertos/semphr.h>
 #include <Wire.h>
 #include <Adafruit_Sensor.h>
 #include <Adafruit_BME280.h>
@@ -11,6 +15,8 @@
 #include "Display.h"
 #include "WeatherAPI.h"
 #include "WeatherStorage.h"
+#include "FetchScheduler.h"
+#include "WiFiConnector.h"
 
 // Forward declaration
 void ListWifiAPs();
@@ -21,24 +27,112 @@ const char* time_zone = "AEST-10AEDT,M10.1.0,M4.1.0/3";
 
 Adafruit_BME280 bme; // I2C
 
-WeatherData currentWeather;
-DailyForecast dailyForecasts[5];
-HourlyData hourlyData[24];
-
 Display displayHandler;
 WeatherStorage weatherStorage;
+WiFiConnector wifiConnector;
 
-void connectToWiFi() {
-  WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-  Serial.print("Connecting to WiFi");
-  int retry_count = 0;
-  while (WiFi.status() != WL_CONNECTED && retry_count < 40) {
-    delay(500);
-    Serial.print(".");
-    retry_count++;
+// Boot stages finished by the peripherals task, which brings up the BME280
+// and the panel on core 0 while the loop task connects and fetches
+#define STAGE_SENSOR_READY  BIT0
+#define STAGE_DISPLAY_READY BIT1
+
+EventGroupHandle_t bootStages;
+unsigned long bootStart;
+
+struct IndoorReading {
+  bool valid;
+  float temp;
+  float humidity;
+  float pressure;
+};
+IndoorReading indoorReading;
+
+void logStage(const char* stage) {
+  Serial.printf("[%6lu ms] %s\n", millis() - bootStart, stage);
+}
+
+void bringUpPeripherals() {
+  logStage("Peripherals started");
+
+  // Standard I2C: SDA=21, SCL=22. Address 0x76 (SDO=GND) is common for modules.
+  Serial.println("Initializing BME280...");
+  indoorReading.valid = false;
+  if (!bme.begin(0x76)) {
+      Serial.println("Could not find a valid BME280 sensor, check wiring!");
+  } else {
+      indoorReading.temp = bme.readTemperature();
+      indoorReading.humidity = bme.readHumidity();
+      indoorReading.pressure = bme.readPressure() / 100.0F;
+      indoorReading.valid = true;
+      Serial.printf("BME280: Temp=%.2f C, Hum=%.2f %%, Pres=%.2f hPa\n", indoorReading.temp, indoorReading.humidity, indoorReading.pressure);
   }
-  Serial.println();
-  if (WiFi.status() == WL_CONNECTED) {
+  logStage("BME280 sampled");
+  xEventGroupSetBits(bootStages, STAGE_SENSOR_READY);
+
+  displayHandler.init();
+  delay(1000); // Let the panel settle before the first refresh
+  logStage("Display ready");
+  xEventGroupSetBits(bootStages, STAGE_DISPLAY_READY);
+}
+
+void peripheralsTask(void* arg) {
+  bringUpPeripherals();
+  vTaskDelete(NULL);
+}
+
+void startPeripherals() {
+  bootStages = xEventGroupCreate();
+  if (xTaskCreatePinnedToCore(peripheralsTask, "peripherals", 4096, NULL, 1, NULL, 0) != pdPASS) {
+    Serial.println("Peripherals task failed to start, bringing up inline");
+    bringUpPeripherals();
+  }
+}
+
+void waitForStage(EventBits_t stage, const char* name) {
+  unsigned long start = millis();
+  xEventGroupWaitBits(bootStages, stage, pdFALSE, pdTRUE, portMAX_DELAY);
+  Serial.printf("[%6lu ms] %s (waited %lu ms)\n", millis() - bootStart, name, millis() - start);
+}
+
+// Any earlier time means the clock has not been set since power-up
+#define CLOCK_VALID_AFTER 1704067200 // 2024-01-01
+
+bool clockIsSet() {
+  return time(nullptr) > CLOCK_VALID_AFTER;
+}
+
+// A wake that skips WiFi also skips NTP, and the clock drifts through deep
+// sleep. After this many wakes in a row without a sync, WiFi is brought up
+// for the time alone.
+#ifndef CLOCK_SYNC_MAX_SKIPS
+#define CLOCK_SYNC_MAX_SKIPS 3
+#endif
+// How long to wait for SNTP once connected, when the fetches did not cover it
+#define CLOCK_SYNC_TIMEOUT_MS 5000
+
+RTC_DATA_ATTR uint8_t wakesSinceClockSync = 0;
+
+// configTime() starts SNTP in the background and an already set clock does
+// not wait for it, so check (and if need be wait) for the sync here
+void checkClockSync() {
+  unsigned long start = millis();
+  bool synced = sntp_get_sync_status() == SNTP_SYNC_STATUS_COMPLETED;
+  while (!synced && WiFi.status() == WL_CONNECTED && millis() - start < CLOCK_SYNC_TIMEOUT_MS) {
+    delay(50);
+    synced = sntp_get_sync_status() == SNTP_SYNC_STATUS_COMPLETED;
+  }
+  if (synced) {
+    wakesSinceClockSync = 0;
+    Serial.println("Clock synced");
+  } else if (wakesSinceClockSync < 255) {
+    wakesSinceClockSync++;
+    Serial.printf("Clock not synced for %u wakes\n", wakesSinceClockSync);
+  }
+}
+
+void connectToWiFi() {
+  // Straight to the last good access point and address when they are cached
+  if (wifiConnector.connect(WIFI_SSID, WIFI_PASSWORD)) {
     Serial.print("Connected! IP address: ");
     Serial.println(WiFi.localIP());
     
@@ -47,7 +141,7 @@ void connectToWiFi() {
     setenv("TZ", time_zone, 1);
     tzset();
   } else {
-    Serial.println("Failed to connect to WiFi. Check credentials in secrets.h :(RetryCnt=" + String(retry_count) + ")");
+    Serial.println("Failed to connect to WiFi. Check credentials in secrets.h :(");
     ListWifiAPs();
   }
 }
@@ -103,21 +197,82 @@ void sleepUntilNextHour() {
   esp_deep_sleep_start();
 }
 
+// Each fetch job parses into a buffer of its own, so the jobs never write
+// the same memory; saveFetched() merges them into the globals under a lock
+WeatherData fetchedCurrent;
+DailyForecast fetchedDaily[5];
+HourlyData fetchedForecast[24];
+HourlyData fetchedHistory[24];
+
+// Fetch jobs for the scheduler
+bool fetchCurrent(WeatherClient& client, int) {
+  return getWeatherCurrentData(client, fetchedCurrent) && fetchedCurrent.valid;
+}
+
+bool fetchDaily(WeatherClient& client, int) {
+  return getDailyForecastData(client, fetchedDaily);
+}
+
+bool fetchHourly(WeatherClient& client, int hoursCount) {
+  return getHourlyForecastData(client, hoursCount, fetchedForecast);
+}
+
+bool fetchHistory(WeatherClient& client, int hoursCount) {
+  return getHistoryData(client, hoursCount, fetchedHistory);
+}
+
+// Day the fetched data is saved under
+int fetchDay;
+// Created in setup() (not at static init) before the fetch tasks start
+SemaphoreHandle_t storageLock;
+
+// Runs on the fetch task that completed the request
+void saveFetched(int dataType, bool ok) {
+  if (!ok) return;
+  xSemaphoreTake(storageLock, portMAX_DELAY);
+  switch (dataType) {
+    case DATA_CURRENT: mergeCurrentWeather(fetchedCurrent); break;
+    case DATA_DAILY: mergeDailyForecast(fetchedDaily); break;
+    case DATA_HOURLY: mergeHourlyForecast(fetchedForecast); break;
+    case DATA_HISTORY: mergeHistory(fetchedHistory); break;
+  }
+  weatherStorage.stageWeatherData(dataType, fetchDay, currentWeather, dailyForecasts, hourlyData);
+  weatherStorage.recordFetch(dataType, time(nullptr));
+  xSemaphoreGive(storageLock);
+}
+
 void setup() {
   Serial.begin(115200);
   delay(10000);
 
   Serial.println();
   Serial.println("--- Weather Display Start ---");
-  
-  // Connect to WiFi to get time
-  connectToWiFi();
+  bootStart = millis();
+
+  // Sensor and panel come up in the background while the network is busy
+  startPeripherals();
 
-  // Initialize Storage
+  // Start the wake's storage transaction
   weatherStorage.begin();
+
+  // The clock keeps running through deep sleep, so after a timer wake the
+  // cache can be checked before deciding whether WiFi is needed at all.
+  // After a cold boot the time has to come from NTP first.
+  setenv("TZ", time_zone, 1);
+  tzset();
+  if (!clockIsSet()) {
+    connectToWiFi();
+    logStage("WiFi connected");
+  }
   
   struct tm timeinfo;
   bool timeSuccess = getLocalTime(&timeinfo, 10000);
+  logStage(timeSuccess ? "Time synced" : "Time sync failed");
+  if (timeSuccess) {
+    // API timestamps are converted through this instead of swapping TZ per record
+    localTimes.build(time(nullptr));
+    Serial.printf("Local time table: %u offset spans\n", localTimes.spanCount());
+  }
   
   if (timeSuccess) {
     Serial.printf("Current Time: %02d:%02d, Day of Year: %d\n", timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_yday);
@@ -126,95 +281,97 @@ void setup() {
     int currentDay = timeinfo.tm_yday;
 
     // Try to load stored data
-    // Initialize hourly array to safe defaults before loading or fetching
-    for(int i=0; i<24; i++) {
-        hourlyData[i].hour = i;
-        hourlyData[i].temp = -100.0;
-        hourlyData[i].actualTemp = -100.0;
-        hourlyData[i].rainProb = -1;
-        hourlyData[i].actualRain = -1.0;
-        hourlyData[i].indoorTemp = -100.0;
-        hourlyData[i].pressure = -1.0;
-        hourlyData[i].actualPressure = -1.0;
-        hourlyData[i].indoorPressure = -1.0;
-    }
+    // Initialize everything to "no data" before loading or fetching
+    clearWeatherData(currentWeather);
+    for(int i=0; i<5; i++) clearDailyForecast(dailyForecasts[i]);
+    for(int i=0; i<24; i++) clearHourlyData(hourlyData[i], i);
 
-    int status = weatherStorage.loadWeatherData(currentHour, currentDay, currentWeather, dailyForecasts, hourlyData);
+    time_t now = time(nullptr);
+    int status = weatherStorage.loadWeatherData(currentDay, currentWeather, dailyForecasts, hourlyData);
+    logStage("Stored data loaded");
 
-    // Initialize and read BME280
-    // Standard I2C: SDA=21, SCL=22. Address 0x76 (SDO=GND) is common for modules.
-    Serial.println("Initializing BME280...");
-    if (!bme.begin(0x76)) {
-        Serial.println("Could not find a valid BME280 sensor, check wiring!");
-    } else {
-        float indoorT = bme.readTemperature();
-        float indoorH = bme.readHumidity();
-        float indoorP = bme.readPressure() / 100.0F;
-
-        Serial.printf("BME280: Temp=%.2f C, Hum=%.2f %%, Pres=%.2f hPa\n", indoorT, indoorH, indoorP);
-        
+    // Sampled by the peripherals task (usually long done by now)
+    waitForStage(STAGE_SENSOR_READY, "BME280 reading available");
+    if (indoorReading.valid) {
         // Update Current Weather Indoor Data
-        currentWeather.indoorTemp = indoorT;
-        currentWeather.indoorHumidity = indoorH;
-        currentWeather.indoorPressure = indoorP;
+        currentWeather.indoorTemp = indoorReading.temp;
+        currentWeather.indoorHumidity = indoorReading.humidity;
+        currentWeather.indoorPressure = indoorReading.pressure;
         
         // Update Hourly Data for Graph - Current Hour
-        hourlyData[currentHour].indoorTemp = indoorT;
-        hourlyData[currentHour].indoorPressure = indoorP;
+        hourlyData[currentHour].indoorTemp = indoorReading.temp;
+        hourlyData[currentHour].indoorPressure = indoorReading.pressure;
         
         // Save the BME data
-        weatherStorage.saveWeatherData(DATA_HOURLY, currentHour, currentDay, currentWeather, dailyForecasts, hourlyData);
+        weatherStorage.stageWeatherData(DATA_HOURLY, currentDay, currentWeather, dailyForecasts, hourlyData);
     }
 
+    // Fetch only what has gone stale (or was never fetched today)
+    Serial.println("Cached data:");
+    weatherStorage.logCache(now);
+    int stale = weatherStorage.staleMask(now, currentDay);
+
     // Validate loaded data for current hour
     // If we think we have hourly data, but the current hour is empty, force a refresh.
     if ((status & DATA_HOURLY) && hourlyData[currentHour].temp == -100.0 && hourlyData[currentHour].actualTemp == -100.0) {
         Serial.printf("Data for current hour (%d) is missing. Forcing refresh.\n", currentHour);
-        status &= ~DATA_HOURLY;
-        status &= ~DATA_HISTORY;
+        stale |= DATA_HOURLY | DATA_HISTORY;
         // Also force current to be safe
-        status &= ~DATA_CURRENT;
-    }
-
-    // Check what is missing and fetch it
-    if (!(status & DATA_CURRENT)) {
-        Serial.println("Fetching Current Weather...");
-        if (getWeatherCurrentData() && currentWeather.valid) {
-            weatherStorage.saveWeatherData(DATA_CURRENT, currentHour, currentDay, currentWeather, dailyForecasts, hourlyData);
-        }
+        stale |= DATA_CURRENT;
     }
 
-    if (!(status & DATA_DAILY)) {
-        Serial.println("Fetching Daily Forecast...");
-        if (getDailyForecastData()) {
-            weatherStorage.saveWeatherData(DATA_DAILY, currentHour, currentDay, currentWeather, dailyForecasts, hourlyData);
+    bool clockDue = wakesSinceClockSync >= CLOCK_SYNC_MAX_SKIPS;
+    if (stale == DATA_NONE && !clockDue) {
+        logStage("All cached data fresh, WiFi skipped");
+    } else if (WiFi.status() != WL_CONNECTED) {
+        if (stale == DATA_NONE) {
+            Serial.printf("All cached data fresh, connecting for NTP (%u wakes without a sync)\n", wakesSinceClockSync);
         }
+        connectToWiFi();
+        logStage("WiFi connected");
     }
 
-    if (!(status & DATA_HOURLY)) {
-        Serial.println("Fetching Hourly Forecast...");
+    // Fetch the stale parts, several requests at a time
+    fetchDay = currentDay;
+    storageLock = xSemaphoreCreateMutex();
+    clearFetchBuffers(fetchedCurrent, fetchedDaily, fetchedForecast, fetchedHistory);
+    // Largest payloads first so they are never left waiting for a connection
+    FetchScheduler fetches;
+    if (stale & DATA_HOURLY) {
         // Forecast: From now until end of day (approx). 
         int forecastHours = 24 - currentHour + 2;
         if (forecastHours > 48) forecastHours = 48; 
-        if (getHourlyForecastData(forecastHours)) {
-            weatherStorage.saveWeatherData(DATA_HOURLY, currentHour, currentDay, currentWeather, dailyForecasts, hourlyData);
-        }
+        fetches.add("Hourly forecast", fetchHourly, forecastHours, saveFetched, DATA_HOURLY);
     }
-
-    if (!(status & DATA_HISTORY)) {
-        Serial.println("Fetching History...");
-        // History: From midnight until now.
-        int historyHours = currentHour + 1;
+    if (stale & DATA_HISTORY) {
+        // History: only the hours since the newest observation already held
+        // (the API's latest hour may lag, so that one is fetched again).
+        // From midnight until now after a day change or a gap.
+        int newestHour = weatherStorage.historyHour(currentDay);
+        int historyHours = newestHour >= 0 ? currentHour - newestHour + 1 : currentHour + 1;
         if (historyHours > 24) historyHours = 24;
-        if (getHistoryData(historyHours)) {
-            weatherStorage.saveWeatherData(DATA_HISTORY, currentHour, currentDay, currentWeather, dailyForecasts, hourlyData);
+        if (historyHours > 0) {
+            Serial.printf("History sync: %s, %d hours (newest held: %d)\n", newestHour >= 0 ? "incremental" : "full", historyHours, newestHour);
+            fetches.add("History", fetchHistory, historyHours, saveFetched, DATA_HISTORY);
+        } else {
+            // Nothing to request; still counts as a fetch so it is not stale again next wake
+            Serial.printf("History up to date (newest held: %d)\n", newestHour);
+            weatherStorage.recordFetch(DATA_HISTORY, now);
         }
     }
+    if (stale & DATA_CURRENT) {
+        fetches.add("Current weather", fetchCurrent, 0, saveFetched, DATA_CURRENT);
+    }
+    if (stale & DATA_DAILY) {
+        fetches.add("Daily forecast", fetchDaily, 0, saveFetched, DATA_DAILY);
+    }
+    fetches.run();
+    logStage("Fetches complete");
     
     // display forcast data hourly to serial
     Serial.println("--- Forecast Data: 5 day ---");
     for(int i=0; i<5; i++) {
-        Serial.printf("Forecast Day %d: %s, High: %.1f, Low: %.1f, Icon: %s\n", i, dailyForecasts[i].dayName.c_str(), dailyForecasts[i].tempHigh, dailyForecasts[i].tempLow, dailyForecasts[i].iconName.c_str());
+        Serial.printf("Forecast Day %d: %s, High: %.1f, Low: %.1f, Icon: %s\n", i, weekdayName(dailyForecasts[i].weekday), dailyForecasts[i].tempHigh, dailyForecasts[i].tempLow, weatherIconName(dailyForecasts[i].iconId));
     }
     Serial.println("--- Hourly Data: 24 hour ---");
     Serial.printf("%4s|%8s|%8s|%8s|%8s|%5s|%8s|%8s|%8s\n", "Hour", "Temp", "Actual", "Indoor", "Rain", "Prob", "Press", "ActPress", "IndPress");
@@ -236,10 +393,13 @@ void setup() {
     Serial.println("Failed to obtain time, forcing forecast update...");
     sleepUntilNextHour();
   }
-  delay(1000);
-  displayHandler.init();
-  delay(1000);
+  checkClockSync();
+  waitForStage(STAGE_DISPLAY_READY, "Display ready for render");
   displayHandler.drawWeather(currentWeather, dailyForecasts, hourlyData);
+  logStage("Render complete");
+
+  // Ends the wake's storage transaction; NVS is only written when the flush is due
+  weatherStorage.commit();
   
   sleepUntilNextHour();
 }
@@ -0,0 +1,7 @@
+# Put the installed Adafruit GFX Library on the include path for its Fonts/
+# and gfxfont.h, without building it (the native env ignores it as a library)
+import os
+
+Import("env")
+
+env.Append(CPPPATH=[os.path.join(env.subst("$PROJECT_LIBDEPS_DIR"), env.subst("$PIOENV"), "Adafruit GFX Library")])
@@ -0,0 +1,367 @@
+#ifndef HOST_ADAFRUIT_GFX_H
+#define HOST_ADAFRUIT_GFX_H
+
+// Host stand-in for Adafruit_GFX: the primitives and GFXfont text the
+// firmware draws with, ported from the library so frames rasterise the same
+// as on the device. The fonts themselves (Fonts/*.h, gfxfont.h) come from
+// the real library, installed by lib_deps but not built.
+
+#include <Arduino.h>
+#include <gfxfont.h>
+
+#ifndef _swap_int16_t
+#define _swap_int16_t(a, b) { int16_t t = a; a = b; b = t; }
+#endif
+
+class Adafruit_GFX : public Print {
+public:
+    Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h), _width(w), _height(h) {}
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+    virtual void startWrite() {}
+    virtual void writePixel(int16_t x, int16_t y, uint16_t color) { drawPixel(x, y, color); }
+    virtual void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { fillRect(x, y, w, h, color); }
+    virtual void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) { drawFastVLine(x, y, h, color); }
+    virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) { drawFastHLine(x, y, w, color); }
+    virtual void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+        int16_t steep = abs(y1 - y0) > abs(x1 - x0);
+        if (steep) {
+            _swap_int16_t(x0, y0);
+            _swap_int16_t(x1, y1);
+        }
+        if (x0 > x1) {
+            _swap_int16_t(x0, x1);
+            _swap_int16_t(y0, y1);
+        }
+        int16_t dx = x1 - x0;
+        int16_t dy = abs(y1 - y0);
+        int16_t err = dx / 2;
+        int16_t ystep = y0 < y1 ? 1 : -1;
+        for (; x0 <= x1; x0++) {
+            if (steep) writePixel(y0, x0, color);
+            else writePixel(x0, y0, color);
+            err -= dy;
+            if (err < 0) {
+                y0 += ystep;
+                err += dx;
+            }
+        }
+    }
+    virtual void endWrite() {}
+
+    virtual void setRotation(uint8_t r) { rotation = r & 3; }
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+        startWrite();
+        writeLine(x, y, x, y + h - 1, color);
+        endWrite();
+    }
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+        startWrite();
+        writeLine(x, y, x + w - 1, y, color);
+        endWrite();
+    }
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        startWrite();
+        for (int16_t i = x; i < x + w; i++) writeFastVLine(i, y, h, color);
+        endWrite();
+    }
+    virtual void fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
+    virtual void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+        if (x0 == x1) {
+            if (y0 > y1) _swap_int16_t(y0, y1);
+            drawFastVLine(x0, y0, y1 - y0 + 1, color);
+        } else if (y0 == y1) {
+            if (x0 > x1) _swap_int16_t(x0, x1);
+            drawFastHLine(x0, y0, x1 - x0 + 1, color);
+        } else {
+            startWrite();
+            writeLine(x0, y0, x1, y1, color);
+            endWrite();
+        }
+    }
+
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        startWrite();
+        writeFastHLine(x, y, w, color);
+        writeFastHLine(x, y + h - 1, w, color);
+        writeFastVLine(x, y, h, color);
+        writeFastVLine(x + w - 1, y, h, color);
+        endWrite();
+    }
+
+    void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+        int16_t f = 1 - r;
+        int16_t ddF_x = 1;
+        int16_t ddF_y = -2 * r;
+        int16_t x = 0;
+        int16_t y = r;
+        startWrite();
+        writePixel(x0, y0 + r, color);
+        writePixel(x0, y0 - r, color);
+        writePixel(x0 + r, y0, color);
+        writePixel(x0 - r, y0, color);
+        while (x < y) {
+            if (f >= 0) {
+                y--;
+                ddF_y += 2;
+                f += ddF_y;
+            }
+            x++;
+            ddF_x += 2;
+            f += ddF_x;
+            writePixel(x0 + x, y0 + y, color);
+            writePixel(x0 - x, y0 + y, color);
+            writePixel(x0 + x, y0 - y, color);
+            writePixel(x0 - x, y0 - y, color);
+            writePixel(x0 + y, y0 + x, color);
+            writePixel(x0 - y, y0 + x, color);
+            writePixel(x0 + y, y0 - x, color);
+            writePixel(x0 - y, y0 - x, color);
+        }
+        endWrite();
+    }
+
+    void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+        startWrite();
+        writeFastVLine(x0, y0 - r, 2 * r + 1, color);
+        fillCircleHelper(x0, y0, r, 3, 0, color);
+        endWrite();
+    }
+
+    void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, uint16_t color) {
+        int16_t f = 1 - r;
+        int16_t ddF_x = 1;
+        int16_t ddF_y = -2 * r;
+        int16_t x = 0;
+        int16_t y = r;
+        int16_t px = x;
+        int16_t py = y;
+        delta++; // Avoid some +1's in the loop
+        while (x < y) {
+            if (f >= 0) {
+                y--;
+                ddF_y += 2;
+                f += ddF_y;
+            }
+            x++;
+            ddF_x += 2;
+            f += ddF_x;
+            // These checks avoid double-drawing certain lines
+            if (x < (y + 1)) {
+                if (corners & 1) writeFastVLine(x0 + x, y0 - y, 2 * y + delta, color);
+                if (corners & 2) writeFastVLine(x0 - x, y0 - y, 2 * y + delta, color);
+            }
+            if (y != py) {
+                if (corners & 1) writeFastVLine(x0 + py, y0 - px, 2 * px + delta, color);
+                if (corners & 2) writeFastVLine(x0 - py, y0 - px, 2 * px + delta, color);
+                py = y;
+            }
+            px = x;
+        }
+    }
+
+    void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+        int16_t a, b, y, last;
+        // Sort coordinates by Y order (y2 >= y1 >= y0)
+        if (y0 > y1) {
+            _swap_int16_t(y0, y1);
+            _swap_int16_t(x0, x1);
+        }
+        if (y1 > y2) {
+            _swap_int16_t(y2, y1);
+            _swap_int16_t(x2, x1);
+        }
+        if (y0 > y1) {
+            _swap_int16_t(y0, y1);
+            _swap_int16_t(x0, x1);
+        }
+        startWrite();
+        if (y0 == y2) { // All on the same line
+            a = b = x0;
+            if (x1 < a) a = x1;
+            else if (x1 > b) b = x1;
+            if (x2 < a) a = x2;
+            else if (x2 > b) b = x2;
+            writeFastHLine(a, y0, b - a + 1, color);
+            endWrite();
+            return;
+        }
+        int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0, dx12 = x2 - x1, dy12 = y2 - y1;
+        int32_t sa = 0, sb = 0;
+        last = y1 == y2 ? y1 : y1 - 1;
+        for (y = y0; y <= last; y++) {
+            a = x0 + sa / dy01;
+            b = x0 + sb / dy02;
+            sa += dx01;
+            sb += dx02;
+            if (a > b) _swap_int16_t(a, b);
+            writeFastHLine(a, y, b - a + 1, color);
+        }
+        sa = (int32_t)dx12 * (y - y1);
+        sb = (int32_t)dx02 * (y - y0);
+        for (; y <= y2; y++) {
+            a = x1 + sa / dy12;
+            b = x0 + sb / dy02;
+            sa += dx12;
+            sb += dx02;
+            if (a > b) _swap_int16_t(a, b);
+            writeFastHLine(a, y, b - a + 1, color);
+        }
+        endWrite();
+    }
+
+    // GFXfont glyphs only; the firmware never draws with the classic 5x7 font
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) {
+        drawChar(x, y, c, color, bg, size, size);
+    }
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size_x, uint8_t size_y) {
+        (void)bg;
+        if (!gfxFont) return;
+        c -= (uint8_t)pgm_read_byte(&gfxFont->first);
+        const GFXglyph* glyph = gfxFont->glyph + c;
+        const uint8_t* bitmap = gfxFont->bitmap;
+        uint16_t bo = pgm_read_word(&glyph->bitmapOffset);
+        uint8_t w = pgm_read_byte(&glyph->width);
+        uint8_t h = pgm_read_byte(&glyph->height);
+        int8_t xo = pgm_read_byte(&glyph->xOffset);
+        int8_t yo = pgm_read_byte(&glyph->yOffset);
+        uint8_t xx, yy, bits = 0, bit = 0;
+        int16_t xo16 = xo, yo16 = yo;
+        startWrite();
+        for (yy = 0; yy < h; yy++) {
+            for (xx = 0; xx < w; xx++) {
+                if (!(bit++ & 7)) bits = pgm_read_byte(&bitmap[bo++]);
+                if (bits & 0x80) {
+                    if (size_x == 1 && size_y == 1) {
+                        writePixel(x + xo + xx, y + yo + yy, color);
+                    } else {
+                        writeFillRect(x + (xo16 + xx) * size_x, y + (yo16 + yy) * size_y, size_x, size_y, color);
+                    }
+                }
+                bits <<= 1;
+            }
+        }
+        endWrite();
+    }
+
+    size_t write(uint8_t c) override {
+        if (!gfxFont) return 1;
+        if (c == '\n') {
+            cursor_x = 0;
+            cursor_y += (int16_t)textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+        } else if (c != '\r') {
+            uint8_t first = pgm_read_byte(&gfxFont->first);
+            if ((c >= first) && (c <= (uint8_t)pgm_read_byte(&gfxFont->last))) {
+                const GFXglyph* glyph = gfxFont->glyph + (c - first);
+                uint8_t w = pgm_read_byte(&glyph->width);
+                uint8_t h = pgm_read_byte(&glyph->height);
+                if ((w > 0) && (h > 0)) {
+                    int16_t xo = (int8_t)pgm_read_byte(&glyph->xOffset);
+                    if (wrap && ((cursor_x + textsize_x * (xo + w)) > _width)) {
+                        cursor_x = 0;
+                        cursor_y += (int16_t)textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+                    }
+                    drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+                }
+                cursor_x += (uint8_t)pgm_read_byte(&glyph->xAdvance) * (int16_t)textsize_x;
+            }
+        }
+        return 1;
+    }
+    using Print::write;
+
+    void setCursor(int16_t x, int16_t y) {
+        cursor_x = x;
+        cursor_y = y;
+    }
+    void setTextColor(uint16_t c) { textcolor = textbgcolor = c; }
+    void setTextColor(uint16_t c, uint16_t bg) {
+        textcolor = c;
+        textbgcolor = bg;
+    }
+    void setTextSize(uint8_t s) { textsize_x = textsize_y = s ? s : 1; }
+    void setTextWrap(bool w) { wrap = w; }
+    void setFont(const GFXfont* f) {
+        if (f) {
+            if (!gfxFont) cursor_y += 6; // Switching from classic to new font behavior
+        } else if (gfxFont) {
+            cursor_y -= 6;
+        }
+        gfxFont = (GFXfont*)f;
+    }
+
+    void charBounds(unsigned char c, int16_t* x, int16_t* y, int16_t* minx, int16_t* miny, int16_t* maxx, int16_t* maxy) {
+        if (!gfxFont) return;
+        if (c == '\n') {
+            *x = 0;
+            *y += textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+        } else if (c != '\r') {
+            uint8_t first = pgm_read_byte(&gfxFont->first);
+            uint8_t last = pgm_read_byte(&gfxFont->last);
+            if ((c >= first) && (c <= last)) {
+                const GFXglyph* glyph = gfxFont->glyph + (c - first);
+                uint8_t gw = pgm_read_byte(&glyph->width);
+                uint8_t gh = pgm_read_byte(&glyph->height);
+                uint8_t xa = pgm_read_byte(&glyph->xAdvance);
+                int8_t xo = pgm_read_byte(&glyph->xOffset);
+                int8_t yo = pgm_read_byte(&glyph->yOffset);
+                if (wrap && ((*x + (((int16_t)xo + gw) * textsize_x)) > _width)) {
+                    *x = 0;
+                    *y += textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+                }
+                int16_t tsx = textsize_x, tsy = textsize_y;
+                int16_t x1 = *x + xo * tsx, y1 = *y + yo * tsy;
+                int16_t x2 = x1 + gw * tsx - 1, y2 = y1 + gh * tsy - 1;
+                if (x1 < *minx) *minx = x1;
+                if (y1 < *miny) *miny = y1;
+                if (x2 > *maxx) *maxx = x2;
+                if (y2 > *maxy) *maxy = y2;
+                *x += xa * tsx;
+            }
+        }
+    }
+    void getTextBounds(const char* str, int16_t x, int16_t y, int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h) {
+        uint8_t c;
+        int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1;
+        *x1 = x;
+        *y1 = y;
+        *w = *h = 0;
+        while ((c = *str++)) charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+        if (maxx >= minx) {
+            *x1 = minx;
+            *w = maxx - minx + 1;
+        }
+        if (maxy >= miny) {
+            *y1 = miny;
+            *h = maxy - miny + 1;
+        }
+    }
+    void getTextBounds(const String& str, int16_t x, int16_t y, int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h) {
+        getTextBounds(str.c_str(), x, y, x1, y1, w, h);
+    }
+
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+    uint8_t getRotation() const { return rotation; }
+    int16_t getCursorX() const { return cursor_x; }
+    int16_t getCursorY() const { return cursor_y; }
+
+protected:
+    int16_t WIDTH;
+    int16_t HEIGHT;
+    int16_t _width;
+    int16_t _height;
+    int16_t cursor_x = 0;
+    int16_t cursor_y = 0;
+    uint16_t textcolor = 0xFFFF;
+    uint16_t textbgcolor = 0xFFFF;
+    uint8_t textsize_x = 1;
+    uint8_t textsize_y = 1;
+    uint8_t rotation = 0;
+    bool wrap = true;
+    bool _cp437 = false;
+    GFXfont* gfxFont = nullptr;
+};
+
+#endif
@@ -0,0 +1,255 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Host stand-in for the parts of the Arduino-ESP32 core the firmware uses,
+// so src/ and lib/ build for [env:native] tests. Serial output goes to
+// stderr when HOST_SERIAL is set in the environment.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <math.h>
+#include <time.h>
+#include <stdarg.h>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#define PI 3.1415926535897932384626433832795
+#define PROGMEM
+#define IRAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_pointer(addr) (*(addr))
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+using std::min;
+using std::max;
+
+inline long random(long howsmall, long howbig) { return howsmall + rand() % (howbig - howsmall); }
+inline long random(long howbig) { return random(0, howbig); }
+
+inline unsigned long micros() {
+    using namespace std::chrono;
+    return (unsigned long)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+inline unsigned long millis() { return micros() / 1000; }
+inline void delay(unsigned long ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+inline void delayMicroseconds(unsigned int us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+inline void yield() { std::this_thread::yield(); }
+
+inline char* dtostrf(double val, signed char width, unsigned char prec, char* sout) {
+    sprintf(sout, "%*.*f", width, prec, val);
+    return sout;
+}
+
+#if defined(__GLIBC__)
+#if !__GLIBC_PREREQ(2, 38)
+#define HOST_NEEDS_STRLCPY
+#endif
+#elif defined(_WIN32)
+#define HOST_NEEDS_STRLCPY
+#endif
+#ifdef HOST_NEEDS_STRLCPY
+inline size_t strlcpy(char* dst, const char* src, size_t size) {
+    size_t len = strlen(src);
+    if (size) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = 0;
+    }
+    return len;
+}
+#endif
+
+class String {
+public:
+    String() {}
+    String(const char* s) : _s(s ? s : "") {}
+    String(const std::string& s) : _s(s) {}
+    explicit String(char c) : _s(1, c) {}
+    String(int v) : _s(std::to_string(v)) {}
+    String(unsigned v) : _s(std::to_string(v)) {}
+    String(long v) : _s(std::to_string(v)) {}
+    String(unsigned long v) : _s(std::to_string(v)) {}
+    String(float v, unsigned decimals = 2) : String((double)v, decimals) {}
+    String(double v, unsigned decimals = 2) {
+        char buf[40];
+        dtostrf(v, decimals + 2, decimals, buf);
+        _s = buf;
+    }
+
+    const char* c_str() const { return _s.c_str(); }
+    unsigned length() const { return _s.size(); }
+    bool isEmpty() const { return _s.empty(); }
+    char operator[](unsigned i) const { return i < _s.size() ? _s[i] : 0; }
+    int indexOf(char c, unsigned from = 0) const { return found(_s.find(c, from)); }
+    int indexOf(const String& s, unsigned from = 0) const { return found(_s.find(s._s, from)); }
+    int lastIndexOf(char c) const { return found(_s.rfind(c)); }
+    String substring(unsigned from) const { return from < _s.size() ? String(_s.substr(from)) : String(); }
+    String substring(unsigned from, unsigned to) const {
+        return from < _s.size() && to > from ? String(_s.substr(from, to - from)) : String();
+    }
+    bool startsWith(const String& s) const { return _s.compare(0, s._s.size(), s._s) == 0; }
+    bool endsWith(const String& s) const {
+        return _s.size() >= s._s.size() && _s.compare(_s.size() - s._s.size(), s._s.size(), s._s) == 0;
+    }
+    bool equals(const String& s) const { return _s == s._s; }
+    bool equalsIgnoreCase(const String& s) const { return strcasecmp(_s.c_str(), s.c_str()) == 0; }
+    void toLowerCase() { for (char& c : _s) c = tolower(c); }
+    void toUpperCase() { for (char& c : _s) c = toupper(c); }
+    int toInt() const { return atoi(_s.c_str()); }
+    float toFloat() const { return atof(_s.c_str()); }
+
+    String& operator+=(const String& s) { _s += s._s; return *this; }
+    String& operator+=(const char* s) { _s += s; return *this; }
+    String& operator+=(char c) { _s += c; return *this; }
+    bool operator==(const String& s) const { return _s == s._s; }
+    bool operator==(const char* s) const { return _s == s; }
+    bool operator!=(const String& s) const { return _s != s._s; }
+    bool operator!=(const char* s) const { return _s != s; }
+    friend String operator+(const String& a, const String& b) { return String(a._s + b._s); }
+    friend String operator+(const String& a, const char* b) { return String(a._s + b); }
+    friend String operator+(const char* a, const String& b) { return String(a + b._s); }
+
+private:
+    std::string _s;
+
+    static int found(size_t pos) { return pos == std::string::npos ? -1 : (int)pos; }
+};
+
+// What String's operator+ returns in the core; ArduinoJson names it
+class StringSumHelper : public String {
+public:
+    using String::String;
+    StringSumHelper(const String& s) : String(s) {}
+};
+
+class Print;
+
+class Printable {
+public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print& p) const = 0;
+};
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t n = 0;
+        while (size--) n += write(*buffer++);
+        return n;
+    }
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+    size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+
+    size_t print(const char* s) { return write(s); }
+    size_t print(const String& s) { return write(s.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int v) { return print(String(v)); }
+    size_t print(unsigned v) { return print(String(v)); }
+    size_t print(long v) { return print(String(v)); }
+    size_t print(unsigned long v) { return print(String(v)); }
+    size_t print(double v, int decimals = 2) { return print(String(v, decimals)); }
+    size_t print(const Printable& p) { return p.printTo(*this); }
+    size_t print(const struct tm* timeinfo, const char* format) {
+        char buf[64];
+        return write(buf, strftime(buf, sizeof(buf), format, timeinfo));
+    }
+
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(const T& v) { return print(v) + println(); }
+    size_t println(double v, int decimals) { return print(v, decimals) + println(); }
+    size_t println(const struct tm* timeinfo, const char* format) { return print(timeinfo, format) + println(); }
+
+    size_t printf(const char* format, ...) {
+        char buf[512];
+        va_list args;
+        va_start(args, format);
+        int len = vsnprintf(buf, sizeof(buf), format, args);
+        va_end(args);
+        return len > 0 ? write(buf, min((size_t)len, sizeof(buf) - 1)) : 0;
+    }
+
+    virtual void flush() {}
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    virtual size_t readBytes(char* buffer, size_t length) {
+        size_t n = 0;
+        while (n < length) {
+            int c = read();
+            if (c < 0) break;
+            buffer[n++] = (char)c;
+        }
+        return n;
+    }
+    size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+    void setTimeout(unsigned long timeoutMs) { _timeout = timeoutMs; }
+    unsigned long getTimeout() const { return _timeout; }
+
+protected:
+    unsigned long _timeout = 1000;
+};
+
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long) {}
+    size_t write(uint8_t c) override {
+        if (_echo) fputc(c, stderr);
+        return 1;
+    }
+    using Print::write;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+
+private:
+    bool _echo = getenv("HOST_SERIAL") != nullptr;
+};
+
+inline HardwareSerial Serial;
+
+// Tests pin the wall clock with setHostTime() so rendered frames and
+// "today" filters do not depend on when they run; 0 follows the real clock
+inline time_t hostTime = 0;
+inline void setHostTime(time_t t) { hostTime = t; }
+
+inline bool getLocalTime(struct tm* info, uint32_t ms = 5000) {
+    (void)ms;
+    time_t now = hostTime ? hostTime : time(nullptr);
+    localtime_r(&now, info);
+    // As on the ESP32, a clock still near the epoch has not been set by NTP
+    return info->tm_year > (2016 - 1900);
+}
+
+// Heap figures are fixed unless a test sets them (to force the paged path, say)
+class EspClass {
+public:
+    uint32_t freeHeap = 300000;
+    uint32_t maxAllocHeap = 110000;
+
+    uint32_t getFreeHeap() const { return freeHeap; }
+    uint32_t getMinFreeHeap() const { return freeHeap; }
+    uint32_t getMaxAllocHeap() const { return maxAllocHeap; }
+    uint32_t getCycleCount() const { return (uint32_t)(micros() * 240); }
+};
+
+inline EspClass ESP;
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef HOST_GXEPD2_H
+#define HOST_GXEPD2_H
+
+// The GxEPD2 colour constants the firmware draws with (RGB565)
+#define GxEPD_BLACK 0x0000
+#define GxEPD_WHITE 0xFFFF
+#define GxEPD_GREEN 0x07E0
+#define GxEPD_BLUE 0x001F
+#define GxEPD_RED 0xF800
+#define GxEPD_YELLOW 0xFFE0
+#define GxEPD_ORANGE 0xFC00
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef HOST_GXEPD2_7C_H
+#define HOST_GXEPD2_7C_H
+
+// Host stand-in for GxEPD2_7C: the same paged drawing loop, page buffer
+// layout and colour mapping as the library, writing pages to the panel
+// stand-in through epd2.writeNative()
+
+#include <Adafruit_GFX.h>
+#include <GxEPD2.h>
+#include <epd7c/GxEPD2_730c_GDEP073E01.h>
+
+template <typename GxEPD2_Type, const uint16_t page_height>
+class GxEPD2_7C : public Adafruit_GFX {
+public:
+    GxEPD2_Type epd2;
+
+    GxEPD2_7C(GxEPD2_Type epd2_instance)
+        : Adafruit_GFX(GxEPD2_Type::WIDTH_VISIBLE, GxEPD2_Type::HEIGHT), epd2(epd2_instance) {
+        _page_height = page_height;
+        _pages = (HEIGHT / _page_height) + ((HEIGHT % _page_height) > 0);
+        _current_page = 0;
+    }
+
+    uint16_t pages() { return _pages; }
+    uint16_t pageHeight() { return _page_height; }
+
+    void init(uint32_t serial_diag_bitrate = 0, bool initial = true, uint16_t reset_duration = 10, bool pulldown_rst_mode = false) {
+        epd2.init(serial_diag_bitrate, initial, reset_duration, pulldown_rst_mode);
+    }
+    void setFullWindow() {}
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        if ((x < 0) || (x >= width()) || (y < 0) || (y >= height())) return;
+        y -= _current_page * _page_height;
+        if ((y < 0) || (y >= int16_t(_page_height))) return;
+        uint32_t i = x / 2 + uint32_t(y) * (WIDTH / 2);
+        uint8_t pv = color7(color);
+        if (x & 1) _buffer[i] = (_buffer[i] & 0xF0) | pv;
+        else _buffer[i] = (_buffer[i] & 0x0F) | (pv << 4);
+    }
+    void fillScreen(uint16_t color) override {
+        uint8_t pv = color7(color);
+        memset(_buffer, pv << 4 | pv, sizeof(_buffer));
+    }
+
+    void firstPage() {
+        fillScreen(GxEPD_WHITE);
+        _current_page = 0;
+    }
+    bool nextPage() {
+        uint16_t page_ys = _current_page * _page_height;
+        uint16_t page_h = min<int>(_page_height, HEIGHT - page_ys);
+        epd2.writeNative(_buffer, nullptr, 0, page_ys, WIDTH, page_h);
+        _current_page++;
+        if (_current_page == _pages) {
+            _current_page = 0;
+            epd2.refresh(false);
+            epd2.powerOff();
+            return false;
+        }
+        fillScreen(GxEPD_WHITE);
+        return true;
+    }
+
+    void powerOff() { epd2.powerOff(); }
+    void hibernate() { epd2.hibernate(); }
+
+    static inline uint8_t color7(uint16_t color) {
+        switch (color) {
+            case GxEPD_BLACK: return 0x00;
+            case GxEPD_WHITE: return 0x01;
+            case GxEPD_GREEN: return 0x02;
+            case GxEPD_BLUE: return 0x03;
+            case GxEPD_RED: return 0x04;
+            case GxEPD_YELLOW: return 0x05;
+            case GxEPD_ORANGE: return 0x06;
+        }
+        uint16_t red = color & 0xF800;
+        uint16_t green = (color & 0x07E0) << 5;
+        uint16_t blue = (color & 0x001F) << 11;
+        if ((red < 0x8000) && (green < 0x8000) && (blue < 0x8000)) return 0x00;
+        if ((red >= 0x8000) && (green >= 0x8000) && (blue >= 0x8000)) return 0x01;
+        if ((red >= 0x8000) && (blue >= 0x8000)) return red > blue ? 0x04 : 0x03;
+        if ((green >= 0x8000) && (blue >= 0x8000)) return green > blue ? 0x02 : 0x03;
+        if ((red >= 0x8000) && (green >= 0x8000)) {
+            const uint16_t yellowToOrange = ((GxEPD_YELLOW - GxEPD_ORANGE) / 2 + (GxEPD_ORANGE & 0x07E0)) << 5;
+            return green > yellowToOrange ? 0x05 : 0x06;
+        }
+        if (red >= 0x8000) return 0x04;
+        if (green >= 0x8000) return 0x02;
+        return 0x03;
+    }
+
+private:
+    uint8_t _buffer[(GxEPD2_Type::WIDTH / 2) * page_height];
+    int16_t _current_page;
+    uint16_t _pages;
+    uint16_t _page_height;
+};
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef HOST_HTTP_CLIENT_H
+#define HOST_HTTP_CLIENT_H
+
+// Host stand-in for HTTPClient over WiFiClientSecure, answered by HostHttp.
+// Like the real one with reuse on, it leaves the connection open after end().
+#include <Arduino.h>
+#include <WiFiClientSecure.h>
+
+#define HTTP_CODE_OK 200
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+class HTTPClient {
+public:
+    bool begin(WiFiClientSecure& client, const String& url) {
+        _client = &client;
+        _url = url;
+        return true;
+    }
+    void end() {
+        if (_inRequest) HostHttp::finish();
+        _inRequest = false;
+    }
+    void setReuse(bool) {}
+    void setTimeout(uint16_t) {}
+    void collectHeaders(const char* headerKeys[], size_t count) {
+        (void)headerKeys;
+        (void)count;
+    }
+
+    int GET() {
+        if (!_client || !_client->connected()) return HTTPC_ERROR_CONNECTION_REFUSED;
+        end();
+        _response = HostHttp::begin(_url.c_str());
+        _inRequest = true;
+        _client->receive(HostHttp::wireBody(_response));
+        return _response.status;
+    }
+
+    int getSize() { return _response.chunked ? -1 : (int)_response.body.size(); }
+    String header(const char* name) {
+        return _response.chunked && strcasecmp(name, "Transfer-Encoding") == 0 ? String("chunked") : String();
+    }
+    String getString() { return String(_response.body); }
+    WiFiClientSecure& getStream() { return *_client; }
+
+private:
+    WiFiClientSecure* _client = nullptr;
+    String _url;
+    HostHttpResponse _response;
+    bool _inRequest = false;
+};
+
+#endif
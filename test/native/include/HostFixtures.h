@@ -0,0 +1,19 @@
+#ifndef HOST_FIXTURES_H
+#define HOST_FIXTURES_H
+
+// Reads a file from test/fixtures/, found relative to this header so every
+// test program can use it whatever directory it runs from
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+inline std::string readFixture(const char* name) {
+    std::filesystem::path path = std::filesystem::path(__FILE__).parent_path() / ".." / ".." / "fixtures" / name;
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+#endif
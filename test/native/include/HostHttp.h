@@ -0,0 +1,114 @@
+#ifndef HOST_HTTP_H
+#define HOST_HTTP_H
+
+// In-process stand-in for the weather API server, behind the WiFiClientSecure
+// and HTTPClient stand-ins. Tests register a response per URL path; the
+// query string is ignored. Counters record what the client asked for and
+// how many requests overlapped, for the concurrent fetch tests.
+
+#include <Arduino.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct HostHttpResponse {
+    int status = 200;
+    std::string body;
+    bool chunked = false;   // Sent with Transfer-Encoding: chunked, in chunkBytes pieces
+    size_t chunkBytes = 1024;
+    uint32_t latencyMs = 0; // Server time before the response starts
+};
+
+class HostHttp {
+public:
+    // False refuses every connect, as with no route to the host
+    static inline bool reachable = true;
+    static inline uint32_t handshakeMs = 0;
+
+    static inline int connects = 0;
+    static inline int requests = 0;
+    static inline int active = 0;     // Requests between GET() and end()
+    static inline int peakActive = 0;
+    static inline std::vector<std::string> paths; // Requested paths, in order
+
+    static std::mutex& mutex() {
+        static std::mutex m;
+        return m;
+    }
+
+    static void serve(const char* path, const HostHttpResponse& response) {
+        std::lock_guard<std::mutex> lock(mutex());
+        routes()[path] = response;
+    }
+
+    static void serve(const char* path, const std::string& body) {
+        HostHttpResponse response;
+        response.body = body;
+        serve(path, response);
+    }
+
+    // Forget the routes and zero the counters
+    static void reset() {
+        std::lock_guard<std::mutex> lock(mutex());
+        routes().clear();
+        paths.clear();
+        reachable = true;
+        handshakeMs = 0;
+        connects = requests = active = peakActive = 0;
+    }
+
+    // "https://host/v1/a:b?x=1" -> "/v1/a:b"
+    static std::string pathOf(const char* url) {
+        const char* p = strstr(url, "://");
+        p = p ? strchr(p + 3, '/') : url;
+        if (!p) return "/";
+        return std::string(p, strcspn(p, "?#"));
+    }
+
+    // The response for url, or a 404 when no route matches. Counts the
+    // request as active until finish().
+    static HostHttpResponse begin(const char* url) {
+        std::string path = pathOf(url);
+        HostHttpResponse response;
+        {
+            std::lock_guard<std::mutex> lock(mutex());
+            requests++;
+            paths.push_back(path);
+            if (++active > peakActive) peakActive = active;
+            auto it = routes().find(path);
+            if (it != routes().end()) response = it->second;
+            else response.status = 404;
+        }
+        if (response.latencyMs) delay(response.latencyMs);
+        return response;
+    }
+
+    static void finish() {
+        std::lock_guard<std::mutex> lock(mutex());
+        active--;
+    }
+
+    // The bytes of the body as they go over the connection
+    static std::string wireBody(const HostHttpResponse& response) {
+        if (!response.chunked) return response.body;
+        std::string wire;
+        char header[16];
+        for (size_t pos = 0; pos < response.body.size(); pos += response.chunkBytes) {
+            size_t n = min(response.chunkBytes, response.body.size() - pos);
+            snprintf(header, sizeof(header), "%zx\r\n", n);
+            wire += header;
+            wire.append(response.body, pos, n);
+            wire += "\r\n";
+        }
+        return wire + "0\r\n\r\n";
+    }
+
+private:
+    static std::map<std::string, HostHttpResponse>& routes() {
+        static std::map<std::string, HostHttpResponse> r;
+        return r;
+    }
+};
+
+#endif
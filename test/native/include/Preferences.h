@@ -0,0 +1,66 @@
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+// Host stand-in for the ESP32 NVS Preferences: keys live in one in-memory
+// map for the whole process, so a test can reopen a namespace and read back
+// what an earlier "wake" stored. puts counts writes, to check flash wear.
+
+#include <Arduino.h>
+#include <map>
+#include <string>
+#include <vector>
+
+class Preferences {
+public:
+    static std::map<std::string, std::vector<uint8_t>>& store() {
+        static std::map<std::string, std::vector<uint8_t>> entries;
+        return entries;
+    }
+    static inline int puts = 0;
+
+    bool begin(const char* name, bool readOnly = false) {
+        _namespace = name;
+        _readOnly = readOnly;
+        return true;
+    }
+    void end() {}
+    bool clear() {
+        auto& entries = store();
+        for (auto it = entries.begin(); it != entries.end();) {
+            it = it->first.compare(0, _namespace.size() + 1, _namespace + "/") == 0 ? entries.erase(it) : std::next(it);
+        }
+        return true;
+    }
+
+    int32_t getInt(const char* key, int32_t defaultValue = 0) {
+        int32_t value;
+        return getBytes(key, &value, sizeof(value)) == sizeof(value) ? value : defaultValue;
+    }
+    size_t putInt(const char* key, int32_t value) { return putBytes(key, &value, sizeof(value)); }
+
+    size_t getBytesLength(const char* key) {
+        auto it = store().find(path(key));
+        return it == store().end() ? 0 : it->second.size();
+    }
+    size_t getBytes(const char* key, void* buffer, size_t length) {
+        auto it = store().find(path(key));
+        if (it == store().end() || it->second.size() > length) return 0;
+        memcpy(buffer, it->second.data(), it->second.size());
+        return it->second.size();
+    }
+    size_t putBytes(const char* key, const void* value, size_t length) {
+        if (_readOnly) return 0;
+        puts++;
+        const uint8_t* bytes = static_cast<const uint8_t*>(value);
+        store()[path(key)].assign(bytes, bytes + length);
+        return length;
+    }
+
+private:
+    std::string _namespace;
+    bool _readOnly = false;
+
+    std::string path(const char* key) const { return _namespace + "/" + key; }
+};
+
+#endif
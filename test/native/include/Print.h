@@ -0,0 +1,7 @@
+#ifndef HOST_PRINT_H
+#define HOST_PRINT_H
+
+// The core splits these out of Arduino.h; the stand-in keeps them together
+#include <Arduino.h>
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+// The core splits these out of Arduino.h; the stand-in keeps them together
+#include <Arduino.h>
+
+#endif
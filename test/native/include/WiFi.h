@@ -0,0 +1,80 @@
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+// Host stand-in for the ESP32 WiFi station. It starts connected, so code
+// that only checks status() runs its network path; begin() connects after
+// connectDelayMs, and a begin() aimed at a BSSID fails when fastConnectWorks
+// is false, to exercise WiFiConnector's fallback.
+
+#include <Arduino.h>
+
+#define WL_IDLE_STATUS 0
+#define WL_DISCONNECTED 6
+#define WL_CONNECTED 3
+#define WIFI_STA 1
+#define WIFI_AUTH_OPEN 0
+
+class IPAddress : public Printable {
+public:
+    IPAddress(uint32_t address = 0) : _address(address) {}
+    operator uint32_t() const { return _address; }
+    size_t printTo(Print& p) const override {
+        return p.printf("%u.%u.%u.%u", (unsigned)(_address & 0xFF), (unsigned)(_address >> 8 & 0xFF),
+                        (unsigned)(_address >> 16 & 0xFF), (unsigned)(_address >> 24));
+    }
+
+private:
+    uint32_t _address;
+};
+
+class WiFiClass {
+public:
+    uint32_t connectDelayMs = 0;
+    bool fastConnectWorks = true;
+    int begins = 0;
+    int fastBegins = 0;
+
+    void persistent(bool) {}
+    void mode(int) {}
+    bool config(IPAddress, IPAddress, IPAddress, IPAddress = IPAddress(), IPAddress = IPAddress()) { return true; }
+    void begin(const char*, const char*, int32_t channel = 0, const uint8_t* bssid = nullptr) {
+        (void)channel;
+        begins++;
+        _begun = 0;
+        _connected = false;
+        if (bssid) {
+            fastBegins++;
+            if (!fastConnectWorks) return;
+        }
+        _begun = millis() + 1;
+    }
+    void disconnect() {
+        _begun = 0;
+        _connected = false;
+    }
+    int status() {
+        if (!_connected && _begun && millis() + 1 - _begun >= connectDelayMs) _connected = true;
+        return _connected ? WL_CONNECTED : WL_DISCONNECTED;
+    }
+
+    const uint8_t* BSSID() { return _bssid; }
+    int32_t channel() { return 6; }
+    IPAddress localIP() { return IPAddress(0x0A00A8C0); }
+    IPAddress gatewayIP() { return IPAddress(0x0100A8C0); }
+    IPAddress subnetMask() { return IPAddress(0x00FFFFFF); }
+    IPAddress dnsIP(uint8_t i = 0) { return IPAddress(i ? 0 : 0x0100A8C0); }
+
+    int16_t scanNetworks() { return 1; }
+    String SSID(uint8_t = 0) { return String("host"); }
+    int32_t RSSI(uint8_t = 0) { return -50; }
+    int encryptionType(uint8_t = 0) { return WIFI_AUTH_OPEN; }
+
+private:
+    bool _connected = true;
+    unsigned long _begun = 0;
+    uint8_t _bssid[6] = {0x02, 0, 0, 0, 0, 1};
+};
+
+inline WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef HOST_WIFI_CLIENT_SECURE_H
+#define HOST_WIFI_CLIENT_SECURE_H
+
+// Host stand-in for the TLS client, connected to HostHttp. A connection
+// stays up (kept alive) until stop(); reads return the response body that
+// HTTPClient::GET() queued on it.
+#include <Arduino.h>
+#include "HostHttp.h"
+
+class WiFiClientSecure : public Stream {
+public:
+    void setInsecure() {}
+    void setCACert(const char*) {}
+    void setHandshakeTimeout(unsigned long) {}
+
+    int connect(const char* host, uint16_t port) {
+        (void)host;
+        (void)port;
+        if (HostHttp::handshakeMs) delay(HostHttp::handshakeMs);
+        if (!HostHttp::reachable) return 0;
+        {
+            std::lock_guard<std::mutex> lock(HostHttp::mutex());
+            HostHttp::connects++;
+        }
+        _connected = true;
+        return 1;
+    }
+    bool connected() { return _connected; }
+    void stop() {
+        _connected = false;
+        _incoming.clear();
+        _pos = 0;
+    }
+
+    // Called by HTTPClient with the bytes the server sent
+    void receive(const std::string& bytes) {
+        _incoming = bytes;
+        _pos = 0;
+    }
+
+    size_t write(uint8_t) override { return _connected ? 1 : 0; }
+    using Print::write;
+    int available() override { return (int)(_incoming.size() - _pos); }
+    int read() override { return _pos < _incoming.size() ? (uint8_t)_incoming[_pos++] : -1; }
+    int peek() override { return _pos < _incoming.size() ? (uint8_t)_incoming[_pos] : -1; }
+    size_t readBytes(char* buffer, size_t length) override {
+        size_t n = min(length, _incoming.size() - _pos);
+        memcpy(buffer, _incoming.data() + _pos, n);
+        _pos += n;
+        return n;
+    }
+
+private:
+    bool _connected = false;
+    std::string _incoming;
+    size_t _pos = 0;
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef HOST_GXEPD2_730C_GDEP073E01_H
+#define HOST_GXEPD2_730C_GDEP073E01_H
+
+// Host stand-in for the 7.3" 7-colour panel driver. Whatever is written to
+// the controller lands in HostPanel::frame, in the panel's native format:
+// two pixels a byte, high nibble first, colours numbered as in color7().
+
+#include <Arduino.h>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct HostPanelWrite {
+    int16_t y;
+    int16_t h;
+    unsigned long startUs;
+    unsigned long endUs;
+};
+
+struct HostPanel {
+    static const uint16_t WIDTH = 800;
+    static const uint16_t HEIGHT = 480;
+    static inline uint8_t frame[WIDTH / 2 * HEIGHT];
+    static inline int refreshes = 0;
+    static inline int writes = 0;
+    // Sleep per writeNative(), to stand in for the SPI transfer time
+    static inline uint32_t writeDelayUs = 0;
+    // Every writeNative() since reset(), in order
+    static inline std::vector<HostPanelWrite> writeLog;
+
+    static void reset() {
+        memset(frame, 0, sizeof(frame));
+        refreshes = 0;
+        writes = 0;
+        writeLog.clear();
+    }
+};
+
+class GxEPD2_730c_GDEP073E01 {
+public:
+    static const uint16_t WIDTH = HostPanel::WIDTH;
+    static const uint16_t WIDTH_VISIBLE = WIDTH;
+    static const uint16_t HEIGHT = HostPanel::HEIGHT;
+
+    GxEPD2_730c_GDEP073E01(int16_t cs, int16_t dc, int16_t rst, int16_t busy) {
+        (void)cs;
+        (void)dc;
+        (void)rst;
+        (void)busy;
+    }
+
+    void init(uint32_t = 0, bool = true, uint16_t = 10, bool = false) {}
+    void setPaged() {}
+    void writeNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h,
+                     bool invert = false, bool mirror_y = false, bool pgm = false) {
+        (void)data2;
+        (void)invert;
+        (void)mirror_y;
+        (void)pgm;
+        unsigned long startUs = micros();
+        if (HostPanel::writeDelayUs) std::this_thread::sleep_for(std::chrono::microseconds(HostPanel::writeDelayUs));
+        HostPanel::writes++;
+        HostPanel::writeLog.push_back({y, h, startUs, micros()});
+        if (!data1) return;
+        for (int16_t row = 0; row < h; row++) {
+            memcpy(HostPanel::frame + ((y + row) * WIDTH + x) / 2, data1 + (size_t)row * w / 2, w / 2);
+        }
+    }
+    void refresh(bool partial = false) {
+        (void)partial;
+        HostPanel::refreshes++;
+    }
+    void powerOff() {}
+    void hibernate() {}
+};
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+// Host stand-in for the FreeRTOS queues, semaphores and tasks the firmware
+// uses, built on std::thread. Ticks are milliseconds. Semaphores are queues
+// of zero-size items, as they are in FreeRTOS.
+
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdPASS 1
+#define pdFAIL 0
+#define pdTRUE 1
+#define pdFALSE 0
+#define portMAX_DELAY 0xffffffffu
+#define portTICK_PERIOD_MS 1
+#define configTICK_RATE_HZ 1000
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define tskNO_AFFINITY 0x7fffffff
+
+struct HostQueue {
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::vector<uint8_t>> items;
+    size_t length;
+    size_t itemSize;
+};
+
+typedef HostQueue* QueueHandle_t;
+typedef HostQueue* SemaphoreHandle_t;
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+// Called on the sending thread before each item is queued, so a test can
+// trace hand-offs between tasks or stand in for the time spent producing
+// the item
+inline void (*hostQueueSendHook)(QueueHandle_t q) = nullptr;
+
+// Waits on the queue's condition for up to ticks, forever at portMAX_DELAY
+template <typename Pred>
+inline bool hostQueueWait(HostQueue* q, std::unique_lock<std::mutex>& lock, TickType_t ticks, Pred ready) {
+    if (ticks == portMAX_DELAY) {
+        q->changed.wait(lock, ready);
+        return true;
+    }
+    return q->changed.wait_for(lock, std::chrono::milliseconds(ticks), ready);
+}
+
+inline QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    HostQueue* q = new HostQueue;
+    q->length = length;
+    q->itemSize = itemSize;
+    return q;
+}
+
+inline BaseType_t xQueueSend(QueueHandle_t q, const void* item, TickType_t ticks) {
+    if (hostQueueSendHook) hostQueueSendHook(q);
+    std::unique_lock<std::mutex> lock(q->mutex);
+    if (!hostQueueWait(q, lock, ticks, [q] { return q->items.size() < q->length; })) return pdFALSE;
+    const uint8_t* bytes = static_cast<const uint8_t*>(item);
+    q->items.emplace_back(bytes, bytes + (bytes ? q->itemSize : 0));
+    q->changed.notify_all();
+    return pdPASS;
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t q, void* item, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(q->mutex);
+    if (!hostQueueWait(q, lock, ticks, [q] { return !q->items.empty(); })) return pdFALSE;
+    if (item && q->itemSize) memcpy(item, q->items.front().data(), q->itemSize);
+    q->items.pop_front();
+    q->changed.notify_all();
+    return pdTRUE;
+}
+
+inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+    std::lock_guard<std::mutex> lock(q->mutex);
+    return q->items.size();
+}
+
+inline void vQueueDelete(QueueHandle_t q) { delete q; }
+
+inline SemaphoreHandle_t xSemaphoreCreateBinary() { return xQueueCreate(1, 0); }
+
+inline SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount) {
+    SemaphoreHandle_t s = xQueueCreate(maxCount, 0);
+    for (UBaseType_t i = 0; i < initialCount; i++) xQueueSend(s, nullptr, 0);
+    return s;
+}
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { return xSemaphoreCreateCounting(1, 1); }
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t s) { return xQueueSend(s, nullptr, 0); }
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks) { return xQueueReceive(s, nullptr, ticks); }
+inline void vSemaphoreDelete(SemaphoreHandle_t s) { delete s; }
+
+// Tasks run detached and must end in vTaskDelete(NULL), as on the device
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char* name, uint32_t stackDepth, void* params,
+                                          UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+    (void)name;
+    (void)stackDepth;
+    (void)priority;
+    (void)core;
+    if (handle) *handle = nullptr;
+    std::thread(task, params).detach();
+    return pdPASS;
+}
+
+inline BaseType_t xTaskCreate(TaskFunction_t task, const char* name, uint32_t stackDepth, void* params,
+                              UBaseType_t priority, TaskHandle_t* handle) {
+    return xTaskCreatePinnedToCore(task, name, stackDepth, params, priority, handle, tskNO_AFFINITY);
+}
+
+inline void vTaskDelete(TaskHandle_t task) { (void)task; }
+
+inline void vTaskDelay(TickType_t ticks) { std::this_thread::sleep_for(std::chrono::milliseconds(ticks)); }
+
+inline TickType_t xTaskGetTickCount() {
+    using namespace std::chrono;
+    return (TickType_t)duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+#endif
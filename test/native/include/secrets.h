@@ -0,0 +1,12 @@
+#ifndef HOST_SECRETS_H
+#define HOST_SECRETS_H
+
+// Placeholder credentials for the native build; the device build uses the
+// real src/secrets.h, which is not checked in
+#define WIFI_SSID "host"
+#define WIFI_PASSWORD "host"
+#define GOOGLE_API_KEY "host"
+#define LATITUDE 0.0
+#define LONGITUDE 0.0
+
+#endif
@@ -0,0 +1,174 @@
+// The band pipeline on two host threads, with the ESP32's costs stood in
+// for: HostPanel::writeDelayUs is the SPI transfer of a band and a queue
+// hook delays each finished band by its rasterise time. Checks that bands
+// reach the panel in order with the same pixels as the paged render, and
+// that sending one band overlaps rasterising the next.
+#include <unity.h>
+#include <HostFixtures.h>
+#include <atomic>
+#include <random>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include "Display.h"
+#include "WeatherAPI.h"
+
+static const time_t FIXTURE_TIME = 1767330000; // 2026-01-02 16:00 in Melbourne
+static const int BANDS = HostPanel::HEIGHT / (HostPanel::HEIGHT / 8);
+
+static Display display;
+static WeatherData current;
+static DailyForecast daily[5];
+static HourlyData hourly[24];
+static std::vector<uint8_t> pagedFrames[2];
+
+static std::thread::id loopThread;
+static std::atomic<uint32_t> rasterDelayUs(0);
+static std::vector<unsigned long> bandReadyUs; // When each band was handed to the sender
+
+// Runs as the rasteriser hands over a band: stands in for the time it took
+// and records when it became ready. The done semaphore (no item) is not a band.
+static void rasterHook(QueueHandle_t q) {
+    if (std::this_thread::get_id() == loopThread || q->itemSize == 0) return;
+    if (rasterDelayUs) std::this_thread::sleep_for(std::chrono::microseconds(rasterDelayUs.load()));
+    bandReadyUs.push_back(micros());
+}
+
+static void loadScene() {
+    HostHttp::reset();
+    HostHttp::serve("/v1/forecast/days:lookup", readFixture("weather_daily.json"));
+    HostHttp::serve("/v1/forecast/hours:lookup", readFixture("weather_hourly.json"));
+    HostHttp::serve("/v1/history/hours:lookup", readFixture("weather_history.json"));
+    HostHttp::serve("/v1/currentConditions:lookup", readFixture("weather_current.json"));
+    HourlyData history[24];
+    clearFetchBuffers(current, daily, hourly, history);
+    WeatherClient client;
+    TEST_ASSERT_TRUE(getWeatherCurrentData(client, current));
+    TEST_ASSERT_TRUE(getDailyForecastData(client, daily));
+    TEST_ASSERT_TRUE(getHourlyForecastData(client, 24, hourly));
+    TEST_ASSERT_TRUE(getHistoryData(client, 24, history));
+    for (int i = 0; i < 24; i++) {
+        hourly[i].actualTemp = history[i].actualTemp;
+        hourly[i].actualRain = history[i].actualRain;
+        hourly[i].actualPressure = history[i].actualPressure;
+    }
+}
+
+// Two scenes that differ in the temperature. A scene is never drawn twice in
+// a row, or the unchanged-frame check would skip the refresh.
+static int lastScene = -1;
+
+static unsigned long draw(int scene) {
+    if (scene == lastScene) draw(!scene);
+    lastScene = scene;
+    current.temp = scene ? 31.2 : 24.6;
+    HostPanel::reset();
+    bandReadyUs.clear();
+    unsigned long start = micros();
+    display.drawWeather(current, daily, hourly);
+    return micros() - start;
+}
+
+static std::vector<uint8_t> panelFrame() {
+    return std::vector<uint8_t>(HostPanel::frame, HostPanel::frame + sizeof(HostPanel::frame));
+}
+
+void setUp() {
+    HostPanel::writeDelayUs = 0;
+    rasterDelayUs = 0;
+}
+
+void tearDown() {}
+
+void test_bands_sent_in_order() {
+    draw(0);
+    TEST_ASSERT_EQUAL_INT(1, HostPanel::refreshes);
+    TEST_ASSERT_EQUAL_INT(BANDS, (int)HostPanel::writeLog.size());
+    TEST_ASSERT_EQUAL_INT(BANDS, (int)bandReadyUs.size());
+    for (int band = 0; band < BANDS; band++) {
+        TEST_ASSERT_EQUAL_INT16(band * HostPanel::HEIGHT / BANDS, HostPanel::writeLog[band].y);
+        TEST_ASSERT_EQUAL_INT16(HostPanel::HEIGHT / BANDS, HostPanel::writeLog[band].h);
+    }
+}
+
+void test_frames_match_paged_with_jitter() {
+    // Random costs on both sides change which thread waits for which;
+    // the pixels must not change with them
+    std::mt19937 random(23);
+    std::uniform_int_distribution<uint32_t> delayUs(0, 1500);
+    for (int run = 0; run < 24; run++) {
+        int scene = run % 2;
+        HostPanel::writeDelayUs = delayUs(random);
+        rasterDelayUs = delayUs(random);
+        draw(scene);
+        char message[48];
+        snprintf(message, sizeof(message), "run %d: send %u us, raster %u us", run, (unsigned)HostPanel::writeDelayUs,
+                 (unsigned)rasterDelayUs.load());
+        TEST_ASSERT_TRUE_MESSAGE(panelFrame() == pagedFrames[scene], message);
+    }
+}
+
+static void checkOverlap(uint32_t rasterUs, uint32_t sendUs, int scene) {
+    rasterDelayUs = rasterUs;
+    HostPanel::writeDelayUs = sendUs;
+    unsigned long wallUs = draw(scene);
+    TEST_ASSERT_EQUAL_INT(BANDS, (int)bandReadyUs.size());
+
+    unsigned long serialUs = (unsigned long)BANDS * (rasterUs + sendUs);
+    unsigned long boundUs = (unsigned long)BANDS * max(rasterUs, sendUs);
+    char message[96];
+    snprintf(message, sizeof(message), "raster %u us, send %u us a band: wall %lu us, serial %lu us",
+             (unsigned)rasterUs, (unsigned)sendUs, wallUs, serialUs);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_GREATER_OR_EQUAL_MESSAGE(boundUs, wallUs, message);
+    // At least half the hidden cost must actually be hidden
+    TEST_ASSERT_LESS_THAN_MESSAGE(serialUs - (BANDS - 1) * min(rasterUs, sendUs) / 2, wallUs, message);
+}
+
+void test_send_bound_overlap() {
+    checkOverlap(2000, 8000, 1);
+    // The next band is always ready before the current one has gone out
+    for (int band = 0; band + 1 < BANDS; band++) {
+        TEST_ASSERT_LESS_THAN(HostPanel::writeLog[band].endUs, bandReadyUs[band + 1]);
+    }
+}
+
+void test_raster_bound_overlap() {
+    checkOverlap(8000, 2000, 0);
+    // The sender only ever waits for a band that is not finished yet
+    for (int band = 0; band < BANDS; band++) {
+        TEST_ASSERT_GREATER_OR_EQUAL(bandReadyUs[band], HostPanel::writeLog[band].startUs);
+    }
+}
+
+void test_balanced_overlap() {
+    checkOverlap(5000, 5000, 1);
+}
+
+int main() {
+    setenv("TZ", "AEST-10AEDT,M10.1.0,M4.1.0/3", 1);
+    tzset();
+    setHostTime(FIXTURE_TIME);
+    localTimes.build(FIXTURE_TIME);
+    loopThread = std::this_thread::get_id();
+    display.init();
+
+    UNITY_BEGIN();
+    loadScene();
+    // Reference frames from the paged render, which the pipeline skips to
+    // when two band buffers do not fit
+    uint32_t freeHeap = ESP.freeHeap;
+    ESP.freeHeap = 40000;
+    for (int scene = 0; scene < 2; scene++) {
+        draw(scene);
+        pagedFrames[scene] = panelFrame();
+    }
+    ESP.freeHeap = freeHeap;
+    hostQueueSendHook = rasterHook;
+
+    RUN_TEST(test_bands_sent_in_order);
+    RUN_TEST(test_frames_match_paged_with_jitter);
+    RUN_TEST(test_send_bound_overlap);
+    RUN_TEST(test_raster_bound_overlap);
+    RUN_TEST(test_balanced_overlap);
+    return UNITY_END();
+}
@@ -0,0 +1,208 @@
+// FetchScheduler against the HostHttp stub server: the four requests the
+// firmware makes, each answered after a fixed latency, fetched over one and
+// over several kept-alive connections. The merged weather must not depend
+// on how many connections fetched it, and the requests must overlap.
+#include <unity.h>
+#include <HostFixtures.h>
+#include <mutex>
+#include "FetchScheduler.h"
+#include "WeatherAPI.h"
+
+static const time_t FIXTURE_TIME = 1767330000; // 2026-01-02 16:00 in Melbourne
+static const uint32_t LATENCY_MS = 150;
+
+enum { JOB_HOURLY, JOB_HISTORY, JOB_CURRENT, JOB_DAILY, JOBS };
+
+static const char* const jobPaths[JOBS] = {
+    "/v1/forecast/hours:lookup",
+    "/v1/history/hours:lookup",
+    "/v1/currentConditions:lookup",
+    "/v1/forecast/days:lookup",
+};
+static const char* const jobFixtures[JOBS] = {
+    "weather_hourly.json",
+    "weather_history.json",
+    "weather_current.json",
+    "weather_daily.json",
+};
+
+// One buffer per job, merged by the done handler as in main.cpp
+static WeatherData fetchedCurrent;
+static DailyForecast fetchedDaily[5];
+static HourlyData fetchedForecast[24];
+static HourlyData fetchedHistory[24];
+
+static bool fetchHourly(WeatherClient& client, int hours) { return getHourlyForecastData(client, hours, fetchedForecast); }
+static bool fetchHistory(WeatherClient& client, int hours) { return getHistoryData(client, hours, fetchedHistory); }
+static bool fetchCurrent(WeatherClient& client, int) { return getWeatherCurrentData(client, fetchedCurrent); }
+static bool fetchDaily(WeatherClient& client, int) { return getDailyForecastData(client, fetchedDaily); }
+
+static std::mutex doneLock;
+static int doneCalls[JOBS];
+static bool doneOk[JOBS];
+
+static void saveFetched(int job, bool ok) {
+    std::lock_guard<std::mutex> lock(doneLock);
+    doneCalls[job]++;
+    doneOk[job] = ok;
+    if (!ok) return;
+    switch (job) {
+        case JOB_HOURLY: mergeHourlyForecast(fetchedForecast); break;
+        case JOB_HISTORY: mergeHistory(fetchedHistory); break;
+        case JOB_CURRENT: mergeCurrentWeather(fetchedCurrent); break;
+        case JOB_DAILY: mergeDailyForecast(fetchedDaily); break;
+    }
+}
+
+static void addJobs(FetchScheduler& fetches) {
+    fetches.add("Hourly forecast", fetchHourly, 24, saveFetched, JOB_HOURLY);
+    fetches.add("History", fetchHistory, 24, saveFetched, JOB_HISTORY);
+    fetches.add("Current weather", fetchCurrent, 0, saveFetched, JOB_CURRENT);
+    fetches.add("Daily forecast", fetchDaily, 0, saveFetched, JOB_DAILY);
+}
+
+// The merged weather after a run
+struct Merged {
+    WeatherData current;
+    DailyForecast daily[5];
+    HourlyData hours[24];
+};
+
+static Merged merged() {
+    Merged m;
+    memcpy(&m.current, &currentWeather, sizeof(m.current));
+    memcpy(m.daily, dailyForecasts, sizeof(m.daily));
+    memcpy(m.hours, hourlyData, sizeof(m.hours));
+    return m;
+}
+
+static unsigned long runJobs(uint8_t connections) {
+    FetchScheduler fetches(connections);
+    addJobs(fetches);
+    unsigned long start = millis();
+    fetches.run();
+    return millis() - start;
+}
+
+void setUp() {
+    HostHttp::reset();
+    for (int job = 0; job < JOBS; job++) {
+        HostHttpResponse response;
+        response.body = readFixture(jobFixtures[job]);
+        response.latencyMs = LATENCY_MS;
+        HostHttp::serve(jobPaths[job], response);
+        doneCalls[job] = 0;
+        doneOk[job] = false;
+    }
+    setHostTime(FIXTURE_TIME);
+    localTimes.build(FIXTURE_TIME);
+    clearFetchBuffers(fetchedCurrent, fetchedDaily, fetchedForecast, fetchedHistory);
+    clearWeatherData(currentWeather);
+    for (int i = 0; i < 5; i++) clearDailyForecast(dailyForecasts[i]);
+    for (int i = 0; i < 24; i++) clearHourlyData(hourlyData[i], i);
+}
+
+void tearDown() {}
+
+void test_one_connection_runs_in_order() {
+    unsigned long elapsed = runJobs(1);
+    TEST_ASSERT_EQUAL_INT(1, HostHttp::connects);
+    TEST_ASSERT_EQUAL_INT(1, HostHttp::peakActive);
+    TEST_ASSERT_EQUAL_INT(JOBS, HostHttp::requests);
+    for (int job = 0; job < JOBS; job++) {
+        TEST_ASSERT_EQUAL_STRING(jobPaths[job], HostHttp::paths[job].c_str());
+        TEST_ASSERT_EQUAL_INT(1, doneCalls[job]);
+        TEST_ASSERT_TRUE(doneOk[job]);
+    }
+    TEST_ASSERT_GREATER_OR_EQUAL(JOBS * LATENCY_MS, elapsed);
+}
+
+void test_connections_overlap() {
+    unsigned long elapsed = runJobs(2);
+    TEST_ASSERT_EQUAL_INT(2, HostHttp::connects); // Each kept alive for its second job
+    TEST_ASSERT_EQUAL_INT(2, HostHttp::peakActive);
+    TEST_ASSERT_EQUAL_INT(JOBS, HostHttp::requests);
+    for (int job = 0; job < JOBS; job++) {
+        TEST_ASSERT_EQUAL_INT(1, doneCalls[job]);
+        TEST_ASSERT_TRUE(doneOk[job]);
+    }
+    // Two rounds of latency, not four
+    TEST_ASSERT_LESS_THAN(3 * LATENCY_MS, elapsed);
+}
+
+void test_connections_do_not_change_result() {
+    runJobs(1);
+    Merged serial = merged();
+    for (uint8_t connections = 2; connections <= FetchScheduler::MAX_CONNECTIONS; connections++) {
+        setUp();
+        runJobs(connections);
+        Merged concurrent = merged();
+        TEST_ASSERT_EQUAL_INT(connections, HostHttp::peakActive);
+        TEST_ASSERT_EQUAL_MEMORY(&serial.current, &concurrent.current, sizeof(serial.current));
+        TEST_ASSERT_EQUAL_MEMORY(serial.daily, concurrent.daily, sizeof(serial.daily));
+        TEST_ASSERT_EQUAL_MEMORY(serial.hours, concurrent.hours, sizeof(serial.hours));
+    }
+    TEST_ASSERT_TRUE(serial.current.valid);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 24.6, serial.current.temp);
+}
+
+void test_failed_job_does_not_stop_others() {
+    HostHttpResponse error;
+    error.status = 500;
+    error.body = "{\"error\":{\"code\":500}}";
+    HostHttp::serve(jobPaths[JOB_HISTORY], error);
+    runJobs(2);
+    for (int job = 0; job < JOBS; job++) {
+        TEST_ASSERT_EQUAL_INT(1, doneCalls[job]);
+        TEST_ASSERT_EQUAL(job != JOB_HISTORY, doneOk[job]);
+    }
+    // Nothing from the failed request was merged
+    for (int hour = 0; hour < 24; hour++) {
+        TEST_ASSERT_EQUAL_FLOAT(-100, hourlyData[hour].actualTemp);
+    }
+}
+
+void test_unreachable_server_fails_every_job() {
+    HostHttp::reachable = false;
+    runJobs(2);
+    TEST_ASSERT_EQUAL_INT(0, HostHttp::requests);
+    for (int job = 0; job < JOBS; job++) {
+        TEST_ASSERT_EQUAL_INT(1, doneCalls[job]);
+        TEST_ASSERT_FALSE(doneOk[job]);
+    }
+}
+
+void test_more_connections_than_jobs() {
+    FetchScheduler fetches(FetchScheduler::MAX_CONNECTIONS);
+    fetches.add("Current weather", fetchCurrent, 0, saveFetched, JOB_CURRENT);
+    fetches.run();
+    TEST_ASSERT_EQUAL_INT(1, HostHttp::connects);
+    TEST_ASSERT_EQUAL_INT(1, doneCalls[JOB_CURRENT]);
+    TEST_ASSERT_TRUE(doneOk[JOB_CURRENT]);
+}
+
+void test_queue_limit() {
+    FetchScheduler fetches;
+    for (int i = 0; i < FetchScheduler::MAX_JOBS; i++) {
+        TEST_ASSERT_TRUE(fetches.add("Current weather", fetchCurrent, 0, nullptr, 0));
+    }
+    TEST_ASSERT_FALSE(fetches.add("Current weather", fetchCurrent, 0, nullptr, 0));
+    TEST_ASSERT_EQUAL_UINT8(FetchScheduler::MAX_JOBS, fetches.jobCount());
+    fetches.run();
+    TEST_ASSERT_EQUAL_INT(FetchScheduler::MAX_JOBS, HostHttp::requests);
+    TEST_ASSERT_LESS_OR_EQUAL(FETCH_MAX_CONNECTIONS, HostHttp::peakActive);
+}
+
+int main() {
+    setenv("TZ", "AEST-10AEDT,M10.1.0,M4.1.0/3", 1);
+    tzset();
+    UNITY_BEGIN();
+    RUN_TEST(test_one_connection_runs_in_order);
+    RUN_TEST(test_connections_overlap);
+    RUN_TEST(test_connections_do_not_change_result);
+    RUN_TEST(test_failed_job_does_not_stop_others);
+    RUN_TEST(test_unreachable_server_fails_every_job);
+    RUN_TEST(test_more_connections_than_jobs);
+    RUN_TEST(test_queue_limit);
+    return UNITY_END();
+}
@@ -0,0 +1,158 @@
+// FixedTrig against libm over every binary angle: the error of the Q15
+// table, its symmetries, the angle conversions and the rotate / polar
+// helpers the icons and the wind arrow use. The timings at the end compare
+// a lookup with sinf and sin on the host, which only hints at the ratio on
+// the board.
+//
+//   pio test -e native -f test_fixed_trig -v
+#include <unity.h>
+#include <chrono>
+#include <math.h>
+#include "FixedTrig.h"
+
+#ifndef BENCH_ITERATIONS
+#define BENCH_ITERATIONS 100
+#endif
+
+static double radiansOf(uint32_t angle) {
+    return angle * (2 * M_PI / FIXED_ANGLE_TURN);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_cardinal_angles() {
+    TEST_ASSERT_EQUAL_INT32(0, fixedSin(0));
+    TEST_ASSERT_EQUAL_INT32(FIXED_TRIG_ONE, fixedSin(16384));
+    TEST_ASSERT_EQUAL_INT32(0, fixedSin(32768));
+    TEST_ASSERT_EQUAL_INT32(-FIXED_TRIG_ONE, fixedSin(49152));
+    TEST_ASSERT_EQUAL_INT32(FIXED_TRIG_ONE, fixedCos(0));
+    TEST_ASSERT_EQUAL_INT32(-FIXED_TRIG_ONE, fixedCos(32768));
+}
+
+void test_sin_error() {
+    double maxError = 0;
+    double sumError = 0;
+    uint32_t worst = 0;
+    for (uint32_t angle = 0; angle < FIXED_ANGLE_TURN; angle++) {
+        double error = fabs(fixedSin(angle) - FIXED_TRIG_ONE * sin(radiansOf(angle)));
+        sumError += error;
+        if (error > maxError) {
+            maxError = error;
+            worst = angle;
+        }
+    }
+    char message[96];
+    snprintf(message, sizeof(message), "sin error: max %.3f LSB (angle %u), mean %.3f LSB", maxError, (unsigned)worst,
+             sumError / FIXED_ANGLE_TURN);
+    TEST_MESSAGE(message);
+    // Interpolating 256 steps a quadrant is good to about one Q15 step
+    TEST_ASSERT_TRUE_MESSAGE(maxError < 1.5, message);
+}
+
+void test_symmetry() {
+    for (uint32_t angle = 0; angle < FIXED_ANGLE_TURN; angle++) {
+        uint16_t a = angle;
+        // Half a turn on is exactly the negation; the quadrant fold makes
+        // the reflections exact as well
+        TEST_ASSERT_EQUAL_INT32(-fixedSin(a), fixedSin(a + 32768));
+        TEST_ASSERT_EQUAL_INT32(fixedSin(a), fixedSin(32768 - a));
+        TEST_ASSERT_EQUAL_INT32(-fixedSin(a), fixedSin(-a));
+        TEST_ASSERT_TRUE(labs(fixedSin(a)) <= FIXED_TRIG_ONE);
+        // A unit vector stays within a few LSB of unit length
+        int64_t s = fixedSin(a), c = fixedCos(a);
+        double length = sqrt((double)(s * s + c * c));
+        TEST_ASSERT_TRUE(fabs(length - FIXED_TRIG_ONE) <= 1.5);
+    }
+}
+
+void test_angle_conversions() {
+    TEST_ASSERT_EQUAL_UINT16(0, fixedAngleDegrees(0));
+    TEST_ASSERT_EQUAL_UINT16(16384, fixedAngleDegrees(90));
+    TEST_ASSERT_EQUAL_UINT16(32768, fixedAngleDegrees(180));
+    TEST_ASSERT_EQUAL_UINT16(0, fixedAngleDegrees(360));
+    TEST_ASSERT_EQUAL_UINT16(49152, fixedAngleDegrees(-90));
+    TEST_ASSERT_EQUAL_UINT16(8192, fixedAngleDegrees(405)); // Wraps past a turn
+    TEST_ASSERT_EQUAL_UINT16(16384, fixedAngleRadians(PI / 2));
+    TEST_ASSERT_EQUAL_UINT16(32768, fixedAngleRadians(-PI));
+    // Each wind direction the API reports (whole degrees) within half a step
+    for (int degrees = 0; degrees < 360; degrees++) {
+        double exact = degrees * (FIXED_ANGLE_TURN / 360.0);
+        TEST_ASSERT_TRUE(fabs(fixedAngleDegrees(degrees) - exact) <= 0.5);
+    }
+}
+
+void test_polar_matches_float() {
+    // Screen points on circles up to the size of the largest dial. The
+    // coordinates truncate towards -inf, so they are compared with floor()
+    // of the exact point; the table error can only tip a value lying just
+    // above a whole pixel onto the pixel below.
+    const int16_t radii[] = {1, 7, 20, 45, 120, 400};
+    int points = 0, offByOne = 0;
+    for (int16_t r : radii) {
+        for (uint32_t angle = 0; angle < FIXED_ANGLE_TURN; angle += 97) {
+            int16_t x, y;
+            fixedPolar(300, 200, r, angle, x, y);
+            double fx = floor(300 + r * cos(radiansOf(angle)));
+            double fy = floor(200 + r * sin(radiansOf(angle)));
+            char message[48];
+            snprintf(message, sizeof(message), "r %d angle %u", r, (unsigned)angle);
+            TEST_ASSERT_TRUE_MESSAGE(fabs(x - fx) <= 1.0 && fabs(y - fy) <= 1.0, message);
+            points += 2;
+            offByOne += (x != fx) + (y != fy);
+        }
+    }
+    char message[64];
+    snprintf(message, sizeof(message), "polar: %d of %d coordinates a pixel off", offByOne, points);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_THAN(points / 100, offByOne);
+}
+
+void test_rotate_quarter_turns() {
+    int16_t x, y;
+    fixedRotate(10, 3, 16384, x, y); // Clockwise on screen with y down
+    TEST_ASSERT_EQUAL_INT16(-3, x);
+    TEST_ASSERT_EQUAL_INT16(10, y);
+    fixedRotate(10, 3, 32768, x, y);
+    TEST_ASSERT_EQUAL_INT16(-10, x);
+    TEST_ASSERT_EQUAL_INT16(-3, y);
+    fixedRotate(10, 3, 0, x, y);
+    TEST_ASSERT_EQUAL_INT16(10, x);
+    TEST_ASSERT_EQUAL_INT16(3, y);
+}
+
+template <typename Fn>
+static double nanosPerCall(Fn fn) {
+    volatile int64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        int64_t sum = 0;
+        for (uint32_t angle = 0; angle < FIXED_ANGLE_TURN; angle++) sum += fn((uint16_t)(angle * 40503u));
+        sink = sink + sum;
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / BENCH_ITERATIONS / FIXED_ANGLE_TURN;
+}
+
+void test_speed() {
+    // Angles in a scattered order, as the icons ask for them
+    const float toRadians = 2 * PI / FIXED_ANGLE_TURN;
+    double fixedNs = nanosPerCall([](uint16_t a) { return fixedSin(a); });
+    double sinfNs = nanosPerCall([=](uint16_t a) { return (int64_t)(FIXED_TRIG_ONE * sinf(a * toRadians)); });
+    double sinNs = nanosPerCall([](uint16_t a) { return (int64_t)(FIXED_TRIG_ONE * sin(radiansOf(a))); });
+    char message[96];
+    snprintf(message, sizeof(message), "fixedSin %.2f ns, sinf %.2f ns, sin %.2f ns a call", fixedNs, sinfNs, sinNs);
+    TEST_MESSAGE(message);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_cardinal_angles);
+    RUN_TEST(test_sin_error);
+    RUN_TEST(test_symmetry);
+    RUN_TEST(test_angle_conversions);
+    RUN_TEST(test_polar_matches_float);
+    RUN_TEST(test_rotate_quarter_turns);
+    RUN_TEST(test_speed);
+    return UNITY_END();
+}
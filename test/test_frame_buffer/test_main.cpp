@@ -0,0 +1,146 @@
+// FrameBuffer's span fills against a pixel-by-pixel reference: every start
+// alignment, length, clip and colour must give the same bytes, and the
+// packed-byte / word fills are timed against drawing each pixel.
+//
+//   pio test -e native -f test_frame_buffer -v
+#include <unity.h>
+#include <chrono>
+#include "FrameBuffer.h"
+
+#ifndef BENCH_ITERATIONS
+#define BENCH_ITERATIONS 200
+#endif
+
+static const int16_t WIDTH = 800;
+static const int16_t ROWS = 60;
+
+static FrameBuffer spans(WIDTH, 480);
+static FrameBuffer pixels(WIDTH, 480);
+
+static const uint16_t colors[] = {GxEPD_BLACK, GxEPD_WHITE, GxEPD_GREEN, GxEPD_BLUE,
+                                  GxEPD_RED,   GxEPD_YELLOW, GxEPD_ORANGE, 0x8410};
+
+// What drawFastHLine and friends did before spans: one drawPixel each
+static void pixelRect(FrameBuffer& fb, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t j = y; j < y + h; j++) {
+        for (int16_t i = x; i < x + w; i++) fb.drawPixel(i, j, color);
+    }
+}
+
+static bool sameBytes() {
+    for (uint8_t i = 0; i < spans.chunkCount(); i++) {
+        if (memcmp(spans.chunk(i), pixels.chunk(i), spans.chunkBytes(i)) != 0) return false;
+    }
+    return true;
+}
+
+// A background that is not one colour, so a stray write to a neighbouring
+// nibble shows
+static void fillBackground() {
+    for (int16_t y = 0; y < ROWS; y++) {
+        for (int16_t x = 0; x < WIDTH; x++) {
+            uint16_t color = colors[(x * 3 + y) % 7];
+            spans.drawPixel(x, spans.top() + y, color);
+            pixels.drawPixel(x, pixels.top() + y, color);
+        }
+    }
+}
+
+void setUp() {
+    TEST_ASSERT_TRUE(spans.allocate(ROWS, 16));
+    TEST_ASSERT_TRUE(pixels.allocate(ROWS, 16));
+    spans.setTop(120);
+    pixels.setTop(120);
+    fillBackground();
+}
+
+void tearDown() {
+    spans.release();
+    pixels.release();
+}
+
+void test_hline_alignments() {
+    int16_t y = 130;
+    for (int16_t x = 0; x < 12; x++) {
+        for (int16_t w = 1; w < 48; w++) {
+            uint16_t color = colors[(x + w) % 8];
+            spans.drawFastHLine(x, y, w, color);
+            pixelRect(pixels, x, y, w, 1, color);
+            char message[32];
+            snprintf(message, sizeof(message), "x %d w %d", x, w);
+            TEST_ASSERT_TRUE_MESSAGE(sameBytes(), message);
+        }
+    }
+}
+
+void test_rects_clip() {
+    // Off each edge of the screen and of the held rows (120..179)
+    const int16_t rects[][4] = {
+        {-5, 125, 12, 3},  {795, 125, 12, 3}, {-10, 100, 900, 30}, {301, 170, 40, 30},
+        {0, 119, 1, 1},    {799, 179, 1, 1},  {400, 180, 5, 5},    {-20, 130, 10, 2},
+        {0, 120, 800, 60},
+    };
+    for (const auto& r : rects) {
+        spans.fillRect(r[0], r[1], r[2], r[3], GxEPD_RED);
+        // The reference clips per pixel in drawPixel
+        pixelRect(pixels, r[0], r[1], r[2], r[3], GxEPD_RED);
+        char message[48];
+        snprintf(message, sizeof(message), "rect %d,%d %dx%d", r[0], r[1], r[2], r[3]);
+        TEST_ASSERT_TRUE_MESSAGE(sameBytes(), message);
+    }
+}
+
+void test_vlines() {
+    for (int16_t x = 0; x < 8; x++) {
+        spans.drawFastVLine(x, 118, 10 + x, colors[x]);
+        pixelRect(pixels, x, 118, 1, 10 + x, colors[x]);
+    }
+    TEST_ASSERT_TRUE(sameBytes());
+}
+
+void test_zero_and_negative_lengths() {
+    // Both end points are drawn, as Adafruit_GFX's line-based versions did
+    spans.drawFastHLine(50, 140, 0, GxEPD_BLUE);
+    pixelRect(pixels, 49, 140, 2, 1, GxEPD_BLUE);
+    spans.drawFastHLine(61, 141, -4, GxEPD_GREEN);
+    pixelRect(pixels, 56, 141, 6, 1, GxEPD_GREEN);
+    spans.fillRect(70, 142, 0, 5, GxEPD_BLACK); // Nothing
+    TEST_ASSERT_TRUE(sameBytes());
+}
+
+template <typename Fill>
+static double nanosPerPixel(Fill fill, int16_t w, int16_t h) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) fill(colors[i % 7]);
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / BENCH_ITERATIONS / ((double)w * h);
+}
+
+void test_fill_speed() {
+    // Shapes the weather screen is made of: glyph stems, bar and text run
+    // widths, panel rectangles and the whole band
+    const int16_t shapes[][2] = {{1, 60}, {3, 20}, {17, 8}, {64, 40}, {250, 30}, {800, 60}};
+    for (const auto& s : shapes) {
+        int16_t w = s[0], h = s[1];
+        int16_t x = 101; // Odd, so both partial-byte ends are exercised
+        if (x + w > WIDTH) x = 0;
+        double spanNs = nanosPerPixel([&](uint16_t c) { spans.fillRect(x, 120, w, h, c); }, w, h);
+        double pixelNs = nanosPerPixel([&](uint16_t c) { pixelRect(pixels, x, 120, w, h, c); }, w, h);
+        char message[96];
+        snprintf(message, sizeof(message), "%3dx%-2d: spans %.2f ns/px, pixels %.2f ns/px (%.1fx)", w, h, spanNs,
+                 pixelNs, pixelNs / spanNs);
+        TEST_MESSAGE(message);
+        if (w >= 64) TEST_ASSERT_TRUE_MESSAGE(spanNs < pixelNs, message);
+    }
+    TEST_ASSERT_TRUE(sameBytes());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_hline_alignments);
+    RUN_TEST(test_rects_clip);
+    RUN_TEST(test_vlines);
+    RUN_TEST(test_zero_and_negative_lengths);
+    RUN_TEST(test_fill_speed);
+    return UNITY_END();
+}
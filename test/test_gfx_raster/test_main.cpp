@@ -0,0 +1,209 @@
+// GfxRaster's spans against pixels worked out by hand: pixels are in when
+// their centre is inside the shape, edges are half-open, joins are mitred
+// up to the limit and bevelled beyond it, and each pixel is written once.
+//
+//   pio test -e native -f test_gfx_raster -v
+#include <unity.h>
+#include <string>
+#include "GfxRaster.h"
+
+// A small target that keeps one character per pixel and counts writes,
+// including any that land outside it
+class PixelGrid : public Adafruit_GFX {
+public:
+    static const int16_t W = 24;
+    static const int16_t H = 16;
+    uint8_t writes[H][W];
+    int outside;
+    int hlines;
+
+    PixelGrid() : Adafruit_GFX(W, H) { clear(); }
+
+    void clear() {
+        memset(writes, 0, sizeof(writes));
+        outside = 0;
+        hlines = 0;
+    }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        (void)color;
+        if (x < 0 || y < 0 || x >= W || y >= H) {
+            outside++;
+            return;
+        }
+        writes[y][x]++;
+    }
+
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override {
+        hlines++;
+        for (int16_t i = 0; i < w; i++) drawPixel(x + i, y, color);
+    }
+
+    // Rows [top, top + rows) as '#' / '.', one line each
+    std::string rows(int16_t top, int16_t rows, int16_t width = W) const {
+        std::string s;
+        for (int16_t y = top; y < top + rows; y++) {
+            for (int16_t x = 0; x < width; x++) s += writes[y][x] ? '#' : '.';
+            s += '\n';
+        }
+        return s;
+    }
+
+    int maxWrites() const {
+        int most = 0;
+        for (int16_t y = 0; y < H; y++) {
+            for (int16_t x = 0; x < W; x++) most = max<int>(most, writes[y][x]);
+        }
+        return most;
+    }
+
+    int16_t rightmost() const {
+        int16_t right = -1;
+        for (int16_t y = 0; y < H; y++) {
+            for (int16_t x = 0; x < W; x++) {
+                if (writes[y][x]) right = max(right, x);
+            }
+        }
+        return right;
+    }
+};
+
+// The grid ignores colour
+static const uint16_t INK = 0;
+
+static PixelGrid grid;
+static GfxRaster raster(grid);
+
+void setUp() {
+    grid.clear();
+}
+
+void tearDown() {}
+
+void test_polygon_rectangle() {
+    // Vertices are pixel centres and the right / bottom edges are exclusive
+    RasterPoint box[] = {{2, 2}, {6, 2}, {6, 5}, {2, 5}};
+    raster.fillPolygon(box, 4, INK);
+    TEST_ASSERT_EQUAL_STRING("........\n"
+                             "........\n"
+                             "..####..\n"
+                             "..####..\n"
+                             "..####..\n"
+                             "........\n",
+                             grid.rows(0, 6, 8).c_str());
+    TEST_ASSERT_EQUAL_INT(3, grid.hlines);
+}
+
+void test_polygon_triangle() {
+    // The hypotenuse crosses row r's centre at x = 8 - r
+    RasterPoint triangle[] = {{0, 0}, {8, 0}, {0, 8}};
+    raster.fillPolygon(triangle, 3, INK);
+    TEST_ASSERT_EQUAL_STRING("########..\n"
+                             "#######...\n"
+                             "######....\n"
+                             "#####.....\n"
+                             "####......\n"
+                             "###.......\n"
+                             "##........\n"
+                             "#.........\n"
+                             "..........\n",
+                             grid.rows(0, 9, 10).c_str());
+}
+
+void test_polygon_even_odd() {
+    // A self-intersecting bow tie: the crossings pair up into a left and a
+    // right lobe, which meet in the row through the crossing point
+    RasterPoint bowTie[] = {{0, 0}, {8, 8}, {8, 0}, {0, 8}};
+    raster.fillPolygon(bowTie, 4, INK);
+    TEST_ASSERT_EQUAL_STRING("..........\n"
+                             "#......#..\n"
+                             "##....##..\n"
+                             "###..###..\n"
+                             "########..\n"
+                             "###..###..\n"
+                             "##....##..\n"
+                             "#......#..\n"
+                             "..........\n",
+                             grid.rows(0, 9, 10).c_str());
+}
+
+void test_polygon_clipped_to_target() {
+    RasterPoint box[] = {{-5, -3}, {30, -3}, {30, 2}, {-5, 2}};
+    raster.fillPolygon(box, 4, INK);
+    TEST_ASSERT_EQUAL_INT(0, grid.outside);
+    TEST_ASSERT_EQUAL_STRING("########################\n"
+                             "########################\n"
+                             "........................\n",
+                             grid.rows(0, 3).c_str());
+}
+
+void test_thick_line_butt_ends() {
+    // Width 3 about row 5 covers rows 4-6; the butt ends stop at the end
+    // points' centres, so the last column is not drawn
+    raster.drawThickLine(2, 5, 12, 5, 3, INK);
+    TEST_ASSERT_EQUAL_STRING("..............\n"
+                             "..##########..\n"
+                             "..##########..\n"
+                             "..##########..\n"
+                             "..............\n",
+                             grid.rows(3, 5, 14).c_str());
+}
+
+void test_mitre_join() {
+    // A right angle is well inside the mitre limit, so the outer corner is
+    // square rather than cut off
+    RasterPoint corner[] = {{2, 10}, {10, 10}, {10, 2}};
+    raster.drawPolyline(corner, 3, 4, INK);
+    TEST_ASSERT_EQUAL_STRING("..............\n"
+                             "..............\n"
+                             "........####..\n"
+                             "........####..\n"
+                             "........####..\n"
+                             "........####..\n"
+                             "........####..\n"
+                             "........####..\n"
+                             "..##########..\n"
+                             "..##########..\n"
+                             "..##########..\n"
+                             "..##########..\n"
+                             "..............\n",
+                             grid.rows(0, 13, 14).c_str());
+    // Segments and the join wedge overlap, but merged spans write each
+    // pixel once
+    TEST_ASSERT_EQUAL_INT(1, grid.maxWrites());
+}
+
+void test_bevel_join() {
+    // Doubling back this sharply would put the mitre tip about 13 px past
+    // the corner at x = 20; past the limit the join is bevelled and stays
+    // within half the width of it
+    RasterPoint hairpin[] = {{2, 4}, {20, 4}, {2, 8}};
+    raster.drawPolyline(hairpin, 3, 4, INK);
+    TEST_ASSERT_EQUAL_INT(1, grid.writes[4][20]);
+    TEST_ASSERT_LESS_OR_EQUAL_INT(22, grid.rightmost());
+    TEST_ASSERT_EQUAL_INT(1, grid.maxWrites());
+    TEST_ASSERT_EQUAL_INT(0, grid.outside);
+}
+
+void test_single_point_is_a_square() {
+    RasterPoint dot[] = {{5, 5}, {5, 5}};
+    raster.drawPolyline(dot, 2, 2, INK);
+    TEST_ASSERT_EQUAL_STRING("........\n"
+                             "....##..\n"
+                             "....##..\n"
+                             "........\n",
+                             grid.rows(3, 4, 8).c_str());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_polygon_rectangle);
+    RUN_TEST(test_polygon_triangle);
+    RUN_TEST(test_polygon_even_odd);
+    RUN_TEST(test_polygon_clipped_to_target);
+    RUN_TEST(test_thick_line_butt_ends);
+    RUN_TEST(test_mitre_join);
+    RUN_TEST(test_bevel_join);
+    RUN_TEST(test_single_point_is_a_square);
+    return UNITY_END();
+}
@@ -0,0 +1,240 @@
+// GraphModel on the host: axis ranges and ticks, columns, bars, series,
+// markers and the sun lines for the graph area Display gives it, checked
+// without drawing anything.
+#include <unity.h>
+#include "GraphModel.h"
+
+// Display's graph area: right of the 266 px left column, between the
+// header and the daily forecast
+static const int X = 266, Y = 30, W = 534, H = 320;
+
+static GraphModel model;
+static HourlyData hourly[24];
+static DailyForecast today;
+
+static void build() {
+    model.invalidate();
+    model.build(X, Y, W, H, hourly, today);
+}
+
+void setUp() {
+    for (int i = 0; i < 24; i++) clearHourlyData(hourly[i], i);
+    clearDailyForecast(today);
+}
+
+void tearDown() {}
+
+void test_geometry() {
+    build();
+    TEST_ASSERT_TRUE(model.built());
+    TEST_ASSERT_EQUAL_INT16(X + 40, model.originX);
+    TEST_ASSERT_EQUAL_INT16(W - 40 - 45, model.graphW);
+    TEST_ASSERT_EQUAL_INT16(H - 30 - 10, model.graphH);
+    TEST_ASSERT_EQUAL_INT16(Y + model.graphH, model.originY);
+    TEST_ASSERT_EQUAL_INT16(Y, model.top);
+    // Column centres step across the plot area left to right
+    for (int i = 0; i < 24; i++) {
+        TEST_ASSERT_GREATER_THAN(model.originX, model.columnX[i]);
+        TEST_ASSERT_LESS_THAN(model.originX + model.graphW, model.columnX[i]);
+        if (i > 0) TEST_ASSERT_GREATER_THAN(model.columnX[i - 1], model.columnX[i]);
+    }
+    model.invalidate();
+    TEST_ASSERT_FALSE(model.built());
+}
+
+void test_no_data() {
+    build();
+    // A 0-30 degree axis with the usual padding
+    TEST_ASSERT_EQUAL_FLOAT(-5, model.minAxis);
+    TEST_ASSERT_EQUAL_FLOAT(35, model.maxAxis);
+    TEST_ASSERT_EQUAL_INT(5, model.step);
+    TEST_ASSERT_EQUAL_UINT8(9, model.tempTickCount);
+    TEST_ASSERT_FALSE(model.hasPressure);
+    TEST_ASSERT_EQUAL_UINT8(0, model.pressureTickCount);
+    for (int i = 0; i < 24; i++) {
+        TEST_ASSERT_EQUAL_INT16(GRAPH_NO_VALUE, model.tempY[i]);
+        TEST_ASSERT_EQUAL_INT16(GRAPH_NO_VALUE, model.actualTempY[i]);
+        TEST_ASSERT_EQUAL_INT16(GRAPH_NO_VALUE, model.indoorTempY[i]);
+        TEST_ASSERT_EQUAL_INT16(-1, model.rainBars[i].h);
+        TEST_ASSERT_EQUAL_INT16(-1, model.actualRainBars[i].h);
+    }
+    TEST_ASSERT_FALSE(model.forecastMin.valid);
+    TEST_ASSERT_FALSE(model.forecastMax.valid);
+    TEST_ASSERT_FALSE(model.historyMin.valid);
+    TEST_ASSERT_FALSE(model.historyMax.valid);
+    TEST_ASSERT_EQUAL_INT16(-1, model.sunriseX);
+    TEST_ASSERT_EQUAL_INT16(-1, model.sunsetX);
+}
+
+void test_temperature_axis() {
+    // Forecast 10..20, history down to 8, indoor up to 22: the axis covers
+    // every series
+    for (int i = 0; i < 24; i++) hourly[i].temp = 10 + (i % 11);
+    hourly[3].actualTemp = 8;
+    hourly[5].indoorTemp = 22;
+    build();
+    TEST_ASSERT_EQUAL_FLOAT(3, model.minAxis);
+    TEST_ASSERT_EQUAL_FLOAT(27, model.maxAxis);
+    TEST_ASSERT_EQUAL_INT(5, model.step); // 24 degrees / 8 ticks
+    const int16_t values[] = {5, 10, 15, 20, 25};
+    TEST_ASSERT_EQUAL_UINT8(5, model.tempTickCount);
+    for (int t = 0; t < 5; t++) {
+        TEST_ASSERT_EQUAL_INT16(values[t], model.tempTicks[t].value);
+        // Mapped in float and truncated once, as the series are
+        TEST_ASSERT_EQUAL_INT16((int16_t)(model.originY - (values[t] - 3) * model.graphH / 24.0f), model.tempTicks[t].y);
+    }
+}
+
+void test_tick_steps() {
+    // Range (padding included) over 8 picks the step
+    const float spans[][2] = {{10, 11}, {10, 16}, {10, 30}, {-10, 40}};
+    const int steps[] = {2, 2, 5, 10};
+    for (int s = 0; s < 4; s++) {
+        setUp();
+        hourly[0].temp = spans[s][0];
+        hourly[1].temp = spans[s][1];
+        build();
+        TEST_ASSERT_EQUAL_INT(steps[s], model.step);
+        for (int t = 0; t < model.tempTickCount; t++) {
+            TEST_ASSERT_EQUAL_INT(0, model.tempTicks[t].value % steps[s]);
+            TEST_ASSERT_GREATER_OR_EQUAL(model.top, model.tempTicks[t].y);
+            TEST_ASSERT_LESS_OR_EQUAL(model.originY, model.tempTicks[t].y);
+        }
+    }
+    // The padding makes every axis at least 10 degrees, so even a flat
+    // series gets steps of 2
+    setUp();
+    hourly[0].temp = 10;
+    hourly[1].temp = 10;
+    build();
+    TEST_ASSERT_EQUAL_INT(2, model.step);
+}
+
+void test_series() {
+    hourly[0].temp = 15;
+    hourly[23].temp = 25;
+    hourly[4].actualTemp = 20;
+    hourly[7].indoorTemp = 21.5;
+    build();
+    // Axis 10..30 over graphH pixels
+    TEST_ASSERT_EQUAL_INT16(model.originY - 5 * model.graphH / 20, model.tempY[0]);
+    TEST_ASSERT_EQUAL_INT16(model.originY - 15 * model.graphH / 20, model.tempY[23]);
+    TEST_ASSERT_EQUAL_INT16(model.originY - model.graphH / 2, model.actualTempY[4]);
+    TEST_ASSERT_EQUAL_INT16(GRAPH_NO_VALUE, model.tempY[1]);
+    TEST_ASSERT_EQUAL_INT16(GRAPH_NO_VALUE, model.actualTempY[0]);
+    TEST_ASSERT_EQUAL_INT16((int16_t)(model.originY - 11.5f * model.graphH / 20), model.indoorTempY[7]);
+}
+
+void test_rain_bars() {
+    hourly[0].rainProb = 0;
+    hourly[1].rainProb = 50;
+    hourly[2].rainProb = 100;
+    hourly[3].actualRain = 0;
+    hourly[4].actualRain = 12.5;
+    hourly[5].actualRain = 250; // Past the top of the scale
+    build();
+    int16_t barW = model.graphW / 24 - 2;
+    for (int i = 0; i < 24; i++) {
+        TEST_ASSERT_EQUAL_INT16(model.originX + i * model.graphW / 24 + 1, model.rainBars[i].x);
+        TEST_ASSERT_EQUAL_INT16(barW, model.rainBars[i].w);
+        TEST_ASSERT_EQUAL_INT16(model.rainBars[i].x, model.actualRainBars[i].x);
+    }
+    TEST_ASSERT_EQUAL_INT16(0, model.rainBars[0].h);
+    TEST_ASSERT_EQUAL_INT16(model.originY, model.rainBars[0].y);
+    TEST_ASSERT_EQUAL_INT16(model.graphH / 2, model.rainBars[1].h);
+    TEST_ASSERT_EQUAL_INT16(model.originY - model.graphH / 2, model.rainBars[1].y);
+    TEST_ASSERT_EQUAL_INT16(model.graphH, model.rainBars[2].h);
+    TEST_ASSERT_EQUAL_INT16(-1, model.rainBars[3].h);
+
+    TEST_ASSERT_EQUAL_INT16(0, model.actualRainBars[3].h);
+    TEST_ASSERT_EQUAL_INT16((int16_t)(12.5f * model.graphH / 100), model.actualRainBars[4].h);
+    TEST_ASSERT_EQUAL_INT16(model.graphH, model.actualRainBars[5].h);
+    TEST_ASSERT_EQUAL_INT16(model.top, model.actualRainBars[5].y);
+    TEST_ASSERT_EQUAL_INT16(-1, model.actualRainBars[0].h);
+
+    // Percent axis on the right, 0 at the bottom and 100 at the top
+    for (int i = 0; i < GraphModel::RAIN_TICKS; i++) {
+        TEST_ASSERT_EQUAL_INT16(i * 10, model.rainTicks[i].value);
+    }
+    TEST_ASSERT_EQUAL_INT16(model.originY, model.rainTicks[0].y);
+    TEST_ASSERT_EQUAL_INT16(model.top, model.rainTicks[10].y);
+}
+
+void test_pressure_axis() {
+    for (int i = 0; i < 24; i++) hourly[i].pressure = 1000 + i;
+    hourly[2].actualPressure = 995;
+    hourly[9].indoorPressure = 1025;
+    hourly[10].pressure = -1; // Missing
+    build();
+    TEST_ASSERT_TRUE(model.hasPressure);
+    // 995..1025 with 10 % padding, ticks every 10 hPa
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 992, model.minAxisP);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 1028, model.maxAxisP);
+    const int16_t values[] = {1000, 1010, 1020};
+    TEST_ASSERT_EQUAL_UINT8(3, model.pressureTickCount);
+    for (int t = 0; t < 3; t++) TEST_ASSERT_EQUAL_INT16(values[t], model.pressureTicks[t].value);
+    TEST_ASSERT_EQUAL_INT16(GRAPH_NO_VALUE, model.pressureY[10]);
+    TEST_ASSERT_EQUAL_INT16(GRAPH_NO_VALUE, model.actualPressureY[0]);
+    TEST_ASSERT_EQUAL_INT16((int16_t)(model.originY - (995 - model.minAxisP) * model.graphH / 36), model.actualPressureY[2]);
+    TEST_ASSERT_LESS_THAN(model.pressureY[0], model.pressureY[1]); // Higher pressure, higher up
+}
+
+void test_flat_pressure() {
+    // A steady reading still gets an axis one hPa wide and a tick through it
+    for (int i = 0; i < 24; i++) hourly[i].pressure = 1013;
+    build();
+    TEST_ASSERT_TRUE(model.hasPressure);
+    TEST_ASSERT_EQUAL_UINT8(1, model.pressureTickCount);
+    TEST_ASSERT_EQUAL_INT16(1013, model.pressureTicks[0].value);
+    TEST_ASSERT_INT_WITHIN(1, model.originY - model.graphH / 2, model.pressureY[0]);
+}
+
+void test_markers() {
+    for (int i = 0; i < 24; i++) hourly[i].temp = 15;
+    hourly[6].temp = 9.5;
+    hourly[14].temp = 24;
+    hourly[15].temp = 24; // A tie keeps the first hour
+    hourly[20].temp = 9.5;
+    for (int i = 0; i < 10; i++) hourly[i].actualTemp = 12; // Flat history
+    build();
+    TEST_ASSERT_TRUE(model.forecastMin.valid);
+    TEST_ASSERT_EQUAL_INT16(model.columnX[6], model.forecastMin.x);
+    TEST_ASSERT_EQUAL_INT16(model.tempY[6], model.forecastMin.y);
+    TEST_ASSERT_EQUAL_FLOAT(9.5, model.forecastMin.value);
+    TEST_ASSERT_TRUE(model.forecastMax.valid);
+    TEST_ASSERT_EQUAL_INT16(model.columnX[14], model.forecastMax.x);
+    TEST_ASSERT_EQUAL_FLOAT(24, model.forecastMax.value);
+    // A flat series only gets its min marker
+    TEST_ASSERT_TRUE(model.historyMin.valid);
+    TEST_ASSERT_EQUAL_INT16(model.columnX[0], model.historyMin.x);
+    TEST_ASSERT_FALSE(model.historyMax.valid);
+}
+
+void test_sun_lines() {
+    today.sunrise = 6 * 60;
+    today.sunset = 20 * 60 + 30;
+    build();
+    TEST_ASSERT_EQUAL_INT16(model.originX + model.graphW / 4, model.sunriseX);
+    TEST_ASSERT_EQUAL_INT16(model.originX + (20 * 60 + 30) * model.graphW / 1440, model.sunsetX);
+    // Midnight is treated as unknown
+    today.sunrise = 0;
+    today.sunset = TIME_OF_DAY_NONE;
+    build();
+    TEST_ASSERT_EQUAL_INT16(-1, model.sunriseX);
+    TEST_ASSERT_EQUAL_INT16(-1, model.sunsetX);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_geometry);
+    RUN_TEST(test_no_data);
+    RUN_TEST(test_temperature_axis);
+    RUN_TEST(test_tick_steps);
+    RUN_TEST(test_series);
+    RUN_TEST(test_rain_bars);
+    RUN_TEST(test_pressure_axis);
+    RUN_TEST(test_flat_pressure);
+    RUN_TEST(test_markers);
+    RUN_TEST(test_sun_lines);
+    return UNITY_END();
+}
@@ -0,0 +1,172 @@
+// Feeds the captured responses in test/fixtures to both parsers the firmware
+// can use: JsonSaxParser driven by the generated schema, and ArduinoJson's
+// deserializeJson through a filter built from the same schema. Both must see
+// the same values; the time each takes per response is reported.
+//
+//   pio test -e native -f test_json_bench -v
+#include <unity.h>
+#include <ArduinoJson.h>
+#include <chrono>
+#include <HostFixtures.h>
+#include "WeatherJsonSchema.h"
+
+#ifndef BENCH_ITERATIONS
+#define BENCH_ITERATIONS 200
+#endif
+
+// The response the way the board reads it: a byte at a time or in blocks
+class MemoryStream : public Stream {
+public:
+    explicit MemoryStream(const std::string& data) : _data(data), _pos(0) {}
+
+    int available() override { return _data.size() - _pos; }
+    int read() override { return _pos < _data.size() ? (uint8_t)_data[_pos++] : -1; }
+    int peek() override { return _pos < _data.size() ? (uint8_t)_data[_pos] : -1; }
+    size_t readBytes(char* buffer, size_t length) override {
+        size_t n = std::min(length, _data.size() - _pos);
+        memcpy(buffer, _data.data() + _pos, n);
+        _pos += n;
+        return n;
+    }
+    size_t write(uint8_t) override { return 0; }
+
+private:
+    const std::string& _data;
+    size_t _pos;
+};
+
+class CountingHandler : public JsonSaxHandler {
+public:
+    int records = 0;
+    int values = 0;
+
+    void beginRecord(uint8_t, uint16_t) override { records++; }
+    void value(uint8_t, const JsonSaxValue& value) override {
+        if (value.type != JsonSaxValue::NUL) values++;
+    }
+};
+
+static bool hasChildren(const JsonSchema& schema, uint8_t node) {
+    for (uint8_t i = 1; i < schema.nodeCount; i++) {
+        if (schema.nodes[i].parent == node) return true;
+    }
+    return false;
+}
+
+// The ArduinoJson filter that keeps exactly the schema's paths
+static void buildFilter(const JsonSchema& schema, uint8_t node, JsonObject filter) {
+    for (uint8_t i = 1; i < schema.nodeCount; i++) {
+        const JsonSchemaNode& child = schema.nodes[i];
+        if (child.parent != node) continue;
+        const char* key = schema.keyNames[child.key];
+        if (!hasChildren(schema, i)) {
+            filter[key] = true;
+        } else if (child.flags & JSON_NODE_RECORDS) {
+            buildFilter(schema, i, filter[key].to<JsonArray>().add<JsonObject>());
+        } else {
+            buildFilter(schema, i, filter[key].to<JsonObject>());
+        }
+    }
+}
+
+// Counts what the filtered document kept the same way CountingHandler does
+static void countDocument(const JsonSchema& schema, uint8_t node, JsonObjectConst obj, CountingHandler& counts) {
+    for (uint8_t i = 1; i < schema.nodeCount; i++) {
+        const JsonSchemaNode& child = schema.nodes[i];
+        if (child.parent != node) continue;
+        JsonVariantConst value = obj[schema.keyNames[child.key]];
+        if (value.isNull()) continue;
+        if (!hasChildren(schema, i)) {
+            counts.values++;
+        } else if (child.flags & JSON_NODE_RECORDS) {
+            for (JsonObjectConst record : value.as<JsonArrayConst>()) {
+                counts.records++;
+                countDocument(schema, i, record, counts);
+            }
+        } else {
+            countDocument(schema, i, value.as<JsonObjectConst>(), counts);
+        }
+    }
+}
+
+struct Endpoint {
+    const char* fixture;
+    const JsonSchema& schema;
+};
+
+static const Endpoint endpoints[] = {
+    {"weather_daily.json", dailyJsonSchema},
+    {"weather_hourly.json", hourlyJsonSchema},
+    {"weather_history.json", historyJsonSchema},
+    {"weather_current.json", currentJsonSchema},
+};
+
+static CountingHandler parseSax(const Endpoint& endpoint, const std::string& body) {
+    CountingHandler counts;
+    MemoryStream in(body);
+    JsonSaxParser parser(endpoint.schema, counts);
+    TEST_ASSERT_TRUE_MESSAGE(parser.parse(in), parser.error());
+    return counts;
+}
+
+static CountingHandler parseDocument(const Endpoint& endpoint, const std::string& body, JsonDocument& filter) {
+    CountingHandler counts;
+    MemoryStream in(body);
+    JsonDocument doc;
+    DeserializationError error = deserializeJson(doc, in, DeserializationOption::Filter(filter));
+    TEST_ASSERT_TRUE_MESSAGE(error == DeserializationError::Ok, error.c_str());
+    // The root is the record for currentConditions, as in the schema
+    if (endpoint.schema.nodes[0].flags & JSON_NODE_RECORDS) counts.records++;
+    countDocument(endpoint.schema, 0, doc.as<JsonObjectConst>(), counts);
+    return counts;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_parsers_see_same_values() {
+    for (const Endpoint& endpoint : endpoints) {
+        std::string body = readFixture(endpoint.fixture);
+        TEST_ASSERT_FALSE_MESSAGE(body.empty(), endpoint.fixture);
+        JsonDocument filter;
+        buildFilter(endpoint.schema, 0, filter.to<JsonObject>());
+
+        CountingHandler sax = parseSax(endpoint, body);
+        CountingHandler dom = parseDocument(endpoint, body, filter);
+        TEST_ASSERT_GREATER_THAN_INT_MESSAGE(0, sax.values, endpoint.fixture);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(dom.records, sax.records, endpoint.fixture);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(dom.values, sax.values, endpoint.fixture);
+    }
+}
+
+template <typename Parse>
+static double microsPerParse(Parse parse) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) parse();
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / BENCH_ITERATIONS;
+}
+
+void test_parse_speed() {
+    for (const Endpoint& endpoint : endpoints) {
+        std::string body = readFixture(endpoint.fixture);
+        JsonDocument filter;
+        buildFilter(endpoint.schema, 0, filter.to<JsonObject>());
+
+        double saxUs = microsPerParse([&] { parseSax(endpoint, body); });
+        double domUs = microsPerParse([&] { parseDocument(endpoint, body, filter); });
+
+        // Bytes per microsecond is MB/s
+        char message[160];
+        snprintf(message, sizeof(message), "%s (%u bytes): sax %.1f us (%.1f MB/s), filtered document %.1f us (%.1f MB/s)",
+                 endpoint.fixture, (unsigned)body.size(), saxUs, body.size() / saxUs, domUs, body.size() / domUs);
+        TEST_MESSAGE(message);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_parsers_see_same_values);
+    RUN_TEST(test_parse_speed);
+    return UNITY_END();
+}
@@ -0,0 +1,310 @@
+#include "PanelPng.h"
+#include <esp_rom_crc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const uint8_t SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+// Panel colour order of the nibbles, as in frame_dump.py
+static const uint8_t PALETTE[7][3] = {{0, 0, 0},   {255, 255, 255}, {0, 255, 0},  {0, 0, 255},
+                                      {255, 0, 0}, {255, 255, 0},   {255, 128, 0}};
+
+// Deflate length codes 257..285: base length and extra bits
+static const uint16_t LENGTH_BASE[29] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                         31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                         2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t DISTANCE_BASE[30] = {1,   2,   3,   4,   5,   7,    9,    13,   17,   25,
+                                           33,  49,  65,  97,  129, 193,  257,  385,  513,  769,
+                                           1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const uint8_t DISTANCE_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6,
+                                           6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+static void putBE32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int shift = 24; shift >= 0; shift -= 8) out.push_back(v >> shift);
+}
+
+static uint32_t getBE32(const uint8_t* p) {
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+static uint32_t adler32(const std::vector<uint8_t>& data) {
+    uint32_t a = 1, b = 0;
+    for (uint8_t byte : data) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    return b << 16 | a;
+}
+
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : _out(out) {}
+
+    // Extra bits and header fields go least significant bit first
+    void put(uint32_t value, uint8_t bits) {
+        for (uint8_t i = 0; i < bits; i++) putBit(value >> i & 1);
+    }
+    // Huffman codes go most significant bit first
+    void putCode(uint32_t code, uint8_t bits) {
+        while (bits--) putBit(code >> bits & 1);
+    }
+    void flush() {
+        if (_used) _out.push_back(_byte);
+        _byte = 0;
+        _used = 0;
+    }
+
+private:
+    std::vector<uint8_t>& _out;
+    uint8_t _byte = 0;
+    uint8_t _used = 0;
+
+    void putBit(uint32_t bit) {
+        _byte |= bit << _used;
+        if (++_used == 8) flush();
+    }
+};
+
+// Fixed-Huffman literal/length code for symbol 0..287
+static void putSymbol(BitWriter& bits, uint16_t symbol) {
+    if (symbol < 144) bits.putCode(0x30 + symbol, 8);
+    else if (symbol < 256) bits.putCode(0x190 + symbol - 144, 9);
+    else if (symbol < 280) bits.putCode(symbol - 256, 7);
+    else bits.putCode(0xC0 + symbol - 280, 8);
+}
+
+// One fixed-Huffman block whose only matches are runs of the previous byte
+// (distance 1). Frames are mostly long runs of one colour, so this is enough
+// to keep a golden image small.
+static void deflateRuns(const std::vector<uint8_t>& data, std::vector<uint8_t>& out) {
+    BitWriter bits(out);
+    bits.put(1, 1); // Final block
+    bits.put(1, 2); // Fixed Huffman
+    size_t i = 0;
+    while (i < data.size()) {
+        size_t run = 0;
+        if (i > 0) {
+            while (run < 258 && i + run < data.size() && data[i + run] == data[i - 1]) run++;
+        }
+        if (run < 3) {
+            putSymbol(bits, data[i++]);
+            continue;
+        }
+        uint8_t code = 28;
+        while (LENGTH_BASE[code] > run) code--;
+        putSymbol(bits, 257 + code);
+        bits.put(run - LENGTH_BASE[code], LENGTH_EXTRA[code]);
+        bits.putCode(0, 5); // Distance code 0: one byte back
+        i += run;
+    }
+    putSymbol(bits, 256);
+    bits.flush();
+}
+
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t size) : _data(data), _size(size) {}
+
+    bool failed() const { return _failed; }
+
+    uint32_t get(uint8_t bits) {
+        uint32_t value = 0;
+        for (uint8_t i = 0; i < bits; i++) value |= getBit() << i;
+        return value;
+    }
+    uint32_t getCode(uint8_t bits) {
+        uint32_t code = 0;
+        while (bits--) code = code << 1 | getBit();
+        return code;
+    }
+    void alignToByte() { _bit = (_bit + 7) & ~(size_t)7; }
+    const uint8_t* bytes(size_t count) {
+        const uint8_t* p = _data + _bit / 8;
+        if (_bit / 8 + count > _size) {
+            _failed = true;
+            return nullptr;
+        }
+        _bit += count * 8;
+        return p;
+    }
+
+private:
+    const uint8_t* _data;
+    size_t _size;
+    size_t _bit = 0;
+    bool _failed = false;
+
+    uint32_t getBit() {
+        if (_bit / 8 >= _size) {
+            _failed = true;
+            return 0;
+        }
+        uint32_t bit = _data[_bit / 8] >> (_bit % 8) & 1;
+        _bit++;
+        return bit;
+    }
+};
+
+static int getSymbol(BitReader& bits) {
+    uint32_t code = bits.getCode(7);
+    if (code < 24) return 256 + code;
+    code = code << 1 | bits.getCode(1);
+    if (code >= 0x30 && code < 0xC0) return code - 0x30;
+    if (code >= 0xC0 && code < 0xC8) return 280 + code - 0xC0;
+    code = code << 1 | bits.getCode(1);
+    return 144 + code - 0x190;
+}
+
+static bool inflateZlib(const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+    if (in.size() < 6 || (in[0] & 0x0F) != 8 || ((in[0] << 8) | in[1]) % 31 != 0) return false;
+    BitReader bits(in.data() + 2, in.size() - 6);
+    bool last = false;
+    while (!last) {
+        last = bits.get(1);
+        uint32_t type = bits.get(2);
+        if (type == 0) {
+            bits.alignToByte();
+            const uint8_t* header = bits.bytes(4);
+            if (!header) return false;
+            uint16_t length = header[0] | header[1] << 8;
+            const uint8_t* stored = bits.bytes(length);
+            if (!stored) return false;
+            out.insert(out.end(), stored, stored + length);
+            continue;
+        }
+        if (type != 1) {
+            fprintf(stderr, "PNG uses a dynamic Huffman block, only fixed ones are read\n");
+            return false;
+        }
+        for (;;) {
+            int symbol = getSymbol(bits);
+            if (bits.failed() || symbol > 285) return false;
+            if (symbol < 256) {
+                out.push_back(symbol);
+                continue;
+            }
+            if (symbol == 256) break;
+            size_t length = LENGTH_BASE[symbol - 257] + bits.get(LENGTH_EXTRA[symbol - 257]);
+            uint32_t code = bits.getCode(5);
+            if (code >= 30) return false;
+            size_t distance = DISTANCE_BASE[code] + bits.get(DISTANCE_EXTRA[code]);
+            if (distance > out.size()) return false;
+            for (size_t i = 0; i < length; i++) out.push_back(out[out.size() - distance]);
+        }
+        if (bits.failed()) return false;
+    }
+    return adler32(out) == getBE32(in.data() + in.size() - 4);
+}
+
+static void putChunk(std::vector<uint8_t>& png, const char* type, const std::vector<uint8_t>& data) {
+    putBE32(png, data.size());
+    size_t start = png.size();
+    png.insert(png.end(), type, type + 4);
+    png.insert(png.end(), data.begin(), data.end());
+    putBE32(png, esp_rom_crc32_le(0, png.data() + start, png.size() - start));
+}
+
+bool writePanelPng(const char* path, const uint8_t* frame, uint16_t width, uint16_t height) {
+    std::vector<uint8_t> png(SIGNATURE, SIGNATURE + sizeof(SIGNATURE));
+
+    std::vector<uint8_t> header;
+    putBE32(header, width);
+    putBE32(header, height);
+    header.insert(header.end(), {4, 3, 0, 0, 0}); // 4-bit indexed, no interlace
+    putChunk(png, "IHDR", header);
+
+    std::vector<uint8_t> palette(&PALETTE[0][0], &PALETTE[0][0] + sizeof(PALETTE));
+    putChunk(png, "PLTE", palette);
+
+    // Each row is filter type 0 followed by the panel bytes unchanged
+    size_t rowBytes = width / 2;
+    std::vector<uint8_t> raw;
+    raw.reserve((rowBytes + 1) * height);
+    for (uint16_t y = 0; y < height; y++) {
+        raw.push_back(0);
+        raw.insert(raw.end(), frame + y * rowBytes, frame + (y + 1) * rowBytes);
+    }
+    std::vector<uint8_t> zlib = {0x78, 0x01};
+    deflateRuns(raw, zlib);
+    putBE32(zlib, adler32(raw));
+    putChunk(png, "IDAT", zlib);
+    putChunk(png, "IEND", {});
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(png.data(), 1, png.size(), f) == png.size();
+    return fclose(f) == 0 && ok;
+}
+
+// Undo the PNG row filters in place, one byte per pixel group
+static bool unfilter(std::vector<uint8_t>& raw, size_t rowBytes, uint16_t height) {
+    std::vector<uint8_t> previous(rowBytes, 0);
+    for (uint16_t y = 0; y < height; y++) {
+        uint8_t* row = raw.data() + y * (rowBytes + 1);
+        uint8_t filter = row[0];
+        uint8_t* px = row + 1;
+        for (size_t x = 0; x < rowBytes; x++) {
+            int a = x ? px[x - 1] : 0, b = previous[x], c = x ? previous[x - 1] : 0;
+            switch (filter) {
+                case 0: break;
+                case 1: px[x] += a; break;
+                case 2: px[x] += b; break;
+                case 3: px[x] += (a + b) / 2; break;
+                case 4: {
+                    int p = a + b - c, pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+                    px[x] += pa <= pb && pa <= pc ? a : pb <= pc ? b : c;
+                    break;
+                }
+                default: return false;
+            }
+        }
+        memcpy(previous.data(), px, rowBytes);
+    }
+    return true;
+}
+
+bool readPanelPng(const char* path, std::vector<uint8_t>& frame, uint16_t& width, uint16_t& height) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    std::vector<uint8_t> png;
+    uint8_t buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) png.insert(png.end(), buffer, buffer + n);
+    fclose(f);
+    if (png.size() < sizeof(SIGNATURE) || memcmp(png.data(), SIGNATURE, sizeof(SIGNATURE)) != 0) return false;
+
+    std::vector<uint8_t> zlib;
+    bool header = false;
+    size_t pos = sizeof(SIGNATURE);
+    while (pos + 12 <= png.size()) {
+        uint32_t length = getBE32(&png[pos]);
+        if (pos + 12 + length > png.size()) return false;
+        const uint8_t* type = &png[pos + 4];
+        const uint8_t* data = &png[pos + 8];
+        if (memcmp(type, "IHDR", 4) == 0) {
+            // Only what writePanelPng() writes: 4-bit indexed, not interlaced
+            if (length != 13 || data[8] != 4 || data[9] != 3 || data[12] != 0) return false;
+            width = getBE32(data);
+            height = getBE32(data + 4);
+            header = true;
+        } else if (memcmp(type, "IDAT", 4) == 0) {
+            zlib.insert(zlib.end(), data, data + length);
+        } else if (memcmp(type, "IEND", 4) == 0) {
+            break;
+        }
+        pos += 12 + length;
+    }
+    if (!header || width % 2) return false;
+
+    size_t rowBytes = width / 2;
+    std::vector<uint8_t> raw;
+    if (!inflateZlib(zlib, raw) || raw.size() != (rowBytes + 1) * height) return false;
+    if (!unfilter(raw, rowBytes, height)) return false;
+    frame.resize(rowBytes * height);
+    for (uint16_t y = 0; y < height; y++) {
+        memcpy(&frame[y * rowBytes], &raw[y * (rowBytes + 1) + 1], rowBytes);
+    }
+    return true;
+}
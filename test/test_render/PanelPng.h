@@ -0,0 +1,18 @@
+#ifndef PANEL_PNG_H
+#define PANEL_PNG_H
+
+#include <stdint.h>
+#include <vector>
+
+// Panel frames (two pixels a byte, high nibble first, colours numbered as in
+// GxEPD2_7C::color7) as 4-bit indexed PNGs. The palette is frame_dump.py's,
+// so the images open anywhere and compare against that script's output.
+//
+// readPanelPng() only inflates stored and fixed-Huffman blocks, which is all
+// writePanelPng() produces; re-save a golden image with this code, not an
+// image editor.
+
+bool writePanelPng(const char* path, const uint8_t* frame, uint16_t width, uint16_t height);
+bool readPanelPng(const char* path, std::vector<uint8_t>& frame, uint16_t& width, uint16_t& height);
+
+#endif
@@ -0,0 +1,169 @@
+// Renders a fixed scene through Display on the host, writes the frame the
+// panel received to .pio/render/render.png and compares it with the
+// committed golden.png. With UPDATE_GOLDEN=1 in the environment the render is
+// recorded as .pio/render/golden.png instead, to be reviewed and copied over
+// golden.png by hand; the source tree is never written.
+#include <unity.h>
+#include <filesystem>
+#include <string>
+#include "Display.h"
+#include "PanelPng.h"
+
+// 2026-01-01 15:00 UTC, early on the 2nd in Melbourne
+static const time_t FIXTURE_TIME = 1767225600 + 15 * 3600;
+
+static Display display;
+static WeatherData current;
+static DailyForecast daily[5];
+static HourlyData hourly[24];
+
+static const std::filesystem::path testDir = std::filesystem::path(__FILE__).parent_path();
+static const std::filesystem::path goldenPath = testDir / "golden.png";
+static const std::filesystem::path outputDir = testDir / ".." / ".." / ".pio" / "render";
+
+static void fillScene() {
+    clearWeatherData(current);
+    strlcpy(current.conditionText, "Partly cloudy with a chance of showers", sizeof(current.conditionText));
+    current.iconId = ICON_PARTLY_CLOUDY;
+    current.temp = 21.4;
+    current.feelsLike = 20.1;
+    current.windSpeed = 14.5;
+    current.windGust = 30;
+    current.windDirection = 225;
+    current.humidity = 56;
+    current.precipitationProbability = 20;
+    current.uvIndex = 5;
+    current.pressure = 1013;
+    current.valid = true;
+    current.indoorTemp = 22.5;
+    current.indoorHumidity = 45;
+
+    const uint8_t weekdays[] = {5, 6, 0, 1, 2};
+    const char* icons[] = {"rain", "thunderstorm", "fog", "windy", "snow_showers"};
+    for (int i = 0; i < 5; i++) {
+        daily[i] = DailyForecast(weekdays[i], weatherIconId(icons[i]), "Cloudy", 25 + i, 12 - i, 6 * 60 + 5, 20 * 60 + 41);
+    }
+
+    for (int i = 0; i < 24; i++) {
+        clearHourlyData(hourly[i], i);
+        hourly[i].temp = 15 + 6 * sin((i - 6) * PI / 12);
+        hourly[i].rainProb = (i * 37) % 90;
+        hourly[i].pressure = 1010 + i * 0.4;
+        if (i < 15) {
+            hourly[i].actualTemp = 14.5 + 6 * sin((i - 5) * PI / 12);
+            hourly[i].actualRain = (i % 4) * 1.5;
+            hourly[i].actualPressure = 1011 + i * 0.3;
+        }
+        if (i % 3 == 0) hourly[i].indoorTemp = 21 + i * 0.1;
+    }
+}
+
+static std::vector<uint8_t> panelFrame() {
+    return std::vector<uint8_t>(HostPanel::frame, HostPanel::frame + sizeof(HostPanel::frame));
+}
+
+void setUp() {
+    setHostTime(FIXTURE_TIME);
+    fillScene();
+}
+
+void tearDown() {}
+
+void test_render_matches_golden() {
+    int refreshes = HostPanel::refreshes;
+    display.drawWeather(current, daily, hourly);
+    TEST_ASSERT_EQUAL(refreshes + 1, HostPanel::refreshes);
+
+    std::filesystem::create_directories(outputDir);
+    std::string output = (outputDir / "render.png").string();
+    TEST_ASSERT_TRUE_MESSAGE(writePanelPng(output.c_str(), HostPanel::frame, HostPanel::WIDTH, HostPanel::HEIGHT),
+                             "could not write .pio/render/render.png");
+
+    const char* update = getenv("UPDATE_GOLDEN");
+    if (update && strcmp(update, "1") == 0) {
+        std::filesystem::copy_file(output, outputDir / "golden.png", std::filesystem::copy_options::overwrite_existing);
+        TEST_IGNORE_MESSAGE("Recorded .pio/render/golden.png; review it and copy it to test/test_render/golden.png");
+    }
+    TEST_ASSERT_TRUE_MESSAGE(std::filesystem::exists(goldenPath),
+                             "test/test_render/golden.png is missing; record one with UPDATE_GOLDEN=1");
+
+    std::vector<uint8_t> golden;
+    uint16_t width, height;
+    TEST_ASSERT_TRUE_MESSAGE(readPanelPng(goldenPath.string().c_str(), golden, width, height),
+                             "could not read golden.png");
+    TEST_ASSERT_EQUAL(HostPanel::WIDTH, width);
+    TEST_ASSERT_EQUAL(HostPanel::HEIGHT, height);
+
+    // Count differing pixels and where they are, for the failure message
+    uint32_t differing = 0;
+    int minX = width, minY = height, maxX = -1, maxY = -1;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            size_t i = (size_t)y * (width / 2) + x / 2;
+            int shift = x & 1 ? 0 : 4;
+            if ((HostPanel::frame[i] >> shift & 0x0F) == (golden[i] >> shift & 0x0F)) continue;
+            differing++;
+            minX = min(minX, x);
+            minY = min(minY, y);
+            maxX = max(maxX, x);
+            maxY = max(maxY, y);
+        }
+    }
+    if (differing) {
+        char message[160];
+        snprintf(message, sizeof(message), "%u pixels differ from golden.png within (%d,%d)-(%d,%d); see .pio/render/render.png",
+                 (unsigned)differing, minX, minY, maxX, maxY);
+        TEST_FAIL_MESSAGE(message);
+    }
+}
+
+void test_png_round_trip() {
+    std::vector<uint8_t> frame = panelFrame();
+    std::string path = (outputDir / "round_trip.png").string();
+    TEST_ASSERT_TRUE(writePanelPng(path.c_str(), frame.data(), HostPanel::WIDTH, HostPanel::HEIGHT));
+    std::vector<uint8_t> read;
+    uint16_t width, height;
+    TEST_ASSERT_TRUE(readPanelPng(path.c_str(), read, width, height));
+    TEST_ASSERT_EQUAL(HostPanel::WIDTH, width);
+    TEST_ASSERT_EQUAL(HostPanel::HEIGHT, height);
+    TEST_ASSERT_TRUE(read == frame);
+}
+
+void test_clock_change_skips_refresh() {
+    // Same scene a minute later: only the header clock differs
+    setHostTime(FIXTURE_TIME + 60);
+    int refreshes = HostPanel::refreshes;
+    display.drawWeather(current, daily, hourly);
+    TEST_ASSERT_EQUAL(refreshes, HostPanel::refreshes);
+
+    current.temp = 22.4;
+    display.drawWeather(current, daily, hourly);
+    TEST_ASSERT_EQUAL(refreshes + 1, HostPanel::refreshes);
+}
+
+void test_render_paths_agree() {
+    // Draw the fixture through the band pipeline, then through the full
+    // frame (after another scene, so the digest does not skip it)
+    display.drawWeather(current, daily, hourly);
+    std::vector<uint8_t> banded = panelFrame();
+
+    current.temp = 23.4;
+    display.drawWeather(current, daily, hourly);
+    fillScene();
+    display.setFullFrame(true);
+    display.drawWeather(current, daily, hourly);
+    display.setFullFrame(false);
+    TEST_ASSERT_TRUE(panelFrame() == banded);
+}
+
+int main() {
+    setenv("TZ", "AEST-10AEDT,M10.1.0,M4.1.0/3", 1);
+    tzset();
+    display.init();
+    UNITY_BEGIN();
+    RUN_TEST(test_render_matches_golden);
+    RUN_TEST(test_png_round_trip);
+    RUN_TEST(test_clock_change_skips_refresh);
+    RUN_TEST(test_render_paths_agree);
+    return UNITY_END();
+}
@@ -0,0 +1,257 @@
+// TimeUtil on the host: civil date arithmetic against timegm, the ISO-8601
+// parser's accepted and rejected forms, and LocalTimeTable across both of
+// Melbourne's DST changes against localtime_r
+#include <unity.h>
+#include "TimeUtil.h"
+
+static const char* MELBOURNE = "AEST-10AEDT,M10.1.0,M4.1.0/3";
+
+static void setTimeZone(const char* tz) {
+    setenv("TZ", tz, 1);
+    tzset();
+}
+
+static time_t utc(int year, int month, int day, int hour, int minute = 0, int second = 0) {
+    return (time_t)daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+}
+
+// Field by field, so a failure names the field
+static void assertSameTm(const struct tm& expected, const struct tm& actual) {
+    TEST_ASSERT_EQUAL_INT(expected.tm_year, actual.tm_year);
+    TEST_ASSERT_EQUAL_INT(expected.tm_mon, actual.tm_mon);
+    TEST_ASSERT_EQUAL_INT(expected.tm_mday, actual.tm_mday);
+    TEST_ASSERT_EQUAL_INT(expected.tm_hour, actual.tm_hour);
+    TEST_ASSERT_EQUAL_INT(expected.tm_min, actual.tm_min);
+    TEST_ASSERT_EQUAL_INT(expected.tm_sec, actual.tm_sec);
+    TEST_ASSERT_EQUAL_INT(expected.tm_wday, actual.tm_wday);
+    TEST_ASSERT_EQUAL_INT(expected.tm_yday, actual.tm_yday);
+    TEST_ASSERT_EQUAL_INT(expected.tm_isdst > 0, actual.tm_isdst > 0);
+}
+
+static void assertMatchesLocaltime(const LocalTimeTable& table, time_t from, time_t to, time_t step) {
+    for (time_t t = from; t <= to; t += step) {
+        struct tm expected, actual;
+        localtime_r(&t, &expected);
+        table.toLocal(t, actual);
+        assertSameTm(expected, actual);
+    }
+}
+
+void setUp() {
+    setTimeZone(MELBOURNE);
+}
+
+void tearDown() {}
+
+void test_days_from_civil_known_dates() {
+    TEST_ASSERT_EQUAL_INT32(0, daysFromCivil(1970, 1, 1));
+    TEST_ASSERT_EQUAL_INT32(-1, daysFromCivil(1969, 12, 31));
+    TEST_ASSERT_EQUAL_INT32(11017, daysFromCivil(2000, 3, 1));
+    TEST_ASSERT_EQUAL_INT32(20454, daysFromCivil(2026, 1, 1));
+    // 2000 was a leap year, 1900 and 2100 were not
+    TEST_ASSERT_EQUAL_INT32(2, daysFromCivil(2000, 3, 1) - daysFromCivil(2000, 2, 28));
+    TEST_ASSERT_EQUAL_INT32(1, daysFromCivil(1900, 3, 1) - daysFromCivil(1900, 2, 28));
+    TEST_ASSERT_EQUAL_INT32(1, daysFromCivil(2100, 3, 1) - daysFromCivil(2100, 2, 28));
+}
+
+void test_days_from_civil_matches_timegm() {
+    // Every day from 1900 to 2200
+    for (int32_t days = daysFromCivil(1900, 1, 1); days <= daysFromCivil(2200, 12, 31); days++) {
+        time_t t = (time_t)days * 86400;
+        struct tm date;
+        gmtime_r(&t, &date);
+        TEST_ASSERT_EQUAL_INT32(days, daysFromCivil(date.tm_year + 1900, date.tm_mon + 1, date.tm_mday));
+    }
+}
+
+void test_civil_from_days_round_trip() {
+    // Some 2700 years either side of the epoch, negative years included
+    for (int32_t days = -1000000; days <= 1000000; days++) {
+        int32_t y;
+        uint8_t m, d;
+        civilFromDays(days, y, m, d);
+        TEST_ASSERT_TRUE(m >= 1 && m <= 12);
+        TEST_ASSERT_TRUE(d >= 1 && d <= 31);
+        TEST_ASSERT_EQUAL_INT32(days, daysFromCivil(y, m, d));
+    }
+    int32_t y;
+    uint8_t m, d;
+    civilFromDays(daysFromCivil(2024, 2, 29), y, m, d);
+    TEST_ASSERT_EQUAL_INT32(2024, y);
+    TEST_ASSERT_EQUAL_UINT8(2, m);
+    TEST_ASSERT_EQUAL_UINT8(29, d);
+}
+
+void test_parse_iso8601_forms() {
+    IsoTime t;
+    TEST_ASSERT_TRUE(parseIso8601("2026-01-03T17:05:09Z", t));
+    TEST_ASSERT_EQUAL_INT16(2026, t.year);
+    TEST_ASSERT_EQUAL_UINT8(1, t.month);
+    TEST_ASSERT_EQUAL_UINT8(3, t.day);
+    TEST_ASSERT_EQUAL_UINT8(17, t.hour);
+    TEST_ASSERT_EQUAL_UINT8(5, t.minute);
+    TEST_ASSERT_EQUAL_UINT8(9, t.second);
+    TEST_ASSERT_TRUE(t.utc);
+
+    // The API's nanosecond fractions are dropped
+    TEST_ASSERT_TRUE(parseIso8601("2026-01-03T17:05:09.123456789Z", t));
+    TEST_ASSERT_EQUAL_UINT8(9, t.second);
+    TEST_ASSERT_TRUE(t.utc);
+
+    // Seconds are optional, and so is the Z
+    TEST_ASSERT_TRUE(parseIso8601("2026-01-03T17:05", t));
+    TEST_ASSERT_EQUAL_UINT8(0, t.second);
+    TEST_ASSERT_FALSE(t.utc);
+    TEST_ASSERT_TRUE(parseIso8601("2026-01-03 17:05:09", t));
+    TEST_ASSERT_FALSE(t.utc);
+
+    // A leap second is let through
+    TEST_ASSERT_TRUE(parseIso8601("2016-12-31T23:59:60Z", t));
+}
+
+void test_parse_iso8601_rejects_malformed() {
+    const char* malformed[] = {
+        "",
+        "2026",
+        "2026-01-03",
+        "2026-01-03T",
+        "2026-01-03T17",
+        "2026-01-03T17:0",
+        "2026-01-03T17:05:9",
+        "2026-1-03T17:05:09Z",
+        "2026-01-3T17:05:09Z",
+        "26-01-03T17:05:09Z",
+        "2026/01/03T17:05:09Z",
+        "2026-01-03X17:05:09Z",
+        "2026-01-03T17-05-09Z",
+        "2026-01-03T17:05:x9Z",
+        "abcd-01-03T17:05:09Z",
+        "2026-00-03T17:05:09Z",
+        "2026-13-03T17:05:09Z",
+        "2026-01-00T17:05:09Z",
+        "2026-01-32T17:05:09Z",
+        "2026-01-03T24:00:00Z",
+        "2026-01-03T17:60:00Z",
+        "2026-01-03T17:05:61Z",
+        " 2026-01-03T17:05:09Z",
+    };
+    for (const char* s : malformed) {
+        IsoTime t = {1999, 9, 9, 9, 9, 9, false};
+        TEST_ASSERT_FALSE_MESSAGE(parseIso8601(s, t), s);
+        // A failed parse leaves the output alone
+        TEST_ASSERT_EQUAL_INT16_MESSAGE(1999, t.year, s);
+        TEST_ASSERT_EQUAL_UINT8_MESSAGE(9, t.second, s);
+    }
+    IsoTime t;
+    TEST_ASSERT_FALSE(parseIso8601(nullptr, t));
+}
+
+void test_iso_to_epoch_matches_timegm() {
+    const char* stamps[] = {"1970-01-01T00:00:00Z", "2000-02-29T12:34:56Z", "2026-01-03T17:00:00Z",
+                            "2038-01-19T03:14:08Z", "2099-12-31T23:59:59Z"};
+    for (const char* s : stamps) {
+        IsoTime t;
+        TEST_ASSERT_TRUE(parseIso8601(s, t));
+        struct tm fields = {};
+        fields.tm_year = t.year - 1900;
+        fields.tm_mon = t.month - 1;
+        fields.tm_mday = t.day;
+        fields.tm_hour = t.hour;
+        fields.tm_min = t.minute;
+        fields.tm_sec = t.second;
+        TEST_ASSERT_EQUAL_INT64_MESSAGE((int64_t)timegm(&fields), (int64_t)isoToEpoch(t), s);
+    }
+}
+
+void test_spring_forward() {
+    // Clocks went from 02:00 AEST to 03:00 AEDT on 2025-10-05 (16:00 UTC the day before)
+    const time_t change = utc(2025, 10, 4, 16);
+    LocalTimeTable table;
+    table.build(change - 86400);
+    TEST_ASSERT_EQUAL_UINT8(2, table.spanCount());
+    TEST_ASSERT_EQUAL_INT32(10 * 3600, table.offsetAt(change - 1));
+    TEST_ASSERT_EQUAL_INT32(11 * 3600, table.offsetAt(change));
+
+    struct tm local;
+    table.toLocal(change - 1, local);
+    TEST_ASSERT_EQUAL_INT(5, local.tm_mday);
+    TEST_ASSERT_EQUAL_INT(1, local.tm_hour);
+    TEST_ASSERT_EQUAL_INT(59, local.tm_min);
+    TEST_ASSERT_EQUAL_INT(59, local.tm_sec);
+    TEST_ASSERT_FALSE(local.tm_isdst);
+    table.toLocal(change, local);
+    TEST_ASSERT_EQUAL_INT(3, local.tm_hour);
+    TEST_ASSERT_EQUAL_INT(0, local.tm_min);
+    TEST_ASSERT_TRUE(local.tm_isdst);
+
+    assertMatchesLocaltime(table, change - 2 * 86400, change + 6 * 86400, 15 * 60);
+}
+
+void test_fall_back() {
+    // Clocks went from 03:00 AEDT back to 02:00 AEST on 2026-04-05 (16:00 UTC the day before)
+    const time_t change = utc(2026, 4, 4, 16);
+    LocalTimeTable table;
+    table.build(change + 3600, 2, 2);
+    TEST_ASSERT_EQUAL_UINT8(2, table.spanCount());
+    TEST_ASSERT_EQUAL_INT32(11 * 3600, table.offsetAt(change - 1));
+    TEST_ASSERT_EQUAL_INT32(10 * 3600, table.offsetAt(change));
+
+    // The hour from 02:00 to 03:00 local happens twice
+    struct tm local;
+    table.toLocal(change - 1, local);
+    TEST_ASSERT_EQUAL_INT(2, local.tm_hour);
+    TEST_ASSERT_EQUAL_INT(59, local.tm_min);
+    TEST_ASSERT_TRUE(local.tm_isdst);
+    table.toLocal(change, local);
+    TEST_ASSERT_EQUAL_INT(2, local.tm_hour);
+    TEST_ASSERT_EQUAL_INT(0, local.tm_min);
+    TEST_ASSERT_FALSE(local.tm_isdst);
+
+    assertMatchesLocaltime(table, change - 86400, change + 86400, 7 * 60);
+}
+
+void test_northern_time_zone() {
+    // Central Europe, changing at 01:00 UTC on the last Sundays of March and October
+    setTimeZone("CET-1CEST,M3.5.0,M10.5.0/3");
+    LocalTimeTable table;
+    table.build(utc(2026, 3, 28, 12), 2, 2);
+    TEST_ASSERT_EQUAL_UINT8(2, table.spanCount());
+    TEST_ASSERT_EQUAL_INT32(3600, table.offsetAt(utc(2026, 3, 29, 0, 59, 59)));
+    TEST_ASSERT_EQUAL_INT32(7200, table.offsetAt(utc(2026, 3, 29, 1)));
+    assertMatchesLocaltime(table, utc(2026, 3, 27, 0), utc(2026, 3, 30, 0), 11 * 60);
+}
+
+void test_outside_window_and_unbuilt() {
+    LocalTimeTable table;
+    TEST_ASSERT_FALSE(table.built());
+    TEST_ASSERT_EQUAL_INT32(0, table.offsetAt(utc(2026, 1, 1, 0)));
+
+    // Before build() it is localtime_r itself
+    time_t t = utc(2026, 1, 1, 0);
+    struct tm expected, actual;
+    localtime_r(&t, &expected);
+    table.toLocal(t, actual);
+    assertSameTm(expected, actual);
+
+    // Outside the window the nearest span's offset is used
+    table.build(utc(2026, 1, 10, 0));
+    TEST_ASSERT_TRUE(table.built());
+    TEST_ASSERT_EQUAL_UINT8(1, table.spanCount());
+    TEST_ASSERT_EQUAL_INT32(11 * 3600, table.offsetAt(utc(2025, 1, 1, 0)));
+    TEST_ASSERT_EQUAL_INT32(11 * 3600, table.offsetAt(utc(2026, 6, 1, 0)));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_days_from_civil_known_dates);
+    RUN_TEST(test_days_from_civil_matches_timegm);
+    RUN_TEST(test_civil_from_days_round_trip);
+    RUN_TEST(test_parse_iso8601_forms);
+    RUN_TEST(test_parse_iso8601_rejects_malformed);
+    RUN_TEST(test_iso_to_epoch_matches_timegm);
+    RUN_TEST(test_spring_forward);
+    RUN_TEST(test_fall_back);
+    RUN_TEST(test_northern_time_zone);
+    RUN_TEST(test_outside_window_and_unbuilt);
+    return UNITY_END();
+}
@@ -0,0 +1,227 @@
+// The four API requests end to end on the host: WeatherClient fetches the
+// fixtures in test/fixtures from HostHttp and WeatherAPI fills the fetch
+// buffers. The same expectations run in the native env (schema-driven
+// streaming parser) and in native_json_dom (filtered ArduinoJson documents),
+// so both paths must fill the same fields with the same values.
+#include <unity.h>
+#include <HostFixtures.h>
+#include "WeatherAPI.h"
+#include "WeatherClient.h"
+
+// 2026-01-02 16:00 in Melbourne: the forecast covers 16:00 to 23:00 today,
+// the history midnight to 15:00
+static const time_t FIXTURE_TIME = 1767330000;
+
+static const char* DAILY_PATH = "/v1/forecast/days:lookup";
+static const char* HOURLY_PATH = "/v1/forecast/hours:lookup";
+static const char* HISTORY_PATH = "/v1/history/hours:lookup";
+static const char* CURRENT_PATH = "/v1/currentConditions:lookup";
+
+static WeatherData current;
+static DailyForecast daily[5];
+static HourlyData forecast[24];
+static HourlyData history[24];
+
+void setUp() {
+    HostHttp::reset();
+    HostHttp::serve(DAILY_PATH, readFixture("weather_daily.json"));
+    HostHttp::serve(HOURLY_PATH, readFixture("weather_hourly.json"));
+    HostHttp::serve(HISTORY_PATH, readFixture("weather_history.json"));
+    HostHttp::serve(CURRENT_PATH, readFixture("weather_current.json"));
+    setHostTime(FIXTURE_TIME);
+    localTimes.build(FIXTURE_TIME);
+    clearFetchBuffers(current, daily, forecast, history);
+}
+
+void tearDown() {}
+
+static void assertForecastHours() {
+    for (int hour = 0; hour < 24; hour++) {
+        char message[16];
+        snprintf(message, sizeof(message), "hour %d", hour);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(hour, forecast[hour].hour, message);
+        if (hour < 16) {
+            // Before now, and tomorrow's hours in the response, are left alone
+            TEST_ASSERT_EQUAL_FLOAT_MESSAGE(-100, forecast[hour].temp, message);
+            TEST_ASSERT_EQUAL_INT_MESSAGE(-1, forecast[hour].rainProb, message);
+            TEST_ASSERT_EQUAL_FLOAT_MESSAGE(-1, forecast[hour].pressure, message);
+            continue;
+        }
+        int i = hour - 16; // Index in forecastHours
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(0.001, 20.0 + 0.3 * i, forecast[hour].temp, message);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(i * 7, forecast[hour].rainProb, message);
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(0.001, 1012.3 + 0.1 * i, forecast[hour].pressure, message);
+        TEST_ASSERT_EQUAL_FLOAT_MESSAGE(-100, forecast[hour].actualTemp, message);
+    }
+}
+
+void test_daily_fields() {
+    WeatherClient client;
+    TEST_ASSERT_TRUE(getDailyForecastData(client, daily));
+
+    const uint8_t weekdays[] = {5, 6, 0, 1, 2}; // From Friday the 2nd
+    const char* icons[] = {"partly_cloudy", "showers", "thunderstorm", "mostly_clear", "windy"};
+    const char* texts[] = {"Partly cloudy", "Showers", "Thunderstorms", "Mostly sunny", "Windy"};
+    for (int d = 0; d < 5; d++) {
+        TEST_ASSERT_EQUAL_UINT8(weekdays[d], daily[d].weekday);
+        TEST_ASSERT_EQUAL(weatherIconId(icons[d]), daily[d].iconId);
+        TEST_ASSERT_EQUAL_STRING(icons[d], weatherIconName(daily[d].iconId));
+        TEST_ASSERT_EQUAL_STRING(texts[d], daily[d].conditionText);
+        TEST_ASSERT_FLOAT_WITHIN(0.001, 26.4 + 1.1 * d, daily[d].tempHigh);
+        TEST_ASSERT_FLOAT_WITHIN(0.001, 14.2 - 0.7 * d, daily[d].tempLow);
+        // UTC sun times, with fractions, in local minutes
+        TEST_ASSERT_EQUAL_UINT16(6 * 60 + 5 + d, daily[d].sunrise);
+        TEST_ASSERT_EQUAL_UINT16(20 * 60 + 43 - d, daily[d].sunset);
+    }
+}
+
+void test_icon_name_out_of_range() {
+    TEST_ASSERT_EQUAL_STRING("unknown", weatherIconName(ICON_COUNT));
+    TEST_ASSERT_EQUAL_STRING("unknown", weatherIconName((WeatherIconId)0xFF));
+}
+
+void test_hourly_fields() {
+    WeatherClient client;
+    TEST_ASSERT_TRUE(getHourlyForecastData(client, 24, forecast));
+    assertForecastHours();
+}
+
+void test_history_fields() {
+    WeatherClient client;
+    TEST_ASSERT_TRUE(getHistoryData(client, 24, history));
+    for (int hour = 0; hour < 24; hour++) {
+        char message[16];
+        snprintf(message, sizeof(message), "hour %d", hour);
+        if (hour > 15) {
+            TEST_ASSERT_EQUAL_FLOAT_MESSAGE(-100, history[hour].actualTemp, message);
+            TEST_ASSERT_EQUAL_FLOAT_MESSAGE(-1, history[hour].actualRain, message);
+            TEST_ASSERT_EQUAL_FLOAT_MESSAGE(-1, history[hour].actualPressure, message);
+            continue;
+        }
+        int i = hour + 8; // Index in historyHours, which starts at 16:00 yesterday
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(0.001, 15.0 + 0.4 * i, history[hour].actualTemp, message);
+        // Every fourth hour has no rainfallMM, which reads as none
+        float rain = i % 4 == 3 ? 0 : 0.2 * (i % 5);
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(0.001, rain, history[hour].actualRain, message);
+        // Hour 12 has no pressure at all and keeps "no data"
+        float pressure = i == 20 ? -1 : 1008.0 + 0.2 * i;
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(0.001, pressure, history[hour].actualPressure, message);
+        TEST_ASSERT_EQUAL_FLOAT_MESSAGE(-100, history[hour].temp, message);
+    }
+}
+
+void test_current_fields() {
+    WeatherClient client;
+    TEST_ASSERT_TRUE(getWeatherCurrentData(client, current));
+    TEST_ASSERT_TRUE(current.valid);
+    TEST_ASSERT_EQUAL_STRING("Partly cloudy", current.conditionText);
+    TEST_ASSERT_EQUAL(ICON_PARTLY_CLOUDY, current.iconId);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 24.6, current.temp);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 25.1, current.feelsLike);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 13, current.windSpeed);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 27, current.windGust);
+    TEST_ASSERT_EQUAL_INT(135, current.windDirection);
+    TEST_ASSERT_EQUAL_INT(48, current.humidity);
+    TEST_ASSERT_EQUAL_INT(10, current.precipitationProbability);
+    TEST_ASSERT_EQUAL_INT(7, current.uvIndex);
+    TEST_ASSERT_EQUAL_INT(1011, current.pressure); // 1011.6 truncated
+    // Indoor readings are not the API's
+    TEST_ASSERT_EQUAL_FLOAT(-100, current.indoorTemp);
+    TEST_ASSERT_EQUAL_FLOAT(-1, current.indoorHumidity);
+}
+
+void test_chunked_response() {
+    HostHttpResponse response;
+    response.body = readFixture("weather_hourly.json");
+    response.chunked = true;
+    response.chunkBytes = 100;
+    HostHttp::serve(HOURLY_PATH, response);
+    WeatherClient client;
+    TEST_ASSERT_TRUE(getHourlyForecastData(client, 24, forecast));
+    assertForecastHours();
+}
+
+void test_requests_share_one_connection() {
+    WeatherClient client;
+    TEST_ASSERT_TRUE(getDailyForecastData(client, daily));
+    TEST_ASSERT_TRUE(getHourlyForecastData(client, 24, forecast));
+    TEST_ASSERT_TRUE(getHistoryData(client, 24, history));
+    TEST_ASSERT_TRUE(getWeatherCurrentData(client, current));
+    client.stop();
+    TEST_ASSERT_EQUAL_INT(4, HostHttp::requests);
+    TEST_ASSERT_EQUAL_INT(1, HostHttp::connects);
+    TEST_ASSERT_EQUAL_INT(1, client.handshakes());
+}
+
+void test_bad_response_leaves_buffer() {
+    HourlyData before[24];
+    memcpy(before, forecast, sizeof(before));
+
+    std::string body = readFixture("weather_hourly.json");
+    HostHttp::serve(HOURLY_PATH, body.substr(0, body.size() / 2));
+    WeatherClient truncated;
+    TEST_ASSERT_FALSE(getHourlyForecastData(truncated, 24, forecast));
+    TEST_ASSERT_EQUAL_MEMORY(before, forecast, sizeof(before));
+
+    // No route: a 404 with an empty body
+    WeatherData currentBefore;
+    memcpy(&currentBefore, &current, sizeof(current));
+    HostHttp::reset();
+    WeatherClient missing;
+    TEST_ASSERT_FALSE(getWeatherCurrentData(missing, current));
+    TEST_ASSERT_EQUAL_MEMORY(&currentBefore, &current, sizeof(current));
+}
+
+void test_error_status_fails() {
+    // The API's error object parses cleanly but holds no weather
+    HostHttpResponse error;
+    error.status = 403;
+    error.body = "{\"error\": {\"code\": 403, \"status\": \"PERMISSION_DENIED\"}}";
+    HostHttp::serve(CURRENT_PATH, error);
+    WeatherClient client;
+    TEST_ASSERT_FALSE(getWeatherCurrentData(client, current));
+    TEST_ASSERT_FALSE(current.valid);
+    // The connection is dropped with the unread body and the next request
+    // makes a new one
+    TEST_ASSERT_TRUE(getDailyForecastData(client, daily));
+    TEST_ASSERT_EQUAL_INT(2, HostHttp::connects);
+}
+
+void test_unreachable_server() {
+    HostHttp::reachable = false;
+    WeatherClient client;
+    TEST_ASSERT_FALSE(getWeatherCurrentData(client, current));
+    TEST_ASSERT_FALSE(current.valid);
+    TEST_ASSERT_EQUAL_INT(0, HostHttp::requests);
+}
+
+void test_unset_clock_skips_hours() {
+    // Before NTP the clock reads 1970, so "today" is unknown
+    setHostTime(3600);
+    WeatherClient client;
+    TEST_ASSERT_FALSE(getHourlyForecastData(client, 24, forecast));
+    TEST_ASSERT_FALSE(getHistoryData(client, 24, history));
+    TEST_ASSERT_EQUAL_INT(0, HostHttp::requests);
+    for (int hour = 0; hour < 24; hour++) {
+        TEST_ASSERT_EQUAL_FLOAT(-100, forecast[hour].temp);
+        TEST_ASSERT_EQUAL_FLOAT(-100, history[hour].actualTemp);
+    }
+}
+
+int main() {
+    setenv("TZ", "AEST-10AEDT,M10.1.0,M4.1.0/3", 1);
+    tzset();
+    UNITY_BEGIN();
+    RUN_TEST(test_daily_fields);
+    RUN_TEST(test_icon_name_out_of_range);
+    RUN_TEST(test_hourly_fields);
+    RUN_TEST(test_history_fields);
+    RUN_TEST(test_current_fields);
+    RUN_TEST(test_chunked_response);
+    RUN_TEST(test_requests_share_one_connection);
+    RUN_TEST(test_bad_response_leaves_buffer);
+    RUN_TEST(test_error_status_fails);
+    RUN_TEST(test_unreachable_server);
+    RUN_TEST(test_unset_clock_skips_hours);
+    return UNITY_END();
+}